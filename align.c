@@ -0,0 +1,176 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - rigid superposition
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (placement of partial realizations, see hier.c)
+************************************************************************************************************/
+
+#include "bp.h"
+
+// the rotation superposing a set of points on another one, with the smallest sum of squared deviations, is
+// computed with the quaternion method of Horn: the optimal unit quaternion is the eigenvector of a symmetric 4x4
+// matrix built from the correlation matrix of the two centered sets of points (largest eigenvalue); when the
+// reflections are allowed, the same is done for the mirror image of the first set, and the best one is kept
+
+// this function computes the eigenvalues and the eigenvectors of the symmetric 4x4 matrix A (Jacobi method)
+// -> A is destroyed, its diagonal contains the eigenvalues at the end
+// -> the eigenvectors are the columns of V
+void jacobi4(double A[4][4],double V[4][4])
+{
+   int i,j,k,sweep;
+   double off,theta,t,c,s,tau,h,g;
+
+   for (i = 0; i < 4; i++)  for (j = 0; j < 4; j++)  V[i][j] = (i == j) ? 1.0 : 0.0;
+   for (sweep = 0; sweep < 50; sweep++)
+   {
+      off = 0.0;
+      for (i = 0; i < 3; i++)  for (j = i + 1; j < 4; j++)  off = off + fabs(A[i][j]);
+      if (off < 1.e-30)  break;
+      for (i = 0; i < 3; i++)
+      {
+         for (j = i + 1; j < 4; j++)
+         {
+            if (fabs(A[i][j]) < 1.e-300)  continue;
+            theta = 0.5*(A[j][j] - A[i][i])/A[i][j];
+            t = 1.0/(fabs(theta) + sqrt(1.0 + theta*theta));
+            if (theta < 0.0)  t = -t;
+            c = 1.0/sqrt(1.0 + t*t);  s = t*c;
+            tau = s/(1.0 + c);
+            h = t*A[i][j];
+            A[i][i] = A[i][i] - h;  A[j][j] = A[j][j] + h;
+            A[i][j] = 0.0;  A[j][i] = 0.0;
+            for (k = 0; k < 4; k++)
+            {
+               if (k == i || k == j)  continue;
+               g = A[k][i];  h = A[k][j];
+               A[k][i] = g - s*(h + g*tau);  A[i][k] = A[k][i];
+               A[k][j] = h + s*(g - h*tau);  A[j][k] = A[k][j];
+            };
+            for (k = 0; k < 4; k++)
+            {
+               g = V[k][i];  h = V[k][j];
+               V[k][i] = g - s*(h + g*tau);
+               V[k][j] = h + s*(g - h*tau);
+            };
+         };
+      };
+   };
+};
+
+// this function computes the rotation R (3x3, by rows) maximizing the correlation with the matrix H
+// (H[3*a+b] is the sum of the products between the coordinate a of the first set and the coordinate b
+// of the second one, for centered sets of points)
+void hornRotation(double *H,double *R)
+{
+   int i,best;
+   double N[4][4],V[4][4];
+   double q0,q1,q2,q3;
+
+   N[0][0] = H[0] + H[4] + H[8];
+   N[0][1] = H[5] - H[7];  N[0][2] = H[6] - H[2];  N[0][3] = H[1] - H[3];
+   N[1][1] = H[0] - H[4] - H[8];
+   N[1][2] = H[1] + H[3];  N[1][3] = H[6] + H[2];
+   N[2][2] = -H[0] + H[4] - H[8];
+   N[2][3] = H[5] + H[7];
+   N[3][3] = -H[0] - H[4] + H[8];
+   N[1][0] = N[0][1];  N[2][0] = N[0][2];  N[3][0] = N[0][3];
+   N[2][1] = N[1][2];  N[3][1] = N[1][3];  N[3][2] = N[2][3];
+   jacobi4(N,V);
+
+   // unit quaternion associated to the largest eigenvalue
+   best = 0;
+   for (i = 1; i < 4; i++)  if (N[i][i] > N[best][best])  best = i;
+   q0 = V[0][best];  q1 = V[1][best];  q2 = V[2][best];  q3 = V[3][best];
+
+   R[0] = q0*q0 + q1*q1 - q2*q2 - q3*q3;  R[1] = 2.0*(q1*q2 - q0*q3);  R[2] = 2.0*(q1*q3 + q0*q2);
+   R[3] = 2.0*(q1*q2 + q0*q3);  R[4] = q0*q0 - q1*q1 + q2*q2 - q3*q3;  R[5] = 2.0*(q2*q3 - q0*q1);
+   R[6] = 2.0*(q1*q3 - q0*q2);  R[7] = 2.0*(q2*q3 + q0*q1);  R[8] = q0*q0 - q1*q1 - q2*q2 + q3*q3;
+};
+
+// this function computes the rigid transformation x -> R x + t superposing the k points of A with indices ia
+// on the points of B with indices ib (ia or ib can be NULL for the indices 0, 1, ..., k-1)
+// -> R is the 3x3 orthogonal matrix (by rows), t the translation; R is a rotation, unless the reflections are
+//    allowed and the mirror image of the points of A is closer to the points of B
+// -> the returning value is the RMSD after the superposition
+double superpose(int k,double **A,int *ia,double **B,int *ib,bool reflection,double *R,double *t)
+{
+   int i,a,b,c,p,q,f,nf;
+   double ca[3],cb[3],x[3],y[3];
+   double H[9],Rf[9];
+   double rmsd,best,d;
+
+   // centroids
+   for (c = 0; c < 3; c++)
+   {
+      ca[c] = 0.0;  cb[c] = 0.0;
+      for (i = 0; i < k; i++)
+      {
+         p = (ia == NULL) ? i : ia[i];
+         q = (ib == NULL) ? i : ib[i];
+         ca[c] = ca[c] + A[c][p];  cb[c] = cb[c] + B[c][q];
+      };
+      ca[c] = ca[c]/k;  cb[c] = cb[c]/k;
+   };
+
+   // correlation matrix
+   for (c = 0; c < 9; c++)  H[c] = 0.0;
+   for (i = 0; i < k; i++)
+   {
+      p = (ia == NULL) ? i : ia[i];
+      q = (ib == NULL) ? i : ib[i];
+      for (a = 0; a < 3; a++)  for (b = 0; b < 3; b++)  H[3*a+b] = H[3*a+b] + (A[a][p] - ca[a])*(B[b][q] - cb[b]);
+   };
+
+   // rotation (f = 0), and rotation of the mirror image (f = 1, the z coordinates of A change sign)
+   best = -1.0;
+   nf = reflection ? 2 : 1;
+   for (f = 0; f < nf; f++)
+   {
+      if (f == 1)  for (b = 0; b < 3; b++)  H[6+b] = -H[6+b];
+      hornRotation(H,Rf);
+      if (f == 1)  for (a = 0; a < 3; a++)  Rf[3*a+2] = -Rf[3*a+2];
+
+      // deviation
+      rmsd = 0.0;
+      for (i = 0; i < k; i++)
+      {
+         p = (ia == NULL) ? i : ia[i];
+         q = (ib == NULL) ? i : ib[i];
+         for (c = 0; c < 3; c++)  x[c] = A[c][p] - ca[c];
+         for (a = 0; a < 3; a++)
+         {
+            y[a] = Rf[3*a]*x[0] + Rf[3*a+1]*x[1] + Rf[3*a+2]*x[2];
+            d = y[a] - (B[a][q] - cb[a]);
+            rmsd = rmsd + d*d;
+         };
+      };
+      rmsd = sqrt(rmsd/k);
+      if (best < 0.0 || rmsd < best)
+      {
+         best = rmsd;
+         for (c = 0; c < 9; c++)  R[c] = Rf[c];
+      };
+   };
+
+   // translation
+   for (a = 0; a < 3; a++)  t[a] = cb[a] - (R[3*a]*ca[0] + R[3*a+1]*ca[1] + R[3*a+2]*ca[2]);
+   return best;
+};
+
+// this function applies the rigid transformation x -> R x + t to the k points of A with indices ia,
+// and writes the result in the points of B with indices ib (ia or ib can be NULL, see superpose)
+void transformPoints(int k,double **A,int *ia,double *R,double *t,double **B,int *ib)
+{
+   int i,a,p,q;
+   double x[3];
+
+   for (i = 0; i < k; i++)
+   {
+      p = (ia == NULL) ? i : ia[i];
+      q = (ib == NULL) ? i : ib[i];
+      x[0] = A[0][p];  x[1] = A[1][p];  x[2] = A[2][p];
+      for (a = 0; a < 3; a++)  B[a][q] = R[3*a]*x[0] + R[3*a+1]*x[1] + R[3*a+2]*x[2] + t[a];
+   };
+};
@@ -0,0 +1,529 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - vertex blocks
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (option -blocks)
+************************************************************************************************************/
+
+#include "bp.h"
+#include <unistd.h>
+
+extern double INFTY;
+extern size_t instlen;
+extern volatile sig_atomic_t interrupted;
+
+// with option -blocks, the instance is divided into blocks of consecutive vertices (in the vertex order), and
+// every block is solved separately, with the selected method, as an instance containing only the distances
+// between its vertices; every block shares some vertices with the previous one (at least bminoverlap): the
+// realizations of the blocks are then stitched together, from the first to the last one, by superposing every
+// block on the shared vertices already placed (see superpose); finally, the assembled realization is refined by
+// spg over the entire instance
+// -> when the vertices have group ids, the blocks end at the end of a group (so that the groups are not split)
+// -> the blocks are solved by several threads; bp looks for at most bsols solutions of every block, and the one
+//    that best agrees with the vertices already placed (shared vertices and distances to the previous blocks) is
+//    selected; spg refines the starting point of the block
+// -> the distances between vertices in different blocks are only considered when selecting the solutions of the
+//    blocks and by the final refinement: when the assembled realization still violates them, larger blocks are
+//    tried, and the entire instance is solved as last resort (see solveBlocks)
+
+// number of threads solving the blocks (0 = one per available processor)
+int bthreads = 0;
+
+// smallest number of vertices shared by two consecutive blocks
+int bminoverlap = 4;
+
+// maximum number of solutions of every block found by bp
+int bsols = 16;
+
+// this function extends the end of a block to the end of the group of its last vertex
+// -> the groups are used only when the vertices have different group ids
+int blockEnd(int n,VERTEX *v,int end,bool grouped)
+{
+   if (end > n)  end = n;
+   if (grouped)  while (end < n && v[end].groupId == v[end-1].groupId)  end++;
+   return end;
+};
+
+// this function verifies whether the vertices start, ..., end-1 of an instance form a block that can be solved with
+// the selected method: the block instance is stored in b when this is the case
+bool tryBlock(INSTANCE *inst,int start,int end,int *vert,int *local,OPTION op,INFORMATION *info,INSTANCE *b)
+{
+   int i;
+   char *error;
+   INFORMATION infob;
+
+   for (i = start; i < end; i++)  vert[i-start] = i;
+   subInstance(inst,end-start,vert,0,local,NULL,b);
+   b->n0 = inst->n0 + start;
+   infob = *info;
+   error = checkInstance(b,&op,&infob);
+   if (error == NULL)  error = prepareInstance(b,op,&infob,false);
+   if (error != NULL)
+   {
+      free(error);
+      freeInstance(b);
+      return false;
+   };
+   return true;
+};
+
+// this function divides a verified instance (see checkInstance) into blocks of about size vertices, and it prepares
+// the instance of every block for the selected method (see above)
+// -> the shared vertices between two consecutive blocks are at least bminoverlap, and they are increased until the
+//    next block can be solved with the selected method
+// -> inst->blocks is set on success; the returning value is a NULL char on success, and a char pointer to the
+//    error description otherwise
+char* newBlocks(INSTANCE *inst,OPTION op,INFORMATION *info)
+{
+   int i,n,b,ov,start,end,size,capacity;
+   int *vert,*local;
+   bool grouped,ok;
+   char *error;
+   BLOCKS *bl;
+   VERTEX *v;
+
+   n = inst->n;  v = inst->v;
+   size = op.blocks;
+   if (size >= n)
+   {
+      error = (char*)calloc(instlen,sizeof(char));
+      sprintf(error,"mdjeep: error: the size of the blocks (%d) needs to be smaller than the number of vertices (%d)",size,n);
+      return error;
+   };
+
+   // options for the blocks
+   op.blocks = 0;  op.hier = 0;  op.repeat = 0;  op.smooth = 0;
+
+   // are the vertices grouped?
+   grouped = false;
+   for (i = 1; i < n; i++)  if (v[i].groupId != v[0].groupId)  grouped = true;
+
+   // the blocks
+   capacity = n/(size - bminoverlap) + 2;
+   bl = (BLOCKS*)calloc(1,sizeof(BLOCKS));
+   bl->start = (int*)calloc(capacity,sizeof(int));
+   bl->end = (int*)calloc(capacity,sizeof(int));
+   bl->binst = (INSTANCE*)calloc(capacity,sizeof(INSTANCE));
+   vert = (int*)calloc(n,sizeof(int));
+   local = (int*)calloc(n,sizeof(int));
+   for (i = 0; i < n; i++)  local[i] = -1;
+   bl->nb = 0;
+   error = NULL;
+   end = 0;
+   while (end < n && error == NULL)
+   {
+      // the first block starts at the first vertex, the other ones share ov vertices with the previous one
+      b = bl->nb;
+      ok = false;
+      for (ov = (b == 0) ? 0 : bminoverlap; !ok && ov <= end - (b == 0 ? 0 : bl->start[b-1] + 3); ov++)
+      {
+         start = end - ov;
+         i = blockEnd(n,v,start + size,grouped);
+         if (n - i < size/2)  i = n;
+         ok = tryBlock(inst,start,i,vert,local,op,info,&bl->binst[b]);
+         if (ok)
+         {
+            bl->start[b] = start;  bl->end[b] = i;
+         };
+      };
+      if (!ok)
+      {
+         error = (char*)calloc(instlen,sizeof(char));
+         sprintf(error,"mdjeep: error: no block starting before vertex %d can be solved with the selected method (option -blocks)",inst->n0+end);
+         break;
+      };
+      end = bl->end[b];
+      bl->nb++;
+      if (bl->nb == capacity)
+      {
+         capacity = 2*capacity;
+         bl->start = (int*)realloc(bl->start,capacity*sizeof(int));
+         bl->end = (int*)realloc(bl->end,capacity*sizeof(int));
+         bl->binst = (INSTANCE*)realloc(bl->binst,capacity*sizeof(INSTANCE));
+      };
+   };
+   free(vert);
+   free(local);
+
+   // ending
+   if (error != NULL)
+   {
+      freeBlocks(bl);
+      return error;
+   };
+   inst->blocks = bl;
+   return NULL;
+};
+
+// this function frees the BLOCKS structure
+BLOCKS* freeBlocks(BLOCKS *bl)
+{
+   int b;
+
+   if (bl == NULL)  return NULL;
+   for (b = 0; b < bl->nb; b++)  freeInstance(&bl->binst[b]);
+   free(bl->binst);
+   free(bl->start);  free(bl->end);
+   free(bl);
+   return NULL;
+};
+
+// this function stores the solutions of a block found by bp (it is the function invoked by bp on every solution,
+// see INFORMATION)
+void blockSolution(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info)
+{
+   int i,k;
+   BLOCKTHREAD *w = (BLOCKTHREAD*)info->data;
+
+   k = w->ny[w->current];
+   for (i = 0; i < n; i++)
+   {
+      w->Y[w->current][0][k*n+i] = X[0][i];
+      w->Y[w->current][1][k*n+i] = X[1][i];
+      w->Y[w->current][2][k*n+i] = X[2][i];
+   };
+   w->ny[w->current] = k + 1;
+};
+
+// this function solves the blocks assigned to one thread (the thread t takes the blocks t, t + nthreads, ...)
+void* blockThread(void *arg)
+{
+   int b,i,k,its;
+   double obj;
+   double **Z;
+   BLOCKTHREAD *w = (BLOCKTHREAD*)arg;
+   BLOCKS *bl = w->inst->blocks;
+   INSTANCE *binst;
+   OPTION op;
+   INFORMATION info;
+   SEARCH S;
+   struct timeval now;
+
+   for (b = w->id; b < bl->nb; b = b + w->nthreads)
+   {
+      binst = &bl->binst[b];
+      k = binst->n;
+      op = w->op;
+      info = w->info;
+      setupInstance(binst,&op,&info);
+      allocateSearch(&S,binst->nrep,binst->m);
+      Z = allocateMatrix(3,binst->nrep);
+      w->current = b;
+      if (info.method == 0)
+      {
+         // the blocks are solved within the time left to the run (no solutions after ^C or after the deadline)
+         gettimeofday(&now,0);
+         op.maxtime = (int)(w->deadline - now.tv_sec);
+         if (op.maxtime >= 0 && !interrupted)  solveInstance(binst,Z,S,op,&info,&its,&obj);
+      }
+      else
+      {
+         // the starting point of the block
+         for (i = 0; i < k; i++)
+         {
+            Z[0][i] = w->X[0][bl->start[b]+i];
+            Z[1][i] = w->X[1][bl->start[b]+i];
+            Z[2][i] = w->X[2][bl->start[b]+i];
+         };
+         solveInstance(binst,Z,S,op,&info,&its,&obj);
+         blockSolution(k,binst->v,Z,0.0,0.0,&info);
+      };
+      w->ncalls = w->ncalls + info.ncalls;
+      w->pruning = w->pruning + info.pruning;
+      w->nspg = w->nspg + info.nspg;
+      w->nspgok = w->nspgok + info.nspgok;
+      w->nstress = w->nstress + info.nstress;
+      freeMatrix(3,Z);
+      freeSearch(&S);
+   };
+   return NULL;
+};
+
+// this function computes the largest violation of the distances between the vertices start, ..., end-1 of the
+// realization X and the vertices before them
+double blockViolation(int start,int end,VERTEX *v,double **X)
+{
+   int i,j;
+   double d,err,max;
+   REFERENCE *ref;
+
+   max = 0.0;
+   for (i = start; i < end; i++)
+   {
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
+      {
+         j = otherVertexId(ref);
+         if (j >= start)  continue;
+         d = distance(i,j,X);
+         err = 0.0;
+         if (d < lowerBound(ref))  err = lowerBound(ref) - d;
+         if (d > upperBound(ref))  err = d - upperBound(ref);
+         if (err > max)  max = err;
+      };
+   };
+   return max;
+};
+
+// this function solves the blocks of a prepared instance, and it stitches their realizations together (see above)
+// -> X0 is the starting point (for spg), and the assembled realization, refined over the entire instance, is
+//    written in X; flag is the flag of the final refinement (see spg)
+// -> bp is not run on the blocks after the deadline (in seconds, as given by gettimeofday)
+// -> the returning value is false when some block has no solution (X is then not modified)
+bool assembleBlocks(INSTANCE *inst,double **X0,double **X,SEARCH S,OPTION op,INFORMATION *info,long deadline,int *its,double *obj,int *flag)
+{
+   int b,c,i,k,t,ov,best,nthreads;
+   int *ny;
+   double rmsd,score,bestscore;
+   double R[9],tr[3];
+   double *A[3],*B[3];
+   double **T;
+   double ***Y;
+   bool *started;
+   BLOCKS *bl = inst->blocks;
+   BLOCKTHREAD *w;
+   INFORMATION infor;
+   sigset_t all,previous;
+
+   // memory for the solutions of the blocks
+   Y = (double***)calloc(bl->nb,sizeof(double**));
+   ny = (int*)calloc(bl->nb,sizeof(int));
+   for (b = 0; b < bl->nb; b++)  Y[b] = allocateMatrix(3,(info->method == 0 ? bsols : 1)*bl->binst[b].n);
+
+   // number of threads
+   nthreads = bthreads;
+   if (nthreads <= 0)  nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+   if (nthreads > bl->nb)  nthreads = bl->nb;
+   if (nthreads < 1)  nthreads = 1;
+
+   // options and infos for the blocks (nothing is printed)
+   w = (BLOCKTHREAD*)calloc(nthreads,sizeof(BLOCKTHREAD));
+   started = (bool*)calloc(nthreads,sizeof(bool));
+   for (t = 0; t < nthreads; t++)
+   {
+      w[t].inst = inst;  w[t].X = X0;
+      w[t].op = op;
+      w[t].op.print = 0;  w[t].op.best = 0;  w[t].op.cluster = 0.0;  w[t].op.dedup = 0;
+      w[t].op.allone = 0;  w[t].op.monitor = false;
+      w[t].op.blocks = 0;  w[t].op.hier = 0;  w[t].op.repeat = 0;  w[t].op.smooth = 0;
+      w[t].info = *info;
+      w[t].info.output = NULL;  w[t].info.solution = blockSolution;  w[t].info.feasible = NULL;
+      w[t].info.data = &w[t];
+      w[t].info.writer = NULL;  w[t].info.pool = NULL;  w[t].info.dedup = NULL;
+      w[t].info.topk = NULL;  w[t].info.cluster = NULL;
+      w[t].info.ncalls = 0;  w[t].info.nspg = 0;  w[t].info.nspgok = 0;  w[t].info.nstress = 0;
+      w[t].info.nsols = 0;  w[t].info.maxsols = bsols;  w[t].info.pruning = 0;
+      w[t].info.best_sol = 0;  w[t].info.best_mde = INFTY;  w[t].info.best_lde = INFTY;
+      w[t].id = t;  w[t].nthreads = nthreads;  w[t].deadline = deadline;
+      w[t].ncalls = 0;  w[t].pruning = 0;  w[t].nspg = 0;  w[t].nspgok = 0;  w[t].nstress = 0;
+      w[t].Y = Y;  w[t].ny = ny;
+   };
+
+   // the signals (^C) are handled by the main thread only
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK,&all,&previous);
+   for (t = 1; t < nthreads; t++)  started[t] = (pthread_create(&w[t].thread,NULL,blockThread,&w[t]) == 0);
+   pthread_sigmask(SIG_SETMASK,&previous,NULL);
+
+   // the calling thread takes the first share, and the share of the threads that could not be created
+   blockThread(&w[0]);
+   for (t = 1; t < nthreads; t++)
+   {
+      if (started[t])
+         pthread_join(w[t].thread,NULL);
+      else
+         blockThread(&w[t]);
+   };
+   for (t = 0; t < nthreads; t++)
+   {
+      info->ncalls = info->ncalls + w[t].ncalls;
+      info->pruning = info->pruning + w[t].pruning;
+      info->nspg = info->nspg + w[t].nspg;
+      info->nspgok = info->nspgok + w[t].nspgok;
+      info->nstress = info->nstress + w[t].nstress;
+   };
+   free(started);
+   free(w);
+
+   // stitching the blocks (the first solution of the first block gives the reference frame)
+   *flag = 0;
+   info->stitch = 0.0;
+   for (b = 0; b < bl->nb; b++)  if (ny[b] == 0)  break;
+   if (b == bl->nb)
+   {
+      k = bl->binst[0].n;
+      for (i = 0; i < k; i++)
+      {
+         X[0][i] = Y[0][0][i];  X[1][i] = Y[0][1][i];  X[2][i] = Y[0][2][i];
+      };
+      T = allocateMatrix(3,inst->n);
+      for (b = 1; b < bl->nb; b++)
+      {
+         k = bl->binst[b].n;
+         ov = bl->end[b-1] - bl->start[b];
+         best = 0;  bestscore = INFTY;
+         for (c = 0; c < ny[b]; c++)
+         {
+            // superposing the solution c of the block on the shared vertices, and verifying the distances to the
+            // vertices already placed (the transformed solution is written in T, with instance indices)
+            A[0] = Y[b][0] + c*k;  A[1] = Y[b][1] + c*k;  A[2] = Y[b][2] + c*k;
+            B[0] = X[0] + bl->start[b];  B[1] = X[1] + bl->start[b];  B[2] = X[2] + bl->start[b];
+            rmsd = superpose(ov,A,NULL,B,NULL,true,R,tr);
+            for (i = 0; i < bl->start[b]; i++)
+            {
+               T[0][i] = X[0][i];  T[1][i] = X[1][i];  T[2][i] = X[2][i];
+            };
+            B[0] = T[0] + bl->start[b];  B[1] = T[1] + bl->start[b];  B[2] = T[2] + bl->start[b];
+            transformPoints(k,A,NULL,R,tr,B,NULL);
+            score = blockViolation(bl->end[b-1],bl->end[b],inst->v,T);
+            if (rmsd > score)  score = rmsd;
+            if (score < bestscore)
+            {
+               best = c;  bestscore = score;
+            };
+         };
+
+         // placing the vertices of the block that were not placed yet
+         A[0] = Y[b][0] + best*k;  A[1] = Y[b][1] + best*k;  A[2] = Y[b][2] + best*k;
+         B[0] = X[0] + bl->start[b];  B[1] = X[1] + bl->start[b];  B[2] = X[2] + bl->start[b];
+         rmsd = superpose(ov,A,NULL,B,NULL,true,R,tr);
+         if (rmsd > info->stitch)  info->stitch = rmsd;
+         A[0] = A[0] + ov;  A[1] = A[1] + ov;  A[2] = A[2] + ov;
+         B[0] = X[0] + bl->end[b-1];  B[1] = X[1] + bl->end[b-1];  B[2] = X[2] + bl->end[b-1];
+         transformPoints(k-ov,A,NULL,R,tr,B,NULL);
+      };
+      freeMatrix(3,T);
+
+      // refinement over the entire instance
+      for (i = 0; i < inst->n; i++)
+      {
+         createBox(i,X,op.be,S.lX,S.uX);
+         expandBounds(i,inst->v,S.lX,S.uX,op.be,op.eps);
+      };
+      if (info->method == 0)
+      {
+         infor = *info;
+         infor.refinement = (info->refinement == 2) ? 2 : 1;
+         localOptimization(inst->n,inst->v,X,S,op,&infor,its,obj);
+         info->nstress = infor.nstress;
+         info->nspg++;
+      }
+      else
+      {
+         *flag = localOptimization(inst->n,inst->v,X,S,op,info,its,obj);
+      };
+   };
+
+   // ending
+   for (b = 0; b < bl->nb; b++)  freeMatrix(3,Y[b]);
+   free(Y);
+   free(ny);
+   return b == bl->nb;
+};
+
+// this function solves a prepared instance by blocks (see above)
+// -> X, S, op and info are the ones given to solveInstance: with bp, the assembled realization is treated as a
+//    solution found by bp (it is not stored in the pool of solutions); with spg, X contains the starting point
+// -> the assembled realization is accepted only when its vertices satisfy the distances as the ones of the
+//    solutions found by bp (see SolutionDDF): otherwise, the size of the blocks is doubled, and the blocks are
+//    solved again; when the blocks cannot be enlarged any further, the selected method is run on the entire
+//    instance (with bp, until the first solution); info->bsize is the size of the blocks that were accepted
+//    (0 for the entire instance, -1 when bp was stopped before)
+// -> all attempts of bp share the maxtime of the run, and they stop after ^C (see intHandler)
+// -> the returning value is the flag of the final refinement (see spg)
+int solveBlocks(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj)
+{
+   int i,size,flag,ncalls;
+   long deadline;
+   double lde,mde;
+   double **X0;
+   bool ok,stopped;
+   char *error;
+   BLOCKS *bl;
+   OPTION opb;
+   struct timeval now;
+
+   // the starting point
+   X0 = allocateMatrix(3,inst->n);
+   copyMatrix(3,inst->n,X,X0);
+
+   // the end of the run (for bp)
+   gettimeofday(&now,0);
+   deadline = now.tv_sec + op.maxtime;
+
+   // solving the instance by blocks, and enlarging the blocks until their realizations can be stitched together
+   // (the blocks prepared with the instance are restored at the end, as the instance may be solved again)
+   bl = inst->blocks;
+   flag = 0;
+   ok = false;
+   stopped = false;
+   for (size = op.blocks; !ok && !stopped && size < inst->n; size = 2*size)
+   {
+      if (size > op.blocks)
+      {
+         inst->blocks = NULL;
+         opb = op;  opb.blocks = size;
+         error = newBlocks(inst,opb,info);
+         if (error != NULL)  free(error);
+      };
+      if (inst->blocks != NULL)
+      {
+         ok = assembleBlocks(inst,X0,X,S,op,info,deadline,its,obj,&flag);
+         if (ok)  ok = SolutionDDF(inst->n,inst->v,X) < op.eps;
+         if (ok)  info->bsize = size;
+      };
+      if (inst->blocks != bl)  freeBlocks(inst->blocks);
+      gettimeofday(&now,0);
+      if (info->method == 0)  stopped = interrupted || now.tv_sec > deadline;
+   };
+   inst->blocks = bl;
+
+   // the assembled realization
+   if (ok && info->method == 0)
+   {
+      if (reportSolution(inst,X,S,op,info,&lde,&mde))
+      {
+         if (lde < op.eps)  info->nspgok++;
+      };
+   };
+
+   // the entire instance (bp is not started after ^C, and it runs for the time left)
+   if (!ok && stopped)
+   {
+      info->bsize = -1;
+      info->stitch = 0.0;
+   }
+   else if (!ok)
+   {
+      info->bsize = 0;
+      info->stitch = 0.0;
+      copyMatrix(3,inst->n,X0,X);
+      if (info->method == 0)
+      {
+         opb = op;  opb.allone = 1;  opb.maxtime = (int)(deadline - now.tv_sec);
+         ncalls = info->ncalls;
+         if (info->exact)
+            bp_exact(0,inst->n,inst->v,X,S,opb,info);
+         else
+            bp(0,inst->n,inst->v,X,S,opb,info);
+         info->ncalls = info->ncalls + ncalls;
+      }
+      else
+      {
+         if (info->method != 3)
+         {
+            for (i = 0; i < inst->n; i++)
+            {
+               createBox(i,X,op.be,S.lX,S.uX);
+               expandBounds(i,inst->v,S.lX,S.uX,op.be,op.eps);
+            };
+         };
+         flag = localOptimization(inst->n,inst->v,X,S,op,info,its,obj);
+      };
+   };
+
+   // ending
+   freeMatrix(3,X0);
+   return flag;
+};
@@ -14,25 +14,88 @@
                                     bp_exact may choose the "best" triplet of discretization vertices
                                     a time limit for both bp implementations can now be set up
               Nov  7 2023  v.0.3.2  patch 2
+              Oct 18 2026  v.0.3.3  the search status is reset at every new run (bp can be invoked several times)
+                                    every new solution can be passed to the function given in INFORMATION
+                                    solutions printed through the asynchronous writer (see writer.c)
+                                    branch taken at every layer recorded for the pool of solutions (see pool.c)
+                                    optional comparison of every new solution with all previous ones (see dedup.c)
+                                    the k best solutions can be kept in memory (see topk.c)
+                                    the solutions can be kept in memory for clustering them (see cluster.c)
+                                    MDE and LDE evaluated again only after the last layer shared with the previous solution
+                                    optional look-ahead pruning device in bp_exact (see lookahead.c)
+                                    bp_exact does not branch at the layers of the repeated vertices (see repeat.c)
+                                    the flat consecutive triplets of the repetition orders are replaced (see repeat.c)
+                                    bp_exact keeps the triplet selected at every layer, its error bounds the errors
+                                    computed for the other triplets (same selection as the full scan)
+                                    the search status is kept per thread (bp can run in several threads, see hier.c)
+                                    optional pruning of the partial solutions by the function given in INFORMATION
+                                    the search status is initialized by startSearch (the search can start from any layer)
+                                    the refinement method is either spg or lbfgsb (see localOptimization)
+                                    SIGTERM is caught as ^C (the run ends normally, and the queued solutions are written)
+                                    ^C is recorded in a process-wide flag, checked by the searches of all threads
+                                    the triplet search stops at the first triplet with null error
+                                    optional look-ahead pruning device in bp, verified on the boxes of the vertices
 *********************************************************************************************************/
 
 #include "bp.h"
 
 extern double INFTY;
-bool keep_going = true;
-bool newsol = false;
-bool backtracking = false;
-bool check = false;
-bool PRINTED = false;
-struct timeval startime;
+__thread bool keep_going = true;
+volatile sig_atomic_t interrupted = 0;
+__thread bool newsol = false;
+__thread bool backtracking = false;
+__thread bool check = false;
+__thread bool PRINTED = false;
+__thread struct timeval startime;
 
 // signal catcher
+// -> the signal is received by one thread only (the other threads mask it): the searches running in the other
+//    threads stop when they find the flag interrupted set (it is not reset by startSearch, see clearInterrupt)
 void intHandler(int a)
 {
    fprintf(stderr," signal caught: stopping (partial solution printed if -P or -p options used)");
+   interrupted = 1;
    keep_going = false;
 };
 
+// this function clears the interruption flag before a new run (it is invoked by the top-level callers of
+// solveInstance only, so that the searches started after ^C by the same run stop immediately)
+void clearInterrupt(void)
+{
+   interrupted = 0;
+};
+
+// this function computes LDE and MDE of a new found solution X (see update_errors)
+// -> the vertices placed before the first layer where the path differs from the one of the previous
+//    evaluated solution have the same coordinates: the partial values of the previous evaluation are reused
+//    (S.epath[0] is set to -1 when the coordinates of the previous vertices are modified, e.g. by spg)
+void evaluateSolution(int n,double **X,SEARCH S,double *lde,double *mde)
+{
+   int k;
+
+   k = 0;
+   if (S.epath[0] == 0)  while (k < n && S.epath[k] == S.path[k])  k++;
+   if (k == n)  k = n - 1;
+   update_errors(S.edges,k,X,S.esum,S.emax,lde,mde);
+   memcpy(S.epath,S.path,n*sizeof(int));
+};
+
+// this function initializes the BP call counter and the search status of the current thread before a new search
+// (the time for BP is counted from this point)
+// -> bp and bp_exact invoke it when they start from the first layer, it is otherwise invoked before starting
+//    the search from another layer (see incremental.c)
+void startSearch(int n,SEARCH S,INFORMATION *info)
+{
+   int k;
+
+   info->ncalls = 0;
+   keep_going = !interrupted;  PRINTED = false;
+   check = false;  newsol = false;  backtracking = false;
+   S.epath[0] = -1;
+   for (k = 0; k < n; k++)  S.tcache[k] = nullTriplet();
+   gettimeofday(&startime,0);
+};
+
 // branch-and-prune (general version)
 // -> i, current vertex of be realized
 // -> n, total number of vertices forming the instance
@@ -45,6 +108,7 @@ void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
 {
    int j,k;
    int it,nb;
+   int branch;
    int ldigits;
    double A,B,U[9];
    double cdist;
@@ -62,14 +126,15 @@ void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
    REFERENCE *r1,*r2,*r3;
    struct timeval currentime;
 
-   // signal handler
+   // signal handler (^C, and termination requests as the ones sent by timeout)
    signal(SIGINT,intHandler);
+   signal(SIGTERM,intHandler);
 
    // first call to BP?
    if (i == 0)
    {
-      // initializing the BP call counter
-      info->ncalls = 0;
+      // initializing the BP call counter and the search status
+      startSearch(n,S,info);
 
       // vertex 0
       X[0][0] =  0.0;  X[1][0] = 0.0;  X[2][0] = 0.0;
@@ -86,9 +151,6 @@ void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
       X[0][2] = -lowerBound(r1) + lowerBound(r2)*cTheta;  X[1][2] = lowerBound(r2)*sTheta;  X[2][2] = 0.0; 
       createBox(2,X,op.eps,S.lX,S.uX);
 
-      // we start to count the time for BP from this point
-      gettimeofday(&startime,0);
-
       // branching starts at vertex i+3
       i = i + 3;
    };
@@ -162,7 +224,8 @@ void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
       current = lastOmegaInterval(omegaL);
 
    // branching over the obtained omega sub-intervals (using omegaList iterators)
-   while (current != NULL && keep_going)
+   branch = 0;
+   while (current != NULL && keep_going && !interrupted)
    {
       // monitor
       if (op.monitor)  
@@ -178,6 +241,11 @@ void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
       // from the left to the right side of the tree
       if (op.symmetry == 0)  if (i == 3)  if (check)  if (it == nb/2 + 1)  check = false;
 
+      // index of the current sub-interval (only the stored one is explored when a path is replayed)
+      S.path[i] = branch;
+      branch++;
+      if (S.replay != NULL)  if (S.path[i] != S.replay[i])  goto NEXT;
+
       // the vertex position is initially placed at the center of the arc
       lomega0 = omegaIntervalLowerBound(current);
       uomega0 = omegaIntervalUpperBound(current);
@@ -278,7 +346,8 @@ void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
             do // if the distance between the boxes is feasible, 
             {     // then we can try to improve the current solution by local optimization
                pperr = perr;
-               spg(i+1,v,X,S,op,info,&it,&obj);
+               localOptimization(i+1,v,X,S,op,info,&it,&obj);
+               S.epath[0] = -1;  // the coordinates of the previous vertices may have changed
                info->nspg++;
                perr = DDF(i,v,X);
                reCenterBounds(i+1,v,X,S.lX,S.uX,op.be,op.eps);
@@ -288,10 +357,18 @@ void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
             while (perr > op.eps && pperr - perr > op.eps && k < 20 && keep_going);
          };
       };
+
+      // performing the look-ahead pruning device (optional): the coordinates of the previous vertices may still be
+      // modified by the refinement method, and the implied bounds are verified on the distances between the boxes
+      if (perr < op.eps && S.ahead != NULL)  perr = BoxLookAheadDDF(i,S.ahead,S.lX,S.uX);
+
+      // performing the user pruning function (optional)
+      if (perr < op.eps && info->feasible != NULL)  if (!info->feasible(i,X,info))  perr = INFTY;
       if (perr > op.eps)  info->pruning++;
 
       // if the current partial solution is OK (either since the beginning, or after local optimization)
-      if (perr < op.eps)
+      // (a replayed path is known to lead to a solution: it is not pruned)
+      if (perr < op.eps || S.replay != NULL)
       {
          if (i < n - 1)  
          {
@@ -300,8 +377,17 @@ void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
          }
          else
          {
+            // verifying whether the new found solution is too close to one of the previous ones (optional)
+            if (info->dedup != NULL)
+            {
+               if (isDuplicate(info->dedup,X))
+               {
+                  info->duplicates++;
+                  goto NEXT;  // skip this branch
+               };
+            }
             // verifying whether the new found solution is too close to the previous one
-            if (check)
+            else if (check)
             {
                dist = 0.0;
                for (j = 0; j < n; j++)
@@ -324,15 +410,11 @@ void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
             // printing the solution (if requested)
             if (op.print > 1)
             {
-               if (op.format == 0)
-                  printfile(n,v,X,info->output,info->nsols);
-               else
-                  printpdb(n,v,X,info->output,info->nsols);
+               printSolution(n,v,X,op,info,info->nsols);
             };
 
             // evaluating the quality of the solution
-            lde = compute_lde(n,v,X,op.eps);
-            mde = compute_mde(n,v,X,op.eps);
+            evaluateSolution(n,X,S,&lde,&mde);
 
             // best solution found so far
             if (mde < info->best_mde)
@@ -342,19 +424,24 @@ void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
                info->best_mde = mde;
                if (op.print == 1)
                {
-                  if (op.format == 0)
-                     printfile(n,v,X,info->output,0);
-                  else
-                     printpdb(n,v,X,info->output,0);
+                  printSolution(n,v,X,op,info,0);
                };
             };
+
+            // storing the path of the solution, keeping the solution for the k best ones and the clustering (optional)
+            if (info->pool != NULL)  addToPool(info->pool,S.path);
+            if (info->topk != NULL)  addToTopk(info->topk,X,info->nsols,lde,mde);
+            if (info->cluster != NULL)  addToCluster(info->cluster,X,info->nsols);
+
+            // passing the solution to the user function (optional)
+            if (info->solution != NULL)  info->solution(n,v,X,lde,mde,info);
             copyMatrix(3,n,X,S.pX);
          };
       };
 
-      // maxtime limit reached?
+      // maxtime limit reached, or ^C caught by another thread?
       gettimeofday(&currentime,0);
-      if (currentime.tv_sec - startime.tv_sec > op.maxtime)  keep_going = false;
+      if (currentime.tv_sec - startime.tv_sec > op.maxtime || interrupted)  keep_going = false;
 
       // skipping one half of the tree (optional)
       if (i == 3)  if (op.symmetry > 0)
@@ -383,10 +470,7 @@ NEXT: if (omegaIntervalHasNextAlongDirection(current,op.symmetry<2))
       {
          if(op.print > 0 && info->nsols == 0)
          {
-            if (op.format == 0)
-               printfile(i,v,X,info->output,0);
-            else
-               printpdb(i,v,X,info->output,0);
+            printSolution(i,v,X,op,info,0);
             PRINTED = true;
          };
       };
@@ -398,6 +482,36 @@ NEXT: if (omegaIntervalHasNextAlongDirection(current,op.symmetry<2))
    return;
 };
 
+// this function computes the coordinates of vertex i with the triplet of reference vertices t (with positive
+// sine of the omega angle), and gives the error over the entire set of reference distances of i (see DDF)
+// -> the returning value is INFTY when the triplet is too flat, or when the torsion angle cannot be computed
+// -> the computation of the error stops as soon as it exceeds bound (see BoundedDDF)
+double tripletError(int i,VERTEX *v,double **X,triplet t,double eps,double bound)
+{
+   double U[9];
+   double cdist,cTheta,sTheta,cosOmega,sinOmega;
+
+   // theta angle ("bond" angles)
+   cTheta = costheta(otherVertexId(t.r2),otherVertexId(t.r1),i,v,X);
+   if (fabs(cTheta) < eps)  return INFTY;  // before invoking bp, it was verified
+   sTheta = sqrt(1.0 - cTheta*cTheta);     // that "flattest" triplet is not too flat!
+   if (sTheta < eps)  return INFTY;
+   cdist = lowerBound(t.r1);
+
+   // generating U matrix
+   UMatrix(otherVertexId(t.r3),otherVertexId(t.r2),otherVertexId(t.r1),i,X,U);
+
+   // omega angle (torsion angles)
+   cosOmega = cosomega(otherVertexId(t.r3),otherVertexId(t.r2),otherVertexId(t.r1),i,v,X,0.0,eps);
+   if (cosOmega == -2.0)  return INFTY;
+   sinOmega = sqrt(1.0 - cosOmega*cosOmega);
+
+   // generating the coordinates for the vertex by using the triplet t
+   genCoordinates(otherVertexId(t.r1),i,X,U,cdist,cTheta,sTheta,cosOmega,sinOmega);
+
+   return BoundedDDF(i,v,X,bound);
+};
+
 // branch-and-prune (specific version for instances consisting of exact, and precise, distances)
 // -> i, current vertex of be realized
 // -> n, total number of vertices forming the instance
@@ -409,24 +523,27 @@ NEXT: if (omegaIntervalHasNextAlongDirection(current,op.symmetry<2))
 void bp_exact(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info)
 {
    int h,k;
-   int ldigits;
+   int ldigits,nsol;
    double U[9];
    double tmp;
    double cdist,lde,mde;
    double cTheta,sTheta;
    double cosOmega,sinOmega[2];
    double perr,berr;
+   double **Y;
    triplet t,best;
+   VERTEX *vsol;
    struct timeval currentime;
 
-   // signal handler
+   // signal handler (^C, and termination requests as the ones sent by timeout)
    signal(SIGINT,intHandler);
+   signal(SIGTERM,intHandler);
 
    // first call to BP (exact) ?
    if (i == 0)
    {
-      // initializing the BP call counter
-      info->ncalls = 0;
+      // initializing the BP call counter and the search status
+      startSearch(n,S,info);
 
       // The first three vertices can be positioned by using the initial clique
 
@@ -442,9 +559,6 @@ void bp_exact(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *i
       cTheta = costheta(0,1,2,v,X);  sTheta = sqrt(1.0 - cTheta*cTheta);
       X[0][2] = -lowerBound(t.r1) + lowerBound(t.r2)*cTheta;  X[1][2] = lowerBound(t.r2)*sTheta;  X[2][2] = 0.0;
 
-      // we start to count the time for BP from this point
-      gettimeofday(&startime,0);
-
       // branching starts at vertex i+3
       i = i + 3;
    };
@@ -455,52 +569,73 @@ void bp_exact(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *i
    // if we're not backtracking, we are exploring the tree for a new solution
    if (!backtracking)  newsol = false;
 
+   // a repeated vertex takes the coordinates of its previous occurrence (no branching, see repeat.c)
+   if (S.rep != NULL)  if (S.rep[i] >= 0)
+   {
+      X[0][i] = X[0][S.rep[i]];  X[1][i] = X[1][S.rep[i]];  X[2][i] = X[2][S.rep[i]];
+      S.path[i] = 0;
+      if (i < n - 1)
+      {
+         backtracking = false;
+         bp_exact(i+1,n,v,X,S,op,info);
+         backtracking = true;
+      };
+      return;
+   };
+
    // selection of the discretization vertices
    cTheta = 0.0;
    if (info->consec)
    {
-      // the consecutivity assumption is satisfied
-      best.r1 = getReference(v,i,i-1);
-      best.r2 = getReference(v,i,i-2);
-      best.r3 = getReference(v,i,i-3);
+      // the consecutivity assumption is satisfied (in a repetition order, the references of a vertex refer to the
+      // first occurrences of the vertices at the 3 previous positions, see repeat.c)
+      if (S.rep != NULL)
+      {
+         best.r1 = getReference(v,firstOccurrence(S.rep,i-1),i);
+         best.r2 = getReference(v,firstOccurrence(S.rep,i-2),i);
+         best.r3 = getReference(v,firstOccurrence(S.rep,i-3),i);
+      }
+      else
+      {
+         best.r1 = getReference(v,i,i-1);
+         best.r2 = getReference(v,i,i-2);
+         best.r3 = getReference(v,i,i-3);
+      };
 
       // is this triplet too flat?
       cTheta = costheta(otherVertexId(best.r2),otherVertexId(best.r1),i,v,X);
+
+      // in a repetition order, the consecutive triplets on planar groups (the sine of the omega angle is close to
+      // zero) give inaccurate positions: the triplet of the layer is then selected as below
+      if (S.rep != NULL)
+      {
+         cosOmega = cosomega(otherVertexId(best.r3),otherVertexId(best.r2),otherVertexId(best.r1),i,v,X,0.0,op.eps);
+         if (cosOmega == -2.0 || 1.0 - cosOmega*cosOmega < 0.0025)  cTheta = 0.0;
+      };
    };
 
    // we select the discretization vertices leading to the smallest error
    // (if the one above cannot be defined or it is too flat)
    if (fabs(cTheta) < op.eps)
    {
+      // the error of the triplet selected at the previous visit of this layer bounds the errors of the other
+      // triplets: the computation of their errors stops as soon as the bound is exceeded (they cannot be selected)
+      // -> the triplets are tried out in the usual order, and the first one with the smallest error is selected
+      //    (until a triplet is found, the ones having the same error as the kept triplet are also accepted)
+      // -> the search stops at the first triplet with null error, which cannot be improved
+      //    (a triplet whose error is only small is not enough: the selected triplets, and the solutions, would change)
       berr = INFTY;
-      t = nullTriplet();  best = nullTriplet();
-
+      if (isValidTriplet(S.tcache[i],op.eps))  berr = tripletError(i,v,X,S.tcache[i],op.eps,INFTY);
+      best = nullTriplet();
+      t = nullTriplet();
       do // trying out all possible triplets
       {
          t = nextTripletRef(v[i].ref,t,op.eps);
          if (isValidTriplet(t,op.eps))
          {
-            // theta angle ("bond" angles)
-            cTheta = costheta(otherVertexId(t.r2),otherVertexId(t.r1),i,v,X);
-            if (fabs(cTheta) < op.eps)  continue;  // before invoking bp, it was verified
-            sTheta = sqrt(1.0 - cTheta*cTheta);    // that "flattest" triplet is not too flat!
-            if (sTheta < op.eps)  continue;
-            cdist = lowerBound(t.r1);
-
-            // generating U matrix
-            UMatrix(otherVertexId(t.r3),otherVertexId(t.r2),otherVertexId(t.r1),i,X,U);
-
-            // omega angle (torsion angles)
-            cosOmega = cosomega(otherVertexId(t.r3),otherVertexId(t.r2),otherVertexId(t.r1),i,v,X,0.0,op.eps);
-            if (cosOmega == -2.0)  continue;
-            sinOmega[0] = sqrt(1.0 - cosOmega*cosOmega);
-
-            // generating the coordinates for the vertex by using the current triplet t
-            genCoordinates(otherVertexId(t.r1),i,X,U,cdist,cTheta,sTheta,cosOmega,sinOmega[0]);
-
             // verifying the error over the entire set of reference distances
-            perr = DDF(i,v,X);
-            if (perr < berr)
+            perr = tripletError(i,v,X,t,op.eps,berr);
+            if (perr < berr || (perr == berr && perr < INFTY && isNullTriplet(best)))
             {
                best.r1 = t.r1;
                best.r2 = t.r2;
@@ -509,7 +644,8 @@ void bp_exact(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *i
             };
          };
       }
-      while (!isNullTriplet(t) && keep_going);
+      while (!isNullTriplet(t) && (berr > 0.0 || isNullTriplet(best)) && keep_going);
+      S.tcache[i] = best;
    };
 
    // using the best found triplet to compute the coordinates
@@ -536,8 +672,12 @@ void bp_exact(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *i
       };
 
       // branching
-      for (h = 0; h < 2 && keep_going; h++)
+      for (h = 0; h < 2 && keep_going && !interrupted; h++)
       {
+         // only the stored branch is explored when a path is replayed
+         S.path[i] = h;
+         if (S.replay != NULL)  if (h != S.replay[i])  continue;
+
          // monitor
          if (op.monitor && (i == 4 || i%10 == 0 || i == n - 1))
          {
@@ -550,8 +690,18 @@ void bp_exact(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *i
          // generating the coordinates for the vertex by using the best triplet
          genCoordinates(otherVertexId(best.r1),i,X,U,cdist,cTheta,sTheta,cosOmega,sinOmega[h]);
 
-         // performing the DDF pruning device
-         if (DDF(i,v,X) < op.eps)
+         // performing the DDF pruning device, the look-ahead pruning device, and the user pruning function
+         // (a replayed path is not pruned)
+         perr = DDF(i,v,X);
+         if (perr < op.eps && S.ahead != NULL)
+         {
+            // a branch cut by the look-ahead device contains no solutions: the search goes on as after having
+            // explored it (the symmetric half of the tree is not skipped because of a previous solution)
+            perr = LookAheadDDF(i,S.ahead,X);
+            if (perr >= op.eps)  newsol = false;
+         };
+         if (perr < op.eps && info->feasible != NULL)  if (!info->feasible(i,X,info))  perr = INFTY;
+         if (perr < op.eps || S.replay != NULL)
          {
             // all distances are satisfied at the current layer
             if (i < n - 1)
@@ -563,36 +713,55 @@ void bp_exact(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *i
             }
             else
             {
-               // solution found
-               newsol = true;
-               info->nsols = info->nsols + 1;
-
-               // printing the solution (if requested)
-               if (op.print > 1)
+               // the solution, without the copies of the repeated vertices (see repeat.c)
+               nsol = n;  vsol = v;  Y = X;
+               if (S.rep != NULL)
                {
-                  if (op.format == 0)
-                     printfile(n,v,X,info->output,info->nsols);
-                  else
-                     printpdb(n,v,X,info->output,info->nsols);
+                  nsol = contractSolution(n,S.rep,X,S.pX);
+                  vsol = S.vsol;  Y = S.pX;
                };
 
-               // evaluating the quality of the solution
-               lde = compute_lde(n,v,X,op.eps);
-               mde = compute_mde(n,v,X,op.eps);
-
-               // best solution found so far
-               if (mde < info->best_mde)
+               if (info->dedup != NULL && isDuplicate(info->dedup,Y))
                {
-                  info->best_sol = info->nsols;
-                  info->best_lde = lde;
-                  info->best_mde = mde;
-                  if (op.print == 1)
+                  // the solution is too close to one of the previous ones (the symmetric half of the tree can
+                  // be skipped as after a new solution)
+                  newsol = true;
+                  info->duplicates++;
+               }
+               else
+               {
+                  // solution found
+                  newsol = true;
+                  info->nsols = info->nsols + 1;
+
+                  // printing the solution (if requested)
+                  if (op.print > 1)
+                  {
+                     printSolution(nsol,vsol,Y,op,info,info->nsols);
+                  };
+
+                  // evaluating the quality of the solution
+                  evaluateSolution(n,X,S,&lde,&mde);
+
+                  // best solution found so far
+                  if (mde < info->best_mde)
                   {
-                     if (op.format == 0)
-                        printfile(n,v,X,info->output,0);
-                     else
-                        printpdb(n,v,X,info->output,0);
+                     info->best_sol = info->nsols;
+                     info->best_lde = lde;
+                     info->best_mde = mde;
+                     if (op.print == 1)
+                     {
+                        printSolution(nsol,vsol,Y,op,info,0);
+                     };
                   };
+
+                  // storing the path of the solution, keeping the solution for the k best ones and the clustering (optional)
+                  if (info->pool != NULL)  addToPool(info->pool,S.path);
+                  if (info->topk != NULL)  addToTopk(info->topk,Y,info->nsols,lde,mde);
+                  if (info->cluster != NULL)  addToCluster(info->cluster,Y,info->nsols);
+
+                  // passing the solution to the user function (optional)
+                  if (info->solution != NULL)  info->solution(nsol,vsol,Y,lde,mde,info);
                };
             };
          }
@@ -601,9 +770,9 @@ void bp_exact(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *i
             info->pruning++;
          };
 
-         // maxtime limit reached?
+         // maxtime limit reached, or ^C caught by another thread?
          gettimeofday(&currentime,0);
-         if (currentime.tv_sec - startime.tv_sec > op.maxtime)  keep_going = false;
+         if (currentime.tv_sec - startime.tv_sec > op.maxtime || interrupted)  keep_going = false;
 
          // skipping one half of the tree (optional)
          if (i == 3)  if (op.symmetry > 0)
@@ -636,10 +805,10 @@ void bp_exact(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *i
       {
          if(op.print > 0 && info->nsols == 0)
          {
-            if (op.format == 0)
-               printfile(i,v,X,info->output,0);
+            if (S.rep != NULL)
+               printSolution(contractSolution(i,S.rep,X,S.pX),S.vsol,S.pX,op,info,0);
             else
-               printpdb(i,v,X,info->output,0);
+               printSolution(i,v,X,op,info,0);
             PRINTED = true;
          };
       };
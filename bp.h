@@ -10,6 +10,32 @@
               Mar 21 2020  v.0.3.1  adding triplet structure and new function prototypes
               May 19 2020  v.0.3.2  reorganization of OPTION structure, new function prototypes
               Apr 13 2022  v.0.3.2  patch
+              Oct 18 2026  v.0.3.3  INSTANCE structure and solution function in INFORMATION, new prototypes
+                                   MDJEEP structure for the library interface (see mdjeep.h)
+                                   MDJEEP structure extended for the solution iterator
+                                   WRITER structure for the asynchronous solution writer
+                                   structures of the binary trajectory files
+                                   POOL structure for storing solutions as paths in the search tree
+                                   DEDUP structure for detecting duplicated solutions
+                                   TOPK structure for keeping the k best solutions in memory
+                                   CLUSTER structure for clustering the solutions
+                                   EDGES structure for the evaluation of MDE and LDE, partial sums in SEARCH
+                                   LOOKAHEAD structure for the look-ahead pruning device
+                                   SMOOTH structure for the bound smoothing
+                                   VORDER structure for searching for vertex orders
+                                   repetition orders in INSTANCE and SEARCH
+                                   triplet cache in SEARCH (bp_exact)
+                                   HIERARCHY structure for the hierarchical mode (backbone first)
+                                   pruning function in INFORMATION
+                                   BLOCKS structure for solving the instances by blocks of vertices
+                                   previous instance and solution in INFORMATION (incremental mode)
+                                   L-BFGS-B as main and refinement method, number of stress evaluations
+                                   SMACOFTHREAD structure for the Guttman transform (main method smacof)
+                                   SMACOFPOOL structure for the threads of smacof (created once per call)
+                                   built-in starting points, STARTTHREAD structure for runs from several starting points
+                                   SPGPOOL and SPGTHREAD structures for the threads of spg
+                                   WORKSPACE structure (memory of the local methods allocated when needed)
+                                   SPGFLOAT structure for the iterations of spg in single precision
 ********************************************************************************************************/
 
 #include <stdio.h>
@@ -17,9 +43,15 @@
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
 #include <ctype.h>
 #include <signal.h>
 #include <sys/time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <ucontext.h>
+#include <pthread.h>
+#include "mdjeep.h"
 
 // Data Structures
 // ---------------
@@ -73,6 +105,128 @@ struct Vertex
    REFERENCE *ref;  // pointer to the first reference distance
 };
 
+// distances stored in contiguous arrays, for the evaluation of MDE and LDE (see objfun.c)
+// (the distances of vertex i are the ones in its list of references, i.e. the ones from start[i] to start[i+1]-1)
+typedef struct edges EDGES;
+struct edges
+{
+   int n;             // number of vertices
+   int nv;            // number of distinct vertices, for the MDE (smaller than n when some vertices are repeated)
+   int m;             // number of distances
+   int *start;        // index of the first distance of every vertex (n+1 values)
+   int *other;        // the reference vertex of every distance
+   double *lb,*ub;    // distance bounds (lb = ub for exact distances)
+   double *norm;      // value dividing the error in MDE (lb for exact distances, the interval center otherwise)
+};
+
+// bounds on the distances between every vertex and the previous ones, implied by the distances to the vertices
+// placed later (see lookahead.c); the bounds of vertex i are the ones from start[i] to start[i+1]-1
+typedef struct lookahead LOOKAHEAD;
+struct lookahead
+{
+   int n;             // number of vertices
+   int m;             // number of implied bounds
+   int *start;        // index of the first implied bound of every vertex (n+1 values)
+   int *other;        // the previous vertex of every implied bound
+   double *lb,*ub;    // implied bounds
+};
+
+// distances organized for the bound smoothing (see smooth.c)
+typedef struct smooth SMOOTH;
+struct smooth
+{
+   int n;             // number of vertices
+   int m;             // number of distances
+   double eps;        // tolerance (distances [lb,ub] with ub - lb <= eps are exact, and not modified)
+   REFERENCE **ref;   // the distances, in the order of the lists of references
+   bool *exact;       // true for the exact distances
+   int *start;        // index of the first neighbor of every vertex (n+1 values)
+   int *adj;          // the neighbors of every vertex, sorted by vertex id
+   int *dist;         // the index of the distance between every vertex and its neighbors
+   int maxdeg;        // largest number of neighbors
+   double *lb,*ub;    // current bounds
+   double *nlb,*nub;  // bounds computed during a sweep
+};
+
+// thread of the bound smoothing (see smooth.c)
+typedef struct smooththread SMOOTHTHREAD;
+struct smooththread
+{
+   SMOOTH *s;                 // the distances
+   int id;                    // thread index
+   int nthreads;              // total number of threads
+   int phase;                 // 0 = tetrangle inequalities, 1 = sweep of triangle inequalities
+   double change;             // largest change in the bounds computed by the thread
+   int *cv,*ci,*cj;           // common neighbors (with the distances to the two vertices)
+   pthread_t thread;
+};
+
+// pool of threads computing the Guttman transform (see smacof.c)
+typedef struct smacofpool SMACOFPOOL;
+
+// data of one of the threads computing the Guttman transform (see smacof.c)
+typedef struct smacofthread SMACOFTHREAD;
+struct smacofthread
+{
+   SMACOFPOOL *pool;          // the pool of the thread
+   SMOOTH *s;                 // the graph of the distances, with their bounds
+   double **X;                // the current point
+   double **J;                // the transform of the current point (every thread writes its vertices)
+   int first,last;            // the vertices assigned to the thread are first, ..., last-1
+   double stress;             // part of the stress given by the distances of the assigned vertices
+   bool started;              // true if the thread is running (the first thread is the one calling smacof)
+   pthread_t thread;
+};
+
+struct smacofpool
+{
+   int nthreads;              // number of threads
+   SMACOFTHREAD *w;           // the threads
+   long generation;           // number of transforms given to the threads
+   int pending;               // number of threads which did not complete the current transform
+   bool closing;              // true when the threads need to terminate
+   pthread_mutex_t lock;
+   pthread_cond_t go,done;
+};
+
+// graph of the instance and partial vertex order, used for searching for a discretization order (see order.c)
+typedef struct vorder VORDER;
+struct vorder
+{
+   int n;             // number of vertices
+   int *start;        // index of the first neighbor of every vertex (n+1 values)
+   int *adj;          // the neighbors of every vertex, sorted by vertex id
+   bool *exact;       // true if the distance between the vertex and the neighbor is exact
+   REFERENCE **ref;   // the distance between the vertex and the neighbor
+   int size;          // number of vertices in the partial order
+   int *order;        // the vertices in the partial order
+   int *rank;         // the rank of every vertex in the partial order (-1 if not placed)
+   int *cnt,*cex;     // number of distances (and exact distances) between every vertex and the placed ones
+   long budget;       // remaining number of partial orders that can be explored (DMDGP orders)
+   int stamp;         // current visit (see orderDeadEnd)
+   int *mark;         // last visit of every vertex
+   int *queue;        // vertices to be visited
+   int rule;          // choice of the next vertex (DMDGP orders): 0 = given order, 1 = neighbors of the last vertices
+   int *hint;         // rank of every vertex in the given order
+};
+
+// WORKSPACE: memory of the local methods, allocated by the methods when they are invoked (see useWorkspace)
+typedef struct workspace WORKSPACE;
+struct workspace
+{
+   int n;                        // number of vertices
+   int m;                        // number of distances
+   int level;                    // allocated arrays: 0 = none, 1 = y (smacof), 2 = also gX, gy and memory (lbfgsb),
+                                 //                   3 = all arrays (spg)
+   double *y;                    // distance variables
+   double **gX,*gy;              // gradient of the stress function
+   double *memory;               // additional memory for the gradient
+   double *sy,*yp,*gyp;          // additional memory for SPG
+   double **sX,**Xp,**gXp;       // additional memory for SPG
+   double **DX,**YX,**ZX;        // additional memory for SPG
+   double *Dy,*Yy,*Zy;           // additional memory for SPG
+};
+
 // SEARCH: collection of data and additional memory space necessary during the search (BP and SPG)
 typedef struct Search SEARCH;
 struct Search
@@ -80,14 +234,71 @@ struct Search
    bool *sym;                    // boolean vector indicating whether a tree layer is symmetric or not
    triplet *refs;                // triplet vector containing the reference vertices for every vertex
    double **lX,**uX;             // bounds defining the boxes (necessary for SPG)
-   double **pX;                  // additional memory for SPG
-   double *y,*dL,*dU;            // additional memory for SPG
-   double *gy,*sy,*yp,*gyp;      // additional memory for SPG
-   double **gX,**sX,**Xp,**gXp;  // additional memory for SPG
-   double **DX,**YX,**ZX;        // additional memory for SPG
-   double *Dy,*Yy,*Zy;           // additional memory for SPG
-   double *memory;               // additional memory for SPG
+   double **pX;                  // additional memory for bp (previous solution, contracted solutions)
+   WORKSPACE *work;              // memory of the local methods (shared by all copies of the structure)
    double pi;                    // pi
+   int *path;                    // branch taken at every layer of the current path (see pool.c)
+   int *replay;                  // path to be replayed (NULL when the entire tree is explored)
+   EDGES *edges;                 // distances in contiguous arrays (for evaluating the solutions)
+   LOOKAHEAD *ahead;             // bounds implied by the next vertices (NULL if look-ahead pruning is not used)
+   int *epath;                   // path of the last evaluated solution (epath[0] = -1 when it is not valid)
+   double *esum,*emax;           // partial MDE sum and partial LDE at every layer of the last evaluated solution
+   int *rep;                     // previous occurrence of the vertex at every layer (NULL if no vertex is repeated)
+   VERTEX *vsol;                 // the vertices of the solutions (without the copies of the repeated vertices)
+   triplet *tcache;              // triplet selected at every layer by bp_exact when the consecutive one is not used
+};
+
+// pool of threads executing the vector operations of spg (see spg.c)
+typedef struct spgpool SPGPOOL;
+
+// copy in single precision of the data of spg, for the iterations preceding the final polish (see spg.c)
+typedef struct spgfloat SPGFLOAT;
+struct spgfloat
+{
+   int *start;                // the y variables of the distances of vertex i are start[i], ..., start[i+1]-1
+   int *other;                // the other vertex of every distance
+   float *lb,*ub;             // the bounds of every distance
+   float **X;                 // the current point
+   float **lX,**uX;           // the boxes of the vertices
+   float **gX,**Xp,**gXp,**DX; // gradient, previous point and gradient, and direction (X variables)
+   float *memory;             // diagonal terms of the gradient (see stress_gradient)
+   float *y,*gy,*yp,*gyp,*Dy; // y variables, their gradient, previous values and gradient, and direction
+};
+
+// data of one of the threads of spg (see spg.c)
+typedef struct spgthread SPGTHREAD;
+struct spgthread
+{
+   SPGPOOL *pool;             // the pool of the thread
+   int first,last;            // the vertices assigned to the thread are first, ..., last-1
+   int yfirst,ylast;          // and the y variables of their distances are yfirst, ..., ylast-1
+   int lo,hi;                 // the distances of the assigned vertices involve the vertices lo, ..., hi-1 only
+   double **gX;               // partial gradient wrt the variables X (the one in the workspace for the first thread)
+   double *memory;            // partial diagonal terms of the gradient (the one in the workspace for the first thread)
+   float **fgX;               // as gX and memory, in single precision (the ones in SPGFLOAT for the first thread)
+   float *fmemory;
+   double sum[2];             // partial sums computed by the thread
+   bool started;              // true if the thread is running (the first thread is the one calling spg)
+   pthread_t thread;
+};
+
+struct spgpool
+{
+   int n;                     // number of vertices
+   VERTEX *v;                 // the vertices
+   double **X;                // the current point
+   SEARCH S;                  // the memory of spg
+   SPGFLOAT *f;               // the data in single precision (NULL when spg iterates in double precision only)
+   double gam;                // tolerance of the projections on the boxes
+   double mu,alpha;           // spectral parameter and step of the current operation
+   int nthreads;              // number of threads
+   SPGTHREAD *w;              // the threads
+   int task;                  // current operation
+   long generation;           // number of operations given to the threads
+   int pending;               // number of threads which did not complete the current operation
+   bool closing;              // true when the threads need to terminate
+   pthread_mutex_t lock;
+   pthread_cond_t go,done;
 };
 
 // options
@@ -109,10 +320,162 @@ struct option
    double epsalpha; // tolerance epsilon for the alpha step in line search (in SPG, default 1.e-12)
    double mumin;    // minimum value for spectral parameter (for SPG, default 1.e-12)
    double mumax;    // maximum value for spectral parameter (for SPG, default 1.e+12)
+   int precision;   // 1 = the iterations are performed in single precision, and the solution is then polished
+                    // in double precision (for SPG, default 0 = double precision only)
    double be;       // bound expansion variable (for SPG when used as a refinement method)
    bool monitor;    // if false, the small monitor indicating the currently explored layer is not printed
    int print;       // 0 = no print; 1 = print the best solution; >1 = print all solutions (default 0)
-   int format;      // default format is "xyz" (0); it can be changed to "pdb" (1)
+   int format;      // default format is "xyz" (0); it can be changed to "pdb" (1), or to the binary trajectory
+                    // format "bin" (2) or "bin32" (3, coordinates in single precision)
+   int dedup;       // 1 = every new solution is compared to all previous ones, after superposition (for BP, default 0)
+   int best;        // number of best solutions kept in memory and printed at the end (for BP, default 0)
+   int rank;        // the best solutions are the ones with smallest MDE (0, default) or smallest LDE (1)
+   int lookahead;   // maximum number of distances in the paths through the next vertices for look-ahead pruning (for BP, default 0 = not used)
+   int smooth;      // 1 = the bounds of the interval distances are tightened by bound smoothing (default 0)
+   int repeat;      // 1 = some vertices are repeated when the consecutivity assumption is not satisfied (for BP, default 0)
+   int hier;        // 1 = the backbone is placed first, then the other vertices of every group (for BP, default 0)
+   int blocks;      // size of the blocks of vertices solved separately and then stitched together (default 0 = not used)
+   int starts;      // number of runs of the local main method from different starting points (default 1)
+   double cluster;  // RMSD cutoff for clustering the solutions, whose representatives are printed at the end (for BP, default 0 = no clustering)
+};
+
+// asynchronous writer of the solutions (one per run, see writer.c)
+typedef struct writer WRITER;
+struct writer
+{
+   int nv;                    // number of vertices
+   VERTEX *v;                 // the vertex array (names and groups are printed with the coordinates)
+   int format;                // 0 = XYZ, 1 = PDB, 2 = binary, 3 = binary in single precision
+   double eps;                // tolerance used for computing the LDE and MDE values stored in the binary format
+   char **prefix;             // vertex attributes formatted once for all solutions (see vertexPrefixes)
+   char *outfile;             // output file name (with extension)
+   FILE *output;              // output stream (opened at the first solution)
+   char *buffer;              // buffer of the output stream (see wbuffer)
+   bool failed;               // true if an error occurred while writing
+   bool unflushed;            // true if some written solutions were not passed to the system yet
+   struct timespec flushed;   // time of the last flush (see wflush)
+   long fpos;                 // position in the output file at the last flush
+   long bytes;                // size of the last written solution
+   int size;                  // maximum number of queued solutions
+   int head;                  // index of the first queued solution
+   int count;                 // number of queued solutions
+   bool closing;              // true when no more solutions will be queued
+   double ***X;               // queued solutions (3xn matrices)
+   int *n;                    // number of vertices in every queued solution
+   int *s;                    // solution number of every queued solution (see printfile)
+   pthread_t thread;          // the writer thread
+   pthread_mutex_t lock;      // lock on the queue
+   pthread_cond_t notempty;   // signaled when a solution is queued (or when closing)
+   pthread_cond_t notfull;    // signaled when a solution is written
+};
+
+// binary trajectory files (see printfile.c): header
+// (the structure is followed by n vertex records and by the string table containing names and groups)
+typedef struct mdtheader MDTHEADER;
+struct mdtheader
+{
+   char magic[8];             // "MDJEEPT"
+   int32_t order;             // 0x01020304 in the byte order of the machine that wrote the file
+   int32_t version;           // version of the binary format (1)
+   int32_t precision;         // size of the coordinates in bytes (4 = float, 8 = double)
+   int32_t n;                 // number of vertices
+   int64_t hsize;             // size of the header in bytes (vertex records and string table included)
+   int64_t fsize;             // size of every frame in bytes (see trajectoryFrameSize)
+};
+
+// binary trajectory files: vertex record (names and groups are offsets in the string table)
+typedef struct mdtvertex MDTVERTEX;
+struct mdtvertex
+{
+   int32_t Id;
+   int32_t groupId;
+   int32_t Name;
+   int32_t Group;
+};
+
+// binary trajectory files: frame (followed by the coordinates X[0][0..n-1], X[1][0..n-1] and X[2][0..n-1])
+typedef struct mdtframe MDTFRAME;
+struct mdtframe
+{
+   int32_t s;                 // solution number (see printfile)
+   int32_t n;                 // number of vertices in the solution
+   double lde;                // LDE function value
+   double mde;                // MDE function value
+};
+
+// pool of solutions stored as paths in the search tree (see pool.c)
+typedef struct pool POOL;
+struct pool
+{
+   int n;                     // number of layers in every path (vertices from 3 to n-1)
+   int width;                 // number of bits for every layer
+   size_t stride;             // number of bytes for every path
+   int size;                  // number of stored solutions
+   int capacity;              // number of solutions that can be stored before enlarging the pool
+   unsigned char *paths;      // the packed paths
+};
+
+// index of the solutions found by bp, for detecting duplicated solutions (see dedup.c)
+typedef struct dedup DEDUP;
+struct dedup
+{
+   int n;                     // number of vertices
+   double threshold;          // solutions having a smaller RMSD after superposition are duplicates
+   int size;                  // number of kept solutions
+   int capacity;              // number of solutions that can be kept before enlarging the index
+   double *rg;                // radii of gyration of the kept solutions (increasing order)
+   int *id;                   // kept solution corresponding to every radius of gyration
+   double *Y;                 // centered coordinates of the kept solutions (3n values per solution)
+   double *radius;            // distances of the vertices to the centroid (n values per solution)
+   double *y,*r;              // centered coordinates and distances to the centroid of the new solution
+};
+
+// the k best solutions found by bp, organized in a max-heap (see topk.c)
+typedef struct topk TOPK;
+struct topk
+{
+   int k;                     // maximum number of kept solutions
+   int n;                     // number of vertices
+   int rank;                  // 0 = by MDE, 1 = by LDE (see OPTION)
+   int size;                  // number of kept solutions
+   int *heap;                 // slots of the kept solutions (the worst one is at the top)
+   int *s;                    // solution number of every kept solution
+   double *lde,*mde;          // LDE and MDE of every kept solution
+   double ***X;               // coordinates of every kept solution (3xn matrices, allocated for the filled slots only)
+};
+
+// the solutions found by bp, kept in memory for clustering them at the end of the run (see cluster.c)
+typedef struct cluster CLUSTER;
+struct cluster
+{
+   int n;                     // number of vertices
+   double cutoff;             // two solutions are neighbors when their RMSD after superposition is smaller
+   int size;                  // number of kept solutions
+   int capacity;              // number of solutions that can be kept before enlarging the structure
+   int *s;                    // solution number of every kept solution
+   double *rg;                // radii of gyration of the kept solutions
+   int *order;                // kept solutions sorted by radius of gyration
+   double *centroid;          // centroids of the kept solutions (3 values per solution)
+   double *Y;                 // centered coordinates of the kept solutions (3n values per solution)
+   double *radius;            // distances of the vertices to the centroid (n values per solution)
+   int *start,*adj;           // lists of neighbors (the ones of solution k are adj[start[k]], ..., adj[start[k+1]-1])
+   int nclusters;             // number of clusters
+   int *center;               // representative solution of every cluster (clusters by decreasing size)
+   int *csize;                // number of solutions in every cluster
+   int *label;                // cluster of every kept solution
+};
+
+// data of one of the threads computing the pairs of neighbors (see cluster.c)
+typedef struct clusterthread CLUSTERTHREAD;
+struct clusterthread
+{
+   CLUSTER *c;                // the kept solutions
+   int id;                    // thread index (from 0 to nthreads-1)
+   int nthreads;              // number of threads
+   int npairs;                // number of pairs of neighbors found by the thread
+   int capacity;              // number of pairs that can be stored before enlarging the array
+   int *pairs;                // the pairs of neighbors (2 values per pair)
+   pthread_t thread;
 };
 
 // info
@@ -124,30 +487,262 @@ struct information
    unsigned long format;  // format of the distance file, encoded in binary
    char sep;              // separator in distance file
    char *start;           // name of file containing starting point (for SPG)
-   int method;            // solution method (0 is bp, 1 is spg)
-   int refinement;        // refinement method (1 is spg, default and only one in this version)
+   int initial;           // built-in starting point, when no file is given (1 = classical MDS, default, 2 = random)
+   int bestart;           // run giving the best point (option -starts, 0 = from the starting point)
+   char *previous;        // name of file containing the previous instance (incremental mode, NULL if not used)
+   char *prevsol;         // name of file containing a solution of the previous instance (incremental mode)
+   int resume;            // first layer explored by BP in the incremental mode (0 = entire tree, see incremental.c)
+   int method;            // solution method (0 is bp, 1 is spg, 2 is lbfgsb, 3 is smacof)
+   int refinement;        // refinement method (1 is spg, default, 2 is lbfgsb)
    bool exact;            // true if the instance contains only exact distances
    bool consec;           // true if the instance satisfies the consecutivity assumption
    int ndigits;           // number of digits forming the largest vertex rank
    int ncalls;            // number of BP calls
    int nspg;              // number of SPG calls
    int nspgok;            // number of successful SPG calls
+   int nstress;           // number of evaluations of the stress function (spg and lbfgsb)
    int nsols;             // number of solutions found by BP
    int maxsols;           // maximum number of solutions (default 10)
    int pruning;           // number of times the pruning test pruned out tree branches
+   int duplicates;        // number of solutions discarded as duplicates (see dedup.c)
+   int incomplete;        // number of coarse solutions that could not be completed, or whose completion does not
+                          // satisfy the distances (hierarchical mode, see hier.c)
+   double stitch;         // largest RMSD on the vertices shared by two consecutive blocks (see blocks.c)
+   int bsize;             // size of the blocks whose realizations were stitched (0 = entire instance, -1 = stopped
+                          // before, see blocks.c)
+   int clusters;          // number of clusters of solutions (see cluster.c)
    int best_sol;          // integer label of best solution
    double best_mde;       // MDE function value in the best found solution
    double best_lde;       // LDE function value in the best found solution
    char *output;          // name of output file
+   void (*solution)(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info);
+                          // function invoked by bp on every new solution (NULL if not used)
+   bool (*feasible)(int i,double **X,INFORMATION *info);
+                          // function invoked by bp on every partial solution that was not pruned: the branch is
+                          // pruned when it returns false (NULL if not used)
+   void *data;            // additional data for the functions above
+   WRITER *writer;        // asynchronous writer of the solutions (NULL if not used)
+   POOL *pool;            // pool where bp stores the paths of the solutions (NULL if not used)
+   DEDUP *dedup;          // index of the solutions found by bp (NULL if not used)
+   TOPK *topk;            // the k best solutions found by bp (NULL if not used)
+   CLUSTER *cluster;      // the solutions found by bp, kept for clustering them (NULL if not used)
+};
+
+// coarse instance and subproblems of the hierarchical mode (see hier.c)
+typedef struct hierarchy HIERARCHY;
+
+// blocks of vertices solved separately (see blocks.c)
+typedef struct blocks BLOCKS;
+
+// instance: the vertex array together with the data precomputed before invoking the methods
+// (a prepared instance can be solved several times with different options)
+typedef struct instance INSTANCE;
+struct instance
+{
+   int n;          // number of vertices
+   int n0;         // smallest vertex rank in the distance file
+   int m;          // total number of distances
+   int mexact;     // number of exact distances
+   VERTEX *v;      // array of vertices
+   triplet *refs;  // triplets of reference vertices for every vertex (only for bp, NULL otherwise)
+   bool *sym;      // boolean vector indicating whether a tree layer is symmetric or not
+   EDGES *edges;   // distances in contiguous arrays, for evaluating the solutions
+   LOOKAHEAD *ahead; // bounds implied by the next vertices (only for bp with option -lookahead, NULL otherwise)
+   double *bounds; // original bounds of the distances tightened by bound smoothing (NULL if not used)
+   int tightened;  // number of distances tightened by bound smoothing
+   int nrep;       // number of layers of the search tree (positions in the repetition order, n if not used)
+   VERTEX *vrep;   // vertices at every position of the repetition order (NULL if no vertex is repeated)
+   int *rep;       // previous occurrence of the vertex at every position (-1 for first occurrences)
+   HIERARCHY *hier; // coarse instance and subproblems (only for bp with option -hier, NULL otherwise)
+   BLOCKS *blocks; // blocks of vertices solved separately (only with option -blocks, NULL otherwise)
+   bool exact;     // true if the instance only contains exact and precise distances
+   bool consec;    // true if the instance satisfies the consecutivity assumption
+   bool smallsine; // true if some triplets of reference vertices form angles with sine close to zero
+};
+
+// instance kept in memory by the solver daemon (entry of its LRU cache)
+typedef struct cached CACHED;
+struct cached
+{
+   char *key;            // key identifying the instance (source, format, separator, tolerance, method)
+   char *text;           // distance list sent inline (NULL if the instance was read from a file)
+   INSTANCE inst;        // the prepared instance
+   unsigned long last;   // time stamp of the last use (0 if the entry is empty)
+};
+
+// hierarchical mode: the backbone vertices are placed first by bp (coarse instance), then the other vertices of
+// every group are placed by solving one small instance per group (subproblem), see hier.c
+struct hierarchy
+{
+   int nc;                    // number of vertices in the coarse instance
+   int *coarse;               // instance index of every vertex of the coarse instance
+   INSTANCE cinst;            // the coarse instance (prepared for bp)
+   int ngroups;               // number of subproblems (groups having vertices out of the backbone)
+   int *gid;                  // group id of every subproblem
+   int *start;                // the vertices of the subproblem g are vert[start[g]], ..., vert[start[g+1]-1]
+   int *vert;                 // (instance indices: the anchors come first, then the other vertices of the group)
+   int *nanchors;             // number of anchors (backbone vertices with distances to the group) of every subproblem
+   int *cstart;               // the subproblems verified at the layer i of the coarse tree (the ones whose last anchor
+   int *cgroups;              // is the coarse vertex i) are cgroups[cstart[i]], ..., cgroups[cstart[i+1]-1]
+};
+
+// data of a run of the hierarchical mode, for the function invoked by bp on every coarse solution (see hier.c)
+typedef struct hierrun HIERRUN;
+struct hierrun
+{
+   INSTANCE *inst;            // the instance (with its HIERARCHY)
+   double **X;                // the complete solution
+   SEARCH S;                  // memory for the refinement and the evaluation of the complete solutions
+   OPTION op;                 // options of the run
+   INFORMATION *info;         // infos of the run (the complete solutions are counted here)
+};
+
+// data of one of the threads solving the subproblems of the hierarchical mode (see hier.c)
+typedef struct hierthread HIERTHREAD;
+struct hierthread
+{
+   INSTANCE *inst;            // the instance (with its HIERARCHY)
+   double **X;                // the solution being completed (every thread writes the vertices of its subproblems)
+   OPTION op;                 // options for the subproblems
+   int refinement;            // refinement method for the subproblems with interval distances
+   int ng;                    // number of subproblems to be solved
+   int *groups;               // the subproblems to be solved (NULL for all subproblems)
+   int id;                    // thread index (from 0 to nthreads-1)
+   int nthreads;              // number of threads
+   int failed;                // number of subproblems for which no solution was found
+   int ncalls,pruning;        // bp counters over the subproblems solved by the thread
+   int nspg,nspgok;           // spg counters over the subproblems solved by the thread
+   int nstress;               // number of stress evaluations over the subproblems solved by the thread
+   int *local;                // index in the subproblem of every instance vertex (-1 when not in the subproblem)
+   pthread_t thread;
+};
+
+// blocks of consecutive vertices, solved separately and then stitched together (see blocks.c)
+struct blocks
+{
+   int nb;                    // number of blocks
+   int *start;                // the vertices of the block b are start[b], ..., end[b]-1 (the vertices start[b], ...,
+   int *end;                  // end[b-1]-1 are shared with the previous block)
+   INSTANCE *binst;           // the instance of every block (prepared for the selected method)
+};
+
+// data of one of the threads solving the blocks (see blocks.c)
+typedef struct blockthread BLOCKTHREAD;
+struct blockthread
+{
+   INSTANCE *inst;            // the instance (with its BLOCKS)
+   double **X;                // the starting point (for spg)
+   OPTION op;                 // options for the blocks
+   INFORMATION info;          // infos for the blocks
+   int id;                    // thread index (from 0 to nthreads-1)
+   int nthreads;              // number of threads
+   long deadline;             // time (seconds, see gettimeofday) after which bp is not run on the blocks
+   int current;               // block currently solved by the thread
+   double ***Y;               // the solutions of every block (shared by all threads, every thread writes its blocks)
+   int *ny;                   // number of solutions of every block
+   int ncalls,pruning;        // bp counters over the blocks solved by the thread
+   int nspg,nspgok;           // spg counters over the blocks solved by the thread
+   int nstress;               // number of stress evaluations over the blocks solved by the thread
+   pthread_t thread;
+};
+
+// data of one of the threads running the local method from several starting points (see start.c)
+typedef struct startthread STARTTHREAD;
+struct startthread
+{
+   INSTANCE *inst;            // the instance
+   double **X0;               // the starting point of the first run
+   OPTION op;                 // options of the local method (without printing and monitor)
+   INFORMATION info;          // the selected local method
+   int nruns;                 // total number of runs
+   int id;                    // thread index (from 0 to nthreads-1)
+   int nthreads;              // number of threads
+   double **X;                // the best point found by the thread
+   int best;                  // run giving the best point (-1 if no run was performed)
+   double obj;                // stress function value in the best point
+   int its,flag;              // number of iterations and termination flag of the best run
+   int nstress;               // number of stress evaluations over the runs of the thread
+   pthread_t thread;
+};
+
+// handle of the MDjeep library (the public interface is in mdjeep.h)
+struct mdjeep
+{
+   OPTION op;                 // options
+   INFORMATION info;          // infos (the counters refer to the last run)
+   INSTANCE inst;             // the loaded instance
+   bool loaded;               // true if an instance is loaded
+   bool prepared;             // true if the loaded instance is prepared for the selected method
+   bool check_consec;         // true if the consecutivity assumption needs to be verified
+   bool started;              // true if a starting point for spg was given
+   double **X;                // matrix of coordinates (starting point for spg, last found solution for bp)
+   int nd;                    // number of distances given one by one (instance not built yet)
+   int dsize;                 // size of the arrays below
+   int *did1,*did2;           // vertex ranks of the distances given one by one
+   double *dlb,*dub;          // bounds of the distances given one by one
+   mdjeep_solution solution;  // function invoked on every solution (NULL if not used)
+   void *data;                // additional data for the function above
+   MDSTATS stats;             // results of the last run
+   int iterating;             // solution iterator: 0 = not started, 1 = search suspended, 2 = search completed
+   bool stopping;             // true if the suspended search needs to be unwound
+   int maxsols;               // limit on the number of solutions (restored at the end of the iteration)
+   double elapsed;            // time spent in the search by the iterator
+   char *stack;               // stack of the coroutine running bp
+   SEARCH S;                  // memory for the search run by the iterator
+   MDSOLUTION current;        // last solution found by the iterator
+   ucontext_t caller;         // context of the caller of mdjeep_next_solution
+   ucontext_t search;         // context of the coroutine running bp
+   bool pooling;              // true if the pool of solutions is enabled
+   POOL *pool;                // pool of the solutions found by the last run of bp
+   int *path;                 // memory for the paths extracted from the pool
 };
 
 // Function prototypes
 // -------------------
 
+// align.c
+void jacobi4(double A[4][4],double V[4][4]);
+void hornRotation(double *H,double *R);
+double superpose(int k,double **A,int *ia,double **B,int *ib,bool reflection,double *R,double *t);
+void transformPoints(int k,double **A,int *ia,double *R,double *t,double **B,int *ib);
+
+// blocks.c
+int blockEnd(int n,VERTEX *v,int end,bool grouped);
+bool tryBlock(INSTANCE *inst,int start,int end,int *vert,int *local,OPTION op,INFORMATION *info,INSTANCE *b);
+char* newBlocks(INSTANCE *inst,OPTION op,INFORMATION *info);
+BLOCKS* freeBlocks(BLOCKS *bl);
+void blockSolution(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info);
+void* blockThread(void *arg);
+double blockViolation(int start,int end,VERTEX *v,double **X);
+bool assembleBlocks(INSTANCE *inst,double **X0,double **X,SEARCH S,OPTION op,INFORMATION *info,long deadline,int *its,double *obj,int *flag);
+int solveBlocks(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj);
+
 // bp.c
+void startSearch(int n,SEARCH S,INFORMATION *info);
 void bp(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info);
 void bp_exact(int i,int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info);
+double tripletError(int i,VERTEX *v,double **X,triplet t,double eps,double bound);
 void intHandler(int a);  // signal catcher
+void clearInterrupt(void);
+void evaluateSolution(int n,double **X,SEARCH S,double *lde,double *mde);
+
+// cluster.c
+CLUSTER* newCluster(int n,double cutoff);
+long clusterMemory(CLUSTER *c);
+CLUSTER* freeCluster(CLUSTER *c);
+void addToCluster(CLUSTER *c,double **X,int s);
+void* neighborThread(void *arg);
+void computeNeighbors(CLUSTER *c);
+int clusterSolutions(CLUSTER *c);
+void printCluster(CLUSTER *c,VERTEX *v,OPTION op,INFORMATION *info);
+
+// dedup.c
+DEDUP* newDedup(int n,double threshold);
+long dedupMemory(DEDUP *d);
+DEDUP* freeDedup(DEDUP *d);
+double centerSolution(int n,double **X,double *y,double *r);
+double superposedSquaredRMSD(int n,double *y,double gy,double *z,double gz);
+bool isDuplicate(DEDUP *d,double **X);
 
 // distance.c
 double pairwise_distance(double xA,double yA,double zA,double xB,double yB,double zB);
@@ -198,16 +793,53 @@ void printDistanceList(int n,VERTEX *v,bool symmetric);
 void printVertex(VERTEX v);
 VERTEX* freeVertex(int n,VERTEX *v);
 
+// hier.c
+bool isBackboneVertex(VERTEX *v);
+void subInstance(INSTANCE *inst,int k,int *vert,int na,int *local,double **X,INSTANCE *sub);
+char* newHierarchy(INSTANCE *inst,OPTION op,INFORMATION *info);
+HIERARCHY* freeHierarchy(HIERARCHY *h);
+void* hierarchyThread(void *arg);
+int placeGroups(INSTANCE *inst,double **X,OPTION op,INFORMATION *info,int ng,int *groups);
+bool coarseFeasible(int i,double **X,INFORMATION *info);
+void coarseSolution(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info);
+void hierarchicalSolve(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION *info);
+
+// incremental.c
+int firstChangedLayer(int n,VERTEX *v,VERTEX *w);
+int readPreviousSolution(FILE *input,INSTANCE *inst,double **X);
+char* previousSolution(INSTANCE *inst,INFORMATION *info,double **X);
+void resumeSearch(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION *info);
+
+// instance.c
+long instanceMemory(int n,int m);
+char* readInstance(FILE *input,char sep,unsigned long format,INSTANCE *inst);
+char* checkInstance(INSTANCE *inst,OPTION *op,INFORMATION *info);
+char* prepareInstance(INSTANCE *inst,OPTION op,INFORMATION *info,bool check_consec);
+void setupInstance(INSTANCE *inst,OPTION *op,INFORMATION *info);
+void freeInstance(INSTANCE *inst);
+
+// memory.c
+void memoryUsage(int category,long bytes);
+void resetPeakMemory(void);
+size_t peakMemory(int category);
+long matrixMemory(size_t n,size_t m);
+long vectorMemory(size_t n);
+char* memoryString(size_t bytes);
+
 // matrices.c   
+double* alignedBlock(size_t n);
 double* allocateVector(size_t n);
 void copyVector(size_t n,double *source,double *dest);
 void differenceVector(size_t n,double *a,double *b,double *c);
 double normVector(size_t n,double *v);
+double dotProdVector(size_t n,double *v1,double *v2);
 bool areSameVector(size_t,double *v1,double *v2);
 void crossProdVector(double *v1,double *v2,double *res);
 void printVector(size_t n,double *v);
 double* freeVector(double *v);
 double** allocateMatrix(size_t n,size_t m);
+float* allocateFloatVector(size_t n);
+float** allocateFloatMatrix(size_t n,size_t m);
 void copyMatrix(size_t n,size_t m,double **source,double **dest);
 void copyCenterMatrix(size_t n,size_t m,double **source,double **dest);
 void differenceMatrix(size_t n,size_t m,double **A,double **B,double **C);
@@ -215,25 +847,164 @@ bool areSameMatrix(size_t n,size_t m,double **A,double **B);
 void UMatrix(int i3,int i2,int i1,int i,double **X,double *U);
 void genCoordinates(int i1,int i,double **X,double *U,double di1i,double ctheta,double stheta,double comega,double somega);
 void printMatrix(size_t n,size_t m,double **a);
+void symmetricEigen(int n,double **A,double **V);
 double** freeMatrix(size_t n,double **a);
+float* freeFloatVector(float *v);
+float** freeFloatMatrix(size_t n,float **a);
+
+// mdjeep.c (see mdjeep.h for the library interface)
+char* mdjeep_instance(MDJEEP *md);
+void mdjeep_unload(MDJEEP *md);
+void mdjeep_bpsolution(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info);
+char* mdjeep_setup(MDJEEP *md);
+void mdjeep_results(MDJEEP *md,int its,double obj,int flag,double time);
+double elapsedTime(struct timeval t1,struct timeval t2);
+void mdjeep_search(void);
+void mdjeep_yield(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info);
+char* attributeError(const char *attribute,const char *value);
+
+// lbfgsb.c
+void packVariables(int n,double **X,int m,double *y,double *x);
+void unpackVariables(int n,double *x,int m,double **X,double *y);
+int lbfgsb(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj);
+
+// lookahead.c
+LOOKAHEAD* newLookAhead(int n,EDGES *e,int hops);
+long lookAheadMemory(LOOKAHEAD *la);
+LOOKAHEAD* freeLookAhead(LOOKAHEAD *la);
 
 // objfun.c
 double compute_mde(int n,VERTEX *v,double **X,double eps);
 double compute_lde(int n,VERTEX *v,double **X,double eps);
+EDGES* newEdges(int n,VERTEX *v,double eps);
+long edgesMemory(EDGES *e);
+EDGES* freeEdges(EDGES *e);
+void compute_errors(EDGES *e,double **X,double *verr,double *lde,double *mde);
+void update_errors(EDGES *e,int k,double **X,double *esum,double *emax,double *lde,double *mde);
 double compute_stress(int n,VERTEX *v,double **X,double *y);
 void stress_gradient(int n,VERTEX *v,double **X,double *y,double **gX,double *gy,double *memory);
 
+// order.c
+VORDER* newOrder(int n,VERTEX *v,double eps);
+VORDER* freeOrder(VORDER *o);
+int orderDistance(VORDER *o,int a,int b);
+void placeVertex(VORDER *o,int x);
+void unplaceVertex(VORDER *o);
+void clearOrder(VORDER *o);
+bool orderReferences(VORDER *o,int x);
+bool greedyDDGP(VORDER *o);
+bool orderDeadEnd(VORDER *o);
+bool searchDMDGP(VORDER *o);
+double orderQuality(VORDER *o,int *order,int *ninterval);
+bool findOrder(int n,VERTEX *v,double eps,bool consec,int *order);
+char* writeOrderedInstance(INSTANCE *inst,int *order,unsigned long format,char sep,char *filename);
+char* writeOrderedMDfile(char *mdfile,char *outfile,char *instfile,INSTANCE *inst,int *order);
+char* orderedFileName(char *filename);
+char* orderInstance(char *mdfile,bool consec);
+
 // pruningtest.c
 double DDF(int id,VERTEX *v,double **X);
+double BoundedDDF(int id,VERTEX *v,double **X,double bound);
+double SolutionDDF(int n,VERTEX *v,double **X);
+double LookAheadDDF(int id,LOOKAHEAD *la,double **X);
+double BoxLookAheadDDF(int id,LOOKAHEAD *la,double **lX,double **uX);
 double BoxDDF(int id,VERTEX *v,double **lX,double **uX);
 
+// repeat.c
+bool isReferenceOf(VERTEX *v,int a,int b);
+int repeatVertices(INSTANCE *inst);
+void freeRepetitionOrder(INSTANCE *inst);
+int firstOccurrence(int *rep,int p);
+bool isRepetitionDMDGP(int n,VERTEX *v,int *rep,double eps);
+void findRepetitionSymmetries(int n,int *rep,bool *sym);
+int contractSolution(int n,int *rep,double **X,double **Y);
+
+// server.c
+int mdjeep_serve(int argc,char *argv[]);
+int serveJob(FILE *in,FILE *out,CACHED *cache,int csize,unsigned long *clock);
+void serverSolution(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info);
+void serverError(FILE *out,char *message);
+char* instanceKey(char *filename,char *text,OPTION op,INFORMATION info,bool check_consec);
+CACHED* cacheLookup(CACHED *cache,int csize,char *key,char *text);
+CACHED* cacheSlot(CACHED *cache,int csize);
+
+// smacof.c
+SMACOFPOOL* newSmacofPool(int n,SMOOTH *s,double **X,double **J);
+void* smacofThread(void *arg);
+void smacofKernel(SMACOFTHREAD *w);
+double guttmanTransform(SMACOFPOOL *p);
+void freeSmacofPool(SMACOFPOOL *p);
+int smacof(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj);
+
+// smooth.c
+int smoothDistance(SMOOTH *s,int a,int b);
+SMOOTH* newSmooth(int n,VERTEX *v,double eps);
+long smoothMemory(SMOOTH *s);
+SMOOTH* freeSmooth(SMOOTH *s);
+void smoothPosition(double dab,double dac,double dbc,double *x,double *r);
+void smoothTetrangle(SMOOTHTHREAD *w,int e,int i,int j);
+double smoothTriangle(SMOOTH *s,int e,int i,int j);
+void* smoothThread(void *arg);
+double runSmooth(SMOOTH *s,int phase);
+int smoothBounds(INSTANCE *inst,double eps);
+void restoreBounds(INSTANCE *inst);
+
+// start.c
+double startSide(int n,VERTEX *v);
+void randomStart(int n,VERTEX *v,double **X,unsigned int seed);
+void heapUp(int *heap,int *pos,double *key,int k);
+void heapDown(int *heap,int *pos,double *key,int size,int k);
+void shortestPaths(SMOOTH *s,double *len,int source,double *sp,int *heap,int *pos);
+void mdsStart(int n,VERTEX *v,double **X,double eps);
+void builtinStart(int n,VERTEX *v,double **X,double eps,INFORMATION *info);
+void* startThread(void *arg);
+int multiStart(INSTANCE *inst,double **X,OPTION op,INFORMATION *info,int *its,double *obj);
+
+// solver.c
+void defaultOptions(OPTION *op,INFORMATION *info);
+char* readArguments(int argc,char *argv[],OPTION *op,INFORMATION *info,bool *check_consec);
+bool reportSolution(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION *info,double *lde,double *mde);
+long searchMemory(int n);
+long workspaceMemory(int n,int m,int level);
+void allocateSearch(SEARCH *S,int n,int m);
+void useWorkspace(WORKSPACE *W,int level);
+void freeSearch(SEARCH *S);
+const char* methodName(int method);
+int localOptimization(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj);
+int solveInstance(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj);
+
 // spg.c
 double scalarProd(int n,double **X1,double **X2,int m,double *y1,double *y2);
 double norm(int n,double **X,int m,double *y);
+SPGPOOL* newSpgPool(int n,VERTEX *v,double **X,SEARCH S,double gam);
+void* spgThread(void *arg);
+void spgKernel(SPGPOOL *p,SPGTHREAD *w,int task);
+void spgRun(SPGPOOL *p,int task);
+double spgSum(SPGPOOL *p,int k);
+void freeSpgPool(SPGPOOL *p);
+float floatDistance(int i,int j,float **X);
+long spgFloatMemory(int n,int m);
+void newSpgFloat(SPGPOOL *p);
+void spgFloatKernel(SPGPOOL *p,SPGTHREAD *w,int task);
+void freeSpgFloat(SPGPOOL *p);
+int spgIterations(SPGPOOL *p,int base,OPTION op,INFORMATION *info,int maxIt,double mu0,int *its,double *obj);
 int spg(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj);
 
+// pool.c
+POOL* newPool(int n);
+long poolMemory(POOL *p);
+void clearPool(POOL *p);
+POOL* freePool(POOL *p);
+void setPathBits(unsigned char *path,int width,int l,int b);
+int getPathBits(unsigned char *path,int width,int l);
+void widenPool(POOL *p,int width);
+void addToPool(POOL *p,int *path);
+void getPath(POOL *p,int k,int *path);
+bool rebuildSolution(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION info,int *path);
+
 // readfile.c
 size_t textFileAnalysis(FILE *input,char sep,size_t *wordlen,size_t *linelen);
+void defaultAttributes(OPTION *op,INFORMATION *info);
 char* readMDfile(FILE *input,OPTION *op,INFORMATION *info);
 bool isDistanceFileValid(FILE *input,char sep,unsigned long *typelist,size_t msize,char *memory);
 unsigned long readFormat(const char *c);
@@ -242,8 +1013,26 @@ int readDistanceFile(FILE *input,char sep,int n,int n0,VERTEX *v,unsigned long f
 int readStartingPoint(FILE *input,int n,double **X);
 
 // print.c
+char* outputFileName(char *filename,char *extension);
+char** vertexPrefixes(int n,VERTEX *v,int format);
+char** freePrefixes(int n,char **prefix);
+void writeXYZ(FILE *output,int n,char **prefix,double **X,int s);
+void writePDB(FILE *output,int n,char **prefix,double **X,int s,char *outfile);
 void printfile(int n,VERTEX *v,double **X,char *filename,int s);
 void printpdb(int n,VERTEX *v,double **X,char *filename,int s);
+int64_t trajectoryFrameSize(int n,int precision);
+void writeMDT(FILE *output,int n,VERTEX *v,double **X,int s,double lde,double mde,int precision);
+void printmdt(int n,VERTEX *v,double **X,char *filename,int s,double eps,int precision);
+char* convertTrajectory(char *trajfile,int format);
+
+// topk.c
+TOPK* newTopk(int k,int n,int rank);
+long topkMemory(TOPK *t);
+TOPK* freeTopk(TOPK *t);
+bool topkWorse(TOPK *t,int h1,int h2);
+void topkSiftDown(TOPK *t,int p,int size);
+void addToTopk(TOPK *t,double **X,int s,double lde,double mde);
+void printTopk(TOPK *t,VERTEX *v,OPTION op,INFORMATION *info);
 
 // utils.c
 omegaList initOmegaList(double l,double u);
@@ -285,6 +1074,15 @@ double minimum(double a,double b,double c);
 double maximum(double a,double b,double c);
 void mdjeep_usage(void);
 
+// writer.c
+WRITER* openWriter(int n,VERTEX *v,char *filename,int format,double eps);
+void writeSolution(WRITER *w,int n,double **X,int s);
+bool writeQueued(WRITER *w,int k);
+bool flushWriter(WRITER *w);
+void* writerThread(void *arg);
+void closeWriter(WRITER *w);
+void printSolution(int n,VERTEX *v,double **X,OPTION op,INFORMATION *info,int s);
+
 // splitime.c
 char* splitime(struct timeval start,struct timeval end);
 
@@ -0,0 +1,311 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - clustering of the solutions
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (option -cluster)
+************************************************************************************************************/
+
+#include "bp.h"
+#include <unistd.h>
+
+// the solutions found by bp are kept in memory (centered coordinates and centroids), and clustered at the end
+// of the run: two solutions are neighbors when their RMSD after the optimal superposition is smaller than the
+// cutoff; the pairs of neighbors are computed by several threads (the lower bounds on the RMSD used in dedup.c
+// avoid most of the superpositions), then the clusters are formed with the method of Daura et al.: the solution
+// having the largest number of neighbors is the representative of a new cluster containing all its neighbors,
+// and the procedure is repeated on the remaining solutions (the clusters are therefore sorted by decreasing size)
+
+// number of threads computing the pairs of neighbors (0 = one per available processor)
+int cthreads = 0;
+
+// this function creates an empty CLUSTER structure for solutions with n vertices
+CLUSTER* newCluster(int n,double cutoff)
+{
+   CLUSTER *c;
+
+   c = (CLUSTER*)calloc(1,sizeof(CLUSTER));
+   c->n = n;
+   c->cutoff = cutoff;
+   c->size = 0;  c->capacity = 0;
+   c->s = NULL;  c->rg = NULL;  c->centroid = NULL;
+   c->Y = NULL;  c->radius = NULL;
+   c->order = NULL;  c->start = NULL;  c->adj = NULL;
+   c->nclusters = 0;
+   c->center = NULL;  c->csize = NULL;  c->label = NULL;
+   memoryUsage(2,clusterMemory(c));
+   return c;
+};
+
+// this function gives the memory of the stored solutions (see memory.c)
+long clusterMemory(CLUSTER *c)
+{
+   return sizeof(CLUSTER) + (long)c->capacity*(2*sizeof(int) + 4*sizeof(double) + 4*c->n*sizeof(double));
+};
+
+// this function frees the CLUSTER structure
+CLUSTER* freeCluster(CLUSTER *c)
+{
+   if (c == NULL)  return NULL;
+   memoryUsage(2,-clusterMemory(c));
+   free(c->s);  free(c->rg);  free(c->centroid);
+   free(c->Y);  free(c->radius);
+   free(c->order);  free(c->start);  free(c->adj);
+   free(c->center);  free(c->csize);  free(c->label);
+   free(c);
+   return NULL;
+};
+
+// this function adds the solution X (solution number s) to the CLUSTER structure
+void addToCluster(CLUSTER *c,double **X,int s)
+{
+   int a,b,h,k,n;
+   double *y;
+
+   // enlarging the structure
+   n = c->n;
+   if (c->size == c->capacity)
+   {
+      memoryUsage(2,-clusterMemory(c));
+      c->capacity = 2*c->capacity + 64;
+      c->s = (int*)realloc(c->s,c->capacity*sizeof(int));
+      c->order = (int*)realloc(c->order,c->capacity*sizeof(int));
+      c->rg = (double*)realloc(c->rg,c->capacity*sizeof(double));
+      c->centroid = (double*)realloc(c->centroid,(size_t)3*c->capacity*sizeof(double));
+      c->Y = (double*)realloc(c->Y,(size_t)3*c->capacity*n*sizeof(double));
+      c->radius = (double*)realloc(c->radius,(size_t)c->capacity*n*sizeof(double));
+      memoryUsage(2,clusterMemory(c));
+   };
+
+   // centered coordinates (the centroid is kept for printing the representatives)
+   k = c->size;
+   y = c->Y + (size_t)3*k*n;
+   c->rg[k] = centerSolution(n,X,y,c->radius + (size_t)k*n);
+   c->centroid[3*k] = X[0][0] - y[0];
+   c->centroid[3*k+1] = X[1][0] - y[n];
+   c->centroid[3*k+2] = X[2][0] - y[2*n];
+   c->s[k] = s;
+
+   // the solutions remain sorted by radius of gyration (binary search)
+   a = 0;  b = c->size;
+   while (a < b)
+   {
+      h = (a + b)/2;
+      if (c->rg[c->order[h]] <= c->rg[k])
+         a = h + 1;
+      else
+         b = h;
+   };
+   memmove(c->order + a + 1,c->order + a,(c->size - a)*sizeof(int));
+   c->order[a] = k;
+   c->size++;
+};
+
+// this function computes the pairs of neighbors assigned to one thread (executed by the threads)
+// -> the solutions are considered in increasing order of radius of gyration: the thread t takes the
+//    positions t, t + nthreads, t + 2*nthreads, ... and compares them to the following positions only
+void* neighborThread(void *arg)
+{
+   int i,j,l,p,q,n;
+   double t2,sum;
+   double *ri,*rj;
+   CLUSTERTHREAD *w = (CLUSTERTHREAD*)arg;
+   CLUSTER *c = w->c;
+
+   n = c->n;
+   t2 = c->cutoff*c->cutoff;
+   for (p = w->id; p < c->size; p = p + w->nthreads)
+   {
+      i = c->order[p];
+      ri = c->radius + (size_t)i*n;
+      for (q = p + 1; q < c->size && c->rg[c->order[q]] - c->rg[i] < c->cutoff; q++)
+      {
+         j = c->order[q];
+
+         // fingerprint
+         rj = c->radius + (size_t)j*n;
+         sum = 0.0;
+         for (l = 0; l < n && sum < t2*n; l++)  sum = sum + (ri[l] - rj[l])*(ri[l] - rj[l]);
+         if (sum >= t2*n)  continue;
+
+         // superposition
+         if (superposedSquaredRMSD(n,c->Y + (size_t)3*i*n,c->rg[i],c->Y + (size_t)3*j*n,c->rg[j]) >= t2)  continue;
+
+         // storing the pair
+         if (w->npairs == w->capacity)
+         {
+            w->capacity = 2*w->capacity + 1024;
+            w->pairs = (int*)realloc(w->pairs,(size_t)2*w->capacity*sizeof(int));
+         };
+         w->pairs[2*w->npairs] = i;
+         w->pairs[2*w->npairs+1] = j;
+         w->npairs++;
+      };
+   };
+   return NULL;
+};
+
+// this function computes the lists of neighbors of all kept solutions
+// -> the neighbors of the solution k are adj[start[k]], ..., adj[start[k+1]-1]
+void computeNeighbors(CLUSTER *c)
+{
+   int i,j,k,t,nthreads;
+   size_t npairs;
+   int *fill;
+   bool *started;
+   CLUSTERTHREAD *w;
+   sigset_t all,previous;
+
+   // number of threads
+   nthreads = cthreads;
+   if (nthreads <= 0)  nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+   if (nthreads > c->size)  nthreads = c->size;
+   if (nthreads < 1)  nthreads = 1;
+
+   // the signals (^C) are handled by the search thread only
+   w = (CLUSTERTHREAD*)calloc(nthreads,sizeof(CLUSTERTHREAD));
+   started = (bool*)calloc(nthreads,sizeof(bool));
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK,&all,&previous);
+   for (t = 0; t < nthreads; t++)
+   {
+      w[t].c = c;  w[t].id = t;  w[t].nthreads = nthreads;
+      w[t].npairs = 0;  w[t].capacity = 0;  w[t].pairs = NULL;
+      if (t > 0)  started[t] = (pthread_create(&w[t].thread,NULL,neighborThread,&w[t]) == 0);
+   };
+   pthread_sigmask(SIG_SETMASK,&previous,NULL);
+
+   // the calling thread takes the first share, and the share of the threads that could not be created
+   neighborThread(&w[0]);
+   for (t = 1; t < nthreads; t++)
+   {
+      if (started[t])
+         pthread_join(w[t].thread,NULL);
+      else
+         neighborThread(&w[t]);
+   };
+
+   // lists of neighbors
+   c->start = (int*)realloc(c->start,(c->size + 1)*sizeof(int));
+   for (k = 0; k <= c->size; k++)  c->start[k] = 0;
+   npairs = 0;
+   for (t = 0; t < nthreads; t++)
+   {
+      for (k = 0; k < w[t].npairs; k++)
+      {
+         c->start[w[t].pairs[2*k]+1]++;
+         c->start[w[t].pairs[2*k+1]+1]++;
+      };
+      npairs = npairs + w[t].npairs;
+   };
+   for (k = 0; k < c->size; k++)  c->start[k+1] = c->start[k+1] + c->start[k];
+   c->adj = (int*)realloc(c->adj,(2*npairs > 0 ? 2*npairs : 1)*sizeof(int));
+   fill = (int*)calloc(c->size + 1,sizeof(int));
+   for (k = 0; k < c->size; k++)  fill[k] = c->start[k];
+   for (t = 0; t < nthreads; t++)
+   {
+      for (k = 0; k < w[t].npairs; k++)
+      {
+         i = w[t].pairs[2*k];  j = w[t].pairs[2*k+1];
+         c->adj[fill[i]++] = j;
+         c->adj[fill[j]++] = i;
+      };
+      free(w[t].pairs);
+   };
+   free(fill);
+   free(started);
+   free(w);
+};
+
+// this function clusters the kept solutions (method of Daura et al., see above)
+// -> the returning value is the number of clusters
+int clusterSolutions(CLUSTER *c)
+{
+   int i,k,h,best,size;
+   int *count,*members;
+
+   computeNeighbors(c);
+
+   // number of neighbors not yet in a cluster
+   count = (int*)calloc(c->size + 1,sizeof(int));
+   members = (int*)calloc(c->size + 1,sizeof(int));
+   c->label = (int*)realloc(c->label,(c->size + 1)*sizeof(int));
+   c->center = (int*)realloc(c->center,(c->size + 1)*sizeof(int));
+   c->csize = (int*)realloc(c->csize,(c->size + 1)*sizeof(int));
+   for (k = 0; k < c->size; k++)
+   {
+      count[k] = c->start[k+1] - c->start[k];
+      c->label[k] = -1;
+   };
+
+   c->nclusters = 0;
+   do
+   {
+      // the solution having the largest number of neighbors (the first found one in case of ties)
+      best = -1;
+      for (k = 0; k < c->size; k++)
+      {
+         if (c->label[k] < 0)  if (best < 0 || count[k] > count[best])  best = k;
+      };
+      if (best < 0)  break;
+
+      // the new cluster
+      size = 0;
+      c->label[best] = c->nclusters;
+      members[size++] = best;
+      for (h = c->start[best]; h < c->start[best+1]; h++)
+      {
+         i = c->adj[h];
+         if (c->label[i] < 0)
+         {
+            c->label[i] = c->nclusters;
+            members[size++] = i;
+         };
+      };
+      c->center[c->nclusters] = best;
+      c->csize[c->nclusters] = size;
+      c->nclusters++;
+
+      // updating the number of neighbors of the remaining solutions
+      for (k = 0; k < size; k++)
+      {
+         for (h = c->start[members[k]]; h < c->start[members[k]+1]; h++)
+         {
+            i = c->adj[h];
+            if (c->label[i] < 0)  count[i]--;
+         };
+      };
+   }
+   while (true);
+
+   free(members);
+   free(count);
+   return c->nclusters;
+};
+
+// this function prints the representatives of the clusters, from the largest cluster to the smallest one
+// (see printSolution): the representatives are numbered by cluster in the output file
+// -> a single representative is printed as with option -p
+void printCluster(CLUSTER *c,VERTEX *v,OPTION op,INFORMATION *info)
+{
+   int i,k,r,n;
+   double *y;
+   double **X;
+
+   n = c->n;
+   X = allocateMatrix(3,n);
+   for (r = 0; r < c->nclusters; r++)
+   {
+      k = c->center[r];
+      y = c->Y + (size_t)3*k*n;
+      for (i = 0; i < n; i++)
+      {
+         X[0][i] = y[i] + c->centroid[3*k];
+         X[1][i] = y[n+i] + c->centroid[3*k+1];
+         X[2][i] = y[2*n+i] + c->centroid[3*k+2];
+      };
+      printSolution(n,v,X,op,info,c->nclusters == 1 ? 0 : r + 1);
+   };
+   freeMatrix(3,X);
+};
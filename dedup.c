@@ -0,0 +1,206 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - duplicated solutions
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (index over all solutions found by bp)
+                                    correlation matrix computed in one pass (used also in cluster.c)
+                                    memory counted (see memory.c)
+************************************************************************************************************/
+
+#include "bp.h"
+
+// two solutions are duplicates when their RMSD, after the optimal superposition (translations, rotations and
+// reflections), is smaller than the threshold; every new solution is compared to all kept solutions, and two
+// lower bounds on the RMSD, invariant w.r.t. rotations and reflections, avoid most of the superpositions:
+// -> the difference between the radii of gyration: the kept solutions are sorted by radius of gyration,
+//    so that only the ones in the interval [rg - threshold,rg + threshold] are considered
+// -> the root mean square difference between the distances of every vertex to the centroid
+//    (the fingerprint of the solution)
+
+// this function creates an empty index for solutions with n vertices
+DEDUP* newDedup(int n,double threshold)
+{
+   DEDUP *d;
+
+   d = (DEDUP*)calloc(1,sizeof(DEDUP));
+   d->n = n;
+   d->threshold = threshold;
+   d->size = 0;  d->capacity = 0;
+   d->rg = NULL;  d->id = NULL;
+   d->Y = NULL;  d->radius = NULL;
+   d->y = allocateVector(3*n);
+   d->r = allocateVector(n);
+   memoryUsage(2,dedupMemory(d));
+   return d;
+};
+
+// this function gives the memory of the index (see memory.c)
+long dedupMemory(DEDUP *d)
+{
+   return sizeof(DEDUP) + (long)d->capacity*(sizeof(double) + sizeof(int) + 4*d->n*sizeof(double))
+          + vectorMemory(3*d->n) + vectorMemory(d->n);
+};
+
+// this function frees the index
+DEDUP* freeDedup(DEDUP *d)
+{
+   if (d == NULL)  return NULL;
+   memoryUsage(2,-dedupMemory(d));
+   free(d->rg);  free(d->id);
+   free(d->Y);  free(d->radius);
+   freeVector(d->y);  freeVector(d->r);
+   free(d);
+   return NULL;
+};
+
+// this function computes the centered coordinates y (x coordinates, then y and z), the distances r of the
+// vertices to the centroid, and the radius of gyration of a solution X
+double centerSolution(int n,double **X,double *y,double *r)
+{
+   int i,k;
+   double c,g;
+
+   for (k = 0; k < 3; k++)
+   {
+      c = 0.0;
+      for (i = 0; i < n; i++)  c = c + X[k][i];
+      c = c/n;
+      for (i = 0; i < n; i++)  y[k*n+i] = X[k][i] - c;
+   };
+   g = 0.0;
+   for (i = 0; i < n; i++)
+   {
+      r[i] = y[i]*y[i] + y[n+i]*y[n+i] + y[2*n+i]*y[2*n+i];
+      g = g + r[i];
+      r[i] = sqrt(r[i]);
+   };
+   return sqrt(g/n);
+};
+
+// this function computes the squared RMSD between two centered solutions y and z (with radii of gyration
+// gy and gz) after the optimal superposition (rotations and reflections)
+// -> the optimal value is given by the singular values of H = y z^T, i.e. the square roots of the
+//    eigenvalues of the symmetric matrix H^T H (computed in closed form)
+double superposedSquaredRMSD(int n,double *y,double gy,double *z,double gz)
+{
+   int i,j,k;
+   double H[9],M[9];
+   double p,p1,p2,q,c,phi,e[3];
+   double sum;
+   double *y0,*y1,*y2,*z0,*z1,*z2;
+
+   // correlation matrix (one pass on the coordinates, the 9 sums are independent)
+   y0 = y;  y1 = y + n;  y2 = y + 2*n;
+   z0 = z;  z1 = z + n;  z2 = z + 2*n;
+   for (k = 0; k < 9; k++)  H[k] = 0.0;
+   for (i = 0; i < n; i++)
+   {
+      H[0] = H[0] + y0[i]*z0[i];  H[1] = H[1] + y0[i]*z1[i];  H[2] = H[2] + y0[i]*z2[i];
+      H[3] = H[3] + y1[i]*z0[i];  H[4] = H[4] + y1[i]*z1[i];  H[5] = H[5] + y1[i]*z2[i];
+      H[6] = H[6] + y2[i]*z0[i];  H[7] = H[7] + y2[i]*z1[i];  H[8] = H[8] + y2[i]*z2[i];
+   };
+
+   // M = H^T H
+   for (j = 0; j < 3; j++)
+   {
+      for (k = 0; k < 3; k++)
+      {
+         M[3*j+k] = H[j]*H[k] + H[3+j]*H[3+k] + H[6+j]*H[6+k];
+      };
+   };
+
+   // eigenvalues of M
+   p1 = M[1]*M[1] + M[2]*M[2] + M[5]*M[5];
+   q = (M[0] + M[4] + M[8])/3.0;
+   p2 = (M[0] - q)*(M[0] - q) + (M[4] - q)*(M[4] - q) + (M[8] - q)*(M[8] - q) + 2.0*p1;
+   if (p2 <= 0.0)
+   {
+      e[0] = q;  e[1] = q;  e[2] = q;
+   }
+   else
+   {
+      p = sqrt(p2/6.0);
+      M[0] = (M[0] - q)/p;  M[4] = (M[4] - q)/p;  M[8] = (M[8] - q)/p;
+      M[1] = M[1]/p;  M[2] = M[2]/p;  M[5] = M[5]/p;
+      c = 0.5*(M[0]*(M[4]*M[8] - M[5]*M[5]) - M[1]*(M[1]*M[8] - M[5]*M[2]) + M[2]*(M[1]*M[5] - M[4]*M[2]));
+      if (c < -1.0)  c = -1.0;
+      if (c > 1.0)  c = 1.0;
+      phi = acos(c)/3.0;
+      e[0] = q + 2.0*p*cos(phi);
+      e[2] = q + 2.0*p*cos(phi + 2.0*M_PI/3.0);
+      e[1] = 3.0*q - e[0] - e[2];
+   };
+
+   // squared RMSD
+   sum = 0.0;
+   for (k = 0; k < 3; k++)  if (e[k] > 0.0)  sum = sum + sqrt(e[k]);
+   sum = gy*gy + gz*gz - 2.0*sum/n;
+   if (sum < 0.0)  sum = 0.0;
+   return sum;
+};
+
+// this function verifies whether the solution X is a duplicate of one of the solutions in the index;
+// if not, the solution is added to the index
+// -> the returning value is true if X is a duplicate
+bool isDuplicate(DEDUP *d,double **X)
+{
+   int i,k,a,b,h,n;
+   double g,t2,sum;
+   double *z,*rz;
+
+   n = d->n;
+   t2 = d->threshold*d->threshold;
+   g = centerSolution(n,X,d->y,d->r);
+
+   // first kept solution having a radius of gyration larger than g - threshold (binary search)
+   a = 0;  b = d->size;
+   while (a < b)
+   {
+      h = (a + b)/2;
+      if (d->rg[h] < g - d->threshold)
+         a = h + 1;
+      else
+         b = h;
+   };
+
+   // candidate solutions
+   for (h = a; h < d->size && d->rg[h] <= g + d->threshold; h++)
+   {
+      k = d->id[h];
+
+      // fingerprint
+      rz = d->radius + (size_t)k*n;
+      sum = 0.0;
+      for (i = 0; i < n && sum < t2*n; i++)  sum = sum + (d->r[i] - rz[i])*(d->r[i] - rz[i]);
+      if (sum >= t2*n)  continue;
+
+      // superposition
+      z = d->Y + (size_t)3*k*n;
+      if (superposedSquaredRMSD(n,d->y,g,z,d->rg[h]) < t2)  return true;
+   };
+
+   // enlarging the index
+   if (d->size == d->capacity)
+   {
+      memoryUsage(2,-dedupMemory(d));
+      d->capacity = 2*d->capacity + 64;
+      d->rg = (double*)realloc(d->rg,d->capacity*sizeof(double));
+      d->id = (int*)realloc(d->id,d->capacity*sizeof(int));
+      d->Y = (double*)realloc(d->Y,(size_t)3*d->capacity*n*sizeof(double));
+      d->radius = (double*)realloc(d->radius,(size_t)d->capacity*n*sizeof(double));
+      memoryUsage(2,dedupMemory(d));
+   };
+
+   // adding the new solution (the index remains sorted by radius of gyration)
+   k = d->size;
+   memcpy(d->Y + (size_t)3*k*n,d->y,3*n*sizeof(double));
+   memcpy(d->radius + (size_t)k*n,d->r,n*sizeof(double));
+   for (h = a; h < d->size && d->rg[h] < g; h++);
+   memmove(d->rg + h + 1,d->rg + h,(d->size - h)*sizeof(double));
+   memmove(d->id + h + 1,d->id + h,(d->size - h)*sizeof(int));
+   d->rg[h] = g;  d->id[h] = k;
+   d->size++;
+   return false;
+};
@@ -8,6 +8,7 @@
                                     data structures
               Mar 21 2020  v.0.3.1  adding numberOfExactDistances and rangeOfDistance
               May 19 2020  v.0.3.2  adding box_distance and nextDistance
+              Oct 18 2026  v.0.3.3  freeReference frees the entire list (in linear time)
 ****************************************************************************************************/
 
 #include "bp.h"
@@ -288,19 +289,13 @@ void printDistances(REFERENCE *ref)
 // given a REFERENCE, this function frees its memory
 REFERENCE* freeReference(REFERENCE *ref)
 {
+   REFERENCE *next;
+
    while (ref != NULL)
    {
-      if (ref->next == NULL)
-      {
-         free(ref);
-         ref = NULL;
-      }
-      else
-      {
-         while (ref->next->next != NULL)  ref = ref->next;
-         free(ref->next);
-         ref->next = NULL;
-      };
+      next = ref->next;
+      free(ref);
+      ref = next;
    };
    return NULL;
 };
@@ -0,0 +1,608 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - hierarchical mode
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (option -hier)
+************************************************************************************************************/
+
+#include "bp.h"
+#include <unistd.h>
+#include <limits.h>
+
+extern double INFTY;
+extern size_t instlen;
+extern __thread bool keep_going;
+
+// in the hierarchical mode, the backbone vertices (the ones whose names are in hbackbone) form the coarse
+// instance, which is solved first by bp; every coarse solution is then completed by placing the other vertices of
+// every group: one small instance per group (subproblem) is solved by bp, whose first vertices are the anchors
+// (the backbone vertices having distances to the other vertices of the group, whose relative positions are taken
+// from the coarse solution), followed by the other vertices of the group; the subproblems are solved by several
+// threads, and their solutions are superposed on the anchors (see superpose); finally, the complete solution is
+// refined by spg over the entire instance
+// -> the coarse tree has as many layers as the backbone, and the backtracking on the other vertices is limited
+//    to their subproblems
+// -> the distances out of the backbone still prune the coarse tree: as soon as the last anchor of a subproblem is
+//    placed, the subproblem is solved, and the branch is pruned if no solution is found (see coarseFeasible)
+// -> the distances between vertices of different groups are only considered by the final refinement: the complete
+//    solutions that still do not satisfy them are discarded (the mode is experimental: it is meant for instances
+//    where the distances out of the backbone are within the groups, and it may find no solutions otherwise)
+// -> the coarse solutions are completed again at the end, because the refinement may have moved some anchors after
+//    the verification of their subproblems: the coarse solutions that cannot be completed are discarded as well
+
+// number of threads solving the subproblems (0 = one per available processor)
+int hthreads = 0;
+
+// the distances between the anchors of a subproblem that are not in the instance are the ones of the coarse solution,
+// within +/- hslack (the anchors placed in the subproblem can slightly move with respect to the coarse solution)
+double hslack = 0.2;
+
+// names of the backbone vertices
+char *hbackbone[] = {"N","CA","C",NULL};
+
+// this function verifies whether a vertex belongs to the backbone
+bool isBackboneVertex(VERTEX *v)
+{
+   int k;
+
+   for (k = 0; hbackbone[k] != NULL; k++)  if (!strcmp(v->Name,hbackbone[k]))  return true;
+   return false;
+};
+
+// this function builds the instance formed by the k vertices vert of an instance (in the given order)
+// -> the first na vertices are anchors: the distances between them are the ones of the instance, or the ones of
+//    the realization X (instance indices) within +/- hslack when they are not in the instance; all the other
+//    distances are the ones of the instance between the k vertices
+// -> local is an array of inst->n integers set to -1 (it is restored at the end)
+void subInstance(INSTANCE *inst,int k,int *vert,int na,int *local,double **X,INSTANCE *sub)
+{
+   int a,b,c,x;
+   double d,lb,ub;
+   REFERENCE *ref;
+   VERTEX *v,*w;
+
+   v = inst->v;
+   w = (VERTEX*)calloc(k,sizeof(VERTEX));
+   for (c = 0; c < k; c++)
+   {
+      x = vert[c];
+      local[x] = c;
+      initVertex(&w[c],v[x].Id,v[x].groupId,v[x].Name,v[x].Group);
+   };
+
+   // distances between the anchors
+   for (b = 1; b < na; b++)
+   {
+      for (a = 0; a < b; a++)
+      {
+         ref = getReference(v,vert[a],vert[b]);
+         if (ref != NULL)
+         {
+            lb = lowerBound(ref);  ub = upperBound(ref);
+         }
+         else
+         {
+            d = distance(vert[a],vert[b],X);
+            lb = d - hslack;  ub = d + hslack;
+            if (lb < 0.0)  lb = 0.0;
+         };
+         if (w[b].ref == NULL)
+            w[b].ref = initReference(a,lb,ub);
+         else
+            addDistance(w[b].ref,a,lb,ub);
+      };
+   };
+
+   // distances of the instance (every distance is in the list of the vertex coming later)
+   for (c = 0; c < k; c++)
+   {
+      for (ref = v[vert[c]].ref; ref != NULL; ref = ref->next)
+      {
+         a = local[otherVertexId(ref)];
+         if (a < 0)  continue;
+         if (a < na && c < na)  continue;
+         b = c;
+         if (a > b)
+         {
+            b = a;  a = c;
+         };
+         if (w[b].ref == NULL)
+            w[b].ref = initReference(a,lowerBound(ref),upperBound(ref));
+         else
+            addDistance(w[b].ref,a,lowerBound(ref),upperBound(ref));
+      };
+   };
+   for (c = 0; c < k; c++)  local[vert[c]] = -1;
+
+   // the instance
+   sub->n = k;  sub->n0 = 1;
+   sub->m = totalNumberOfDistances(k,w);  sub->mexact = 0;
+   memoryUsage(0,instanceMemory(sub->n,sub->m));
+   sub->v = w;  sub->refs = NULL;  sub->sym = NULL;  sub->edges = NULL;
+   sub->ahead = NULL;  sub->bounds = NULL;  sub->tightened = 0;
+   sub->nrep = k;  sub->vrep = NULL;  sub->rep = NULL;  sub->hier = NULL;  sub->blocks = NULL;
+   sub->exact = false;  sub->consec = false;  sub->smallsine = false;
+};
+
+// this function prepares the hierarchical mode for a verified instance (see checkInstance): the coarse instance
+// is prepared for bp, and the subproblems are defined and verified (their anchors are not placed yet)
+// -> the vertex groups are given by the group ids
+// -> inst->hier is set on success; the returning value is a NULL char on success, and a char pointer to the
+//    error description otherwise
+char* newHierarchy(INSTANCE *inst,OPTION op,INFORMATION *info)
+{
+   int i,j,g,h,k,n,x,u,p,q,na,cnt,cex,tmp,total,capacity;
+   int *deg,*astart,*adj,*pairs,*anchors,*mark,*local,*cidx;
+   double *alb,*aub;
+   bool grouped;
+   char *error,*cerror;
+   REFERENCE *ref;
+   VERTEX *v;
+   HIERARCHY *hi;
+   OPTION opc;
+   INFORMATION infoc;
+
+   n = inst->n;  v = inst->v;
+
+   // the groups are necessary
+   grouped = false;
+   for (i = 1; i < n; i++)  if (v[i].groupId != v[0].groupId)  grouped = true;
+   if (!grouped)
+   {
+      return strdup("mdjeep: error: the hierarchical mode requires the group ids of the vertices (groupId1 and groupId2 in the format)");
+   };
+
+   // the backbone
+   hi = (HIERARCHY*)calloc(1,sizeof(HIERARCHY));
+   hi->coarse = (int*)calloc(n,sizeof(int));
+   hi->nc = 0;
+   for (i = 0; i < n; i++)  if (isBackboneVertex(&v[i]))  hi->coarse[hi->nc++] = i;
+   if (hi->nc < 4)
+   {
+      freeHierarchy(hi);
+      return strdup("mdjeep: error: the hierarchical mode requires at least 4 backbone vertices (named N, CA or C)");
+   };
+
+   // symmetric lists of neighbors
+   deg = (int*)calloc(n,sizeof(int));
+   for (i = 0; i < n; i++)
+   {
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
+      {
+         deg[i]++;
+         deg[otherVertexId(ref)]++;
+      };
+   };
+   astart = (int*)calloc(n+1,sizeof(int));
+   for (i = 0; i < n; i++)  astart[i+1] = astart[i] + deg[i];
+   adj = (int*)calloc(astart[n] > 0 ? astart[n] : 1,sizeof(int));
+   alb = allocateVector(astart[n] > 0 ? astart[n] : 1);
+   aub = allocateVector(astart[n] > 0 ? astart[n] : 1);
+   for (i = 0; i < n; i++)  deg[i] = astart[i];
+   for (i = 0; i < n; i++)
+   {
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
+      {
+         j = otherVertexId(ref);
+         adj[deg[i]] = j;  alb[deg[i]] = lowerBound(ref);  aub[deg[i]] = upperBound(ref);  deg[i]++;
+         adj[deg[j]] = i;  alb[deg[j]] = lowerBound(ref);  aub[deg[j]] = upperBound(ref);  deg[j]++;
+      };
+   };
+   free(deg);
+
+   // the other vertices, sorted by group (and then by index): insertion sort on the pairs (group id, index),
+   // which are generally already in order
+   pairs = (int*)calloc(2*n,sizeof(int));
+   k = 0;
+   for (i = 0; i < n; i++)
+   {
+      if (isBackboneVertex(&v[i]))  continue;
+      pairs[2*k] = v[i].groupId;  pairs[2*k+1] = i;
+      for (p = k; p > 0 && pairs[2*(p-1)] > pairs[2*p]; p--)
+      {
+         tmp = pairs[2*p];  pairs[2*p] = pairs[2*(p-1)];  pairs[2*(p-1)] = tmp;
+         tmp = pairs[2*p+1];  pairs[2*p+1] = pairs[2*(p-1)+1];  pairs[2*(p-1)+1] = tmp;
+      };
+      k++;
+   };
+
+   // the subproblems
+   hi->gid = (int*)calloc(k+1,sizeof(int));
+   hi->start = (int*)calloc(k+2,sizeof(int));
+   hi->nanchors = (int*)calloc(k+1,sizeof(int));
+   capacity = 2*k + 16;
+   hi->vert = (int*)calloc(capacity,sizeof(int));
+   anchors = (int*)calloc(n,sizeof(int));
+   mark = (int*)calloc(n,sizeof(int));
+   local = (int*)calloc(n,sizeof(int));
+   for (i = 0; i < n; i++)  mark[i] = -1;
+   for (i = 0; i < n; i++)  local[i] = -1;
+   hi->ngroups = 0;  total = 0;
+   error = NULL;
+   for (p = 0; p < k && error == NULL; p = q)
+   {
+      g = hi->ngroups;
+      for (q = p; q < k && pairs[2*q] == pairs[2*p]; q++);
+
+      // anchors (in the order of the instance)
+      na = 0;
+      for (j = p; j < q; j++)
+      {
+         x = pairs[2*j+1];
+         for (h = astart[x]; h < astart[x+1]; h++)
+         {
+            u = adj[h];
+            if (mark[u] == g || !isBackboneVertex(&v[u]))  continue;
+            mark[u] = g;
+            anchors[na] = u;
+            for (i = na; i > 0 && anchors[i-1] > anchors[i]; i--)
+            {
+               tmp = anchors[i];  anchors[i] = anchors[i-1];  anchors[i-1] = tmp;
+            };
+            na++;
+         };
+      };
+      if (na < 3)
+      {
+         error = (char*)calloc(instlen,sizeof(char));
+         sprintf(error,"mdjeep: error: the vertices of group %d have distances to less than 3 backbone vertices (hierarchical mode)",pairs[2*p]);
+         break;
+      };
+
+      // the vertices of the subproblem
+      if (total + na + q - p > capacity)
+      {
+         capacity = 2*capacity + na + q - p;
+         hi->vert = (int*)realloc(hi->vert,capacity*sizeof(int));
+      };
+      hi->gid[g] = pairs[2*p];
+      hi->start[g] = total;
+      hi->nanchors[g] = na;
+      for (j = 0; j < na; j++)  hi->vert[total++] = anchors[j];
+      for (j = p; j < q; j++)  hi->vert[total++] = pairs[2*j+1];
+      hi->ngroups++;
+
+      // every vertex needs at least 3 reference vertices among the previous ones (2 with exact distances)
+      for (j = hi->start[g]; j < total; j++)  local[hi->vert[j]] = j - hi->start[g];
+      for (j = hi->start[g] + na; j < total && error == NULL; j++)
+      {
+         x = hi->vert[j];
+         cnt = 0;  cex = 0;
+         for (h = astart[x]; h < astart[x+1]; h++)
+         {
+            u = adj[h];
+            if (local[u] < 0 || local[u] >= local[x])  continue;
+            cnt++;
+            if (aub[h] - alb[h] <= op.eps)  cex++;
+         };
+         if (cnt < 3 || cex < 2)
+         {
+            error = (char*)calloc(instlen,sizeof(char));
+            sprintf(error,"mdjeep: error: vertex %d cannot be placed from the backbone and the previous vertices of its group (hierarchical mode)",inst->n0+x);
+         };
+      };
+      for (j = hi->start[g]; j < total; j++)  local[hi->vert[j]] = -1;
+   };
+   hi->start[hi->ngroups] = total;
+   free(pairs);  free(anchors);  free(mark);
+
+   // the subproblems verified at every layer of the coarse tree (the anchors are in the order of the coarse vertices)
+   if (error == NULL)
+   {
+      cidx = (int*)calloc(n,sizeof(int));
+      for (i = 0; i < hi->nc; i++)  cidx[hi->coarse[i]] = i;
+      for (g = 0; g < hi->ngroups; g++)  local[g] = cidx[hi->vert[hi->start[g]+hi->nanchors[g]-1]];
+      hi->cstart = (int*)calloc(hi->nc+1,sizeof(int));
+      hi->cgroups = (int*)calloc(hi->ngroups,sizeof(int));
+      for (g = 0; g < hi->ngroups; g++)  hi->cstart[local[g]+1]++;
+      for (i = 0; i < hi->nc; i++)  hi->cstart[i+1] = hi->cstart[i+1] + hi->cstart[i];
+      for (i = 0; i < hi->nc; i++)  cidx[i] = hi->cstart[i];
+      for (g = 0; g < hi->ngroups; g++)  hi->cgroups[cidx[local[g]]++] = g;
+      for (g = 0; g < hi->ngroups; g++)  local[g] = -1;
+      free(cidx);
+   };
+   free(adj);  free(astart);
+   freeVector(alb);  freeVector(aub);
+
+   // the coarse instance
+   if (error == NULL)
+   {
+      subInstance(inst,hi->nc,hi->coarse,0,local,NULL,&hi->cinst);
+      opc = op;  opc.hier = 0;  opc.repeat = 0;  opc.smooth = 0;
+      infoc = *info;
+      cerror = checkInstance(&hi->cinst,&opc,&infoc);
+      if (cerror == NULL)  cerror = prepareInstance(&hi->cinst,opc,&infoc,false);
+      if (cerror != NULL)
+      {
+         error = (char*)calloc(instlen+strlen(cerror),sizeof(char));
+         sprintf(error,"mdjeep: error: the backbone of the instance cannot be solved by bp (hierarchical mode)\n%s",cerror);
+         free(cerror);
+      };
+   };
+   free(local);
+
+   // ending
+   if (error != NULL)
+   {
+      freeHierarchy(hi);
+      return error;
+   };
+   inst->hier = hi;
+   return NULL;
+};
+
+// this function frees the HIERARCHY structure
+HIERARCHY* freeHierarchy(HIERARCHY *h)
+{
+   if (h == NULL)  return NULL;
+   freeInstance(&h->cinst);
+   free(h->coarse);
+   free(h->gid);  free(h->start);  free(h->vert);  free(h->nanchors);
+   free(h->cstart);  free(h->cgroups);
+   free(h);
+   return NULL;
+};
+
+// this function solves the subproblems assigned to one thread (executed by the threads), and places their vertices
+// in the solution being completed (the thread t takes the subproblems t, t + nthreads, t + 2*nthreads, ...
+// in the list of the subproblems to be solved)
+void* hierarchyThread(void *arg)
+{
+   int p,g,k,na,its;
+   int *vert;
+   double obj,R[9],t[3];
+   double *Z[3];
+   double **Y;
+   char *error;
+   HIERTHREAD *w = (HIERTHREAD*)arg;
+   HIERARCHY *h = w->inst->hier;
+   INSTANCE sub;
+   OPTION op,opd;
+   INFORMATION info;
+   SEARCH S;
+
+   for (p = w->id; p < w->ng; p = p + w->nthreads)
+   {
+      g = (w->groups == NULL) ? p : w->groups[p];
+      vert = h->vert + h->start[g];
+      k = h->start[g+1] - h->start[g];
+      na = h->nanchors[g];
+
+      // the subproblem (the distances between the anchors are the ones of the coarse solution)
+      subInstance(w->inst,k,vert,na,w->local,w->X,&sub);
+      op = w->op;
+      defaultOptions(&opd,&info);
+      info.method = 0;  info.refinement = w->refinement;
+      info.maxsols = 1;
+      error = checkInstance(&sub,&op,&info);
+      if (error == NULL)  error = prepareInstance(&sub,op,&info,false);
+      if (error != NULL)
+      {
+         free(error);
+         w->failed++;
+         freeInstance(&sub);
+         continue;
+      };
+
+      // solving the subproblem, and superposing its solution on the anchors of the coarse solution
+      allocateSearch(&S,sub.nrep,sub.m);
+      Y = allocateMatrix(3,sub.nrep);
+      solveInstance(&sub,Y,S,op,&info,&its,&obj);
+      if (info.nsols > 0)
+      {
+         superpose(na,Y,NULL,w->X,vert,true,R,t);
+         Z[0] = Y[0] + na;  Z[1] = Y[1] + na;  Z[2] = Y[2] + na;
+         transformPoints(k-na,Z,NULL,R,t,w->X,vert+na);
+      }
+      else
+      {
+         w->failed++;
+      };
+      w->ncalls = w->ncalls + info.ncalls;
+      w->pruning = w->pruning + info.pruning;
+      w->nspg = w->nspg + info.nspg;
+      w->nspgok = w->nspgok + info.nspgok;
+      w->nstress = w->nstress + info.nstress;
+      freeMatrix(3,Y);
+      freeSearch(&S);
+      freeInstance(&sub);
+   };
+   return NULL;
+};
+
+// this function places the vertices of the ng subproblems in the list groups (all subproblems if groups is NULL)
+// by solving them with several threads (see hierarchyThread); the coordinates of their anchors are in X
+// (instance indices)
+// -> the calling thread is running bp on the coarse instance, so that it does not solve subproblems itself
+//    (the status of the search is kept per thread); the subproblems of a thread that could not be created
+//    are counted as failed
+// -> the returning value is the number of subproblems for which no solution was found
+int placeGroups(INSTANCE *inst,double **X,OPTION op,INFORMATION *info,int ng,int *groups)
+{
+   int i,t,p,nthreads,failed;
+   bool *started;
+   HIERTHREAD *w;
+   sigset_t all,previous;
+
+   // number of threads
+   nthreads = hthreads;
+   if (nthreads <= 0)  nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+   if (nthreads > ng)  nthreads = ng;
+   if (nthreads < 1)  return 0;
+
+   // options for the subproblems (only one solution, nothing is printed)
+   op.allone = 1;  op.print = 0;  op.best = 0;  op.cluster = 0.0;  op.dedup = 0;
+   op.symmetry = 0;  op.lookahead = 0;  op.smooth = 0;  op.repeat = 0;  op.hier = 0;
+   op.monitor = false;
+
+   // the signals (^C) are handled by the main thread only
+   w = (HIERTHREAD*)calloc(nthreads,sizeof(HIERTHREAD));
+   started = (bool*)calloc(nthreads,sizeof(bool));
+   for (t = 0; t < nthreads; t++)
+   {
+      w[t].inst = inst;  w[t].X = X;  w[t].op = op;
+      w[t].refinement = info->refinement;
+      w[t].ng = ng;  w[t].groups = groups;
+      w[t].id = t;  w[t].nthreads = nthreads;
+      w[t].failed = 0;  w[t].ncalls = 0;  w[t].pruning = 0;
+      w[t].nspg = 0;  w[t].nspgok = 0;  w[t].nstress = 0;
+      w[t].local = (int*)calloc(inst->n,sizeof(int));
+      for (i = 0; i < inst->n; i++)  w[t].local[i] = -1;
+   };
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK,&all,&previous);
+   for (t = 0; t < nthreads; t++)  started[t] = (pthread_create(&w[t].thread,NULL,hierarchyThread,&w[t]) == 0);
+   pthread_sigmask(SIG_SETMASK,&previous,NULL);
+
+   // waiting for the threads
+   failed = 0;
+   for (t = 0; t < nthreads; t++)
+   {
+      if (started[t])
+      {
+         pthread_join(w[t].thread,NULL);
+         failed = failed + w[t].failed;
+      }
+      else
+      {
+         for (p = t; p < ng; p = p + nthreads)  failed++;
+      };
+      info->ncalls = info->ncalls + w[t].ncalls;
+      info->pruning = info->pruning + w[t].pruning;
+      info->nspg = info->nspg + w[t].nspg;
+      info->nspgok = info->nspgok + w[t].nspgok;
+      info->nstress = info->nstress + w[t].nstress;
+      free(w[t].local);
+   };
+   free(started);
+   free(w);
+   return failed;
+};
+
+// this function verifies a partial coarse solution (it is invoked by bp after placing the coarse vertex i, see
+// INFORMATION): the subproblems whose last anchor is the vertex i are solved, and the branch is pruned if one of
+// them has no solution
+bool coarseFeasible(int i,double **X,INFORMATION *info)
+{
+   int j,ng;
+   HIERRUN *run = (HIERRUN*)info->data;
+   HIERARCHY *h = run->inst->hier;
+
+   ng = h->cstart[i+1] - h->cstart[i];
+   if (ng == 0)  return true;
+   for (j = 0; j <= i; j++)
+   {
+      run->X[0][h->coarse[j]] = X[0][j];
+      run->X[1][h->coarse[j]] = X[1][j];
+      run->X[2][h->coarse[j]] = X[2][j];
+   };
+   return placeGroups(run->inst,run->X,run->op,run->info,ng,h->cgroups + h->cstart[i]) == 0;
+};
+
+// this function completes every coarse solution found by bp (it replaces the function invoked by bp on every
+// solution, see INFORMATION): the coarse solution is completed, refined by spg over the entire instance,
+// and treated as a solution found by bp on the instance (see bp_exact)
+void coarseSolution(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info)
+{
+   int i,its;
+   double obj;
+   HIERRUN *run = (HIERRUN*)info->data;
+   INSTANCE *inst = run->inst;
+   HIERARCHY *h = inst->hier;
+   OPTION op = run->op;
+   INFORMATION *rinfo = run->info;
+   INFORMATION infor;
+   SEARCH S = run->S;
+
+   // the coarse solution
+   for (i = 0; i < n; i++)
+   {
+      run->X[0][h->coarse[i]] = X[0][i];
+      run->X[1][h->coarse[i]] = X[1][i];
+      run->X[2][h->coarse[i]] = X[2][i];
+   };
+
+   // the other vertices
+   if (placeGroups(inst,run->X,op,rinfo,h->ngroups,NULL) > 0)
+   {
+      rinfo->incomplete++;
+      return;
+   };
+
+   // refinement over the entire instance
+   for (i = 0; i < inst->n; i++)
+   {
+      createBox(i,run->X,op.be,S.lX,S.uX);
+      expandBounds(i,inst->v,S.lX,S.uX,op.be,op.eps);
+   };
+   infor = *rinfo;
+   infor.method = 0;  infor.refinement = (rinfo->refinement == 2) ? 2 : 1;
+   localOptimization(inst->n,inst->v,run->X,S,op,&infor,&its,&obj);
+   rinfo->nstress = infor.nstress;
+   rinfo->nspg++;
+
+   // the complete solution is discarded when its vertices do not satisfy the distances as the ones of the solutions
+   // found by bp (see SolutionDDF): the search on the coarse instance goes on
+   if (SolutionDDF(inst->n,inst->v,run->X) >= op.eps)
+   {
+      rinfo->incomplete++;
+      return;
+   };
+
+   // the complete solution
+   if (reportSolution(inst,run->X,S,op,rinfo,&lde,&mde))
+   {
+      if (lde < op.eps)  rinfo->nspgok++;
+   };
+
+   // the search on the coarse instance stops after one solution, or after maxsols solutions
+   if (op.allone == 1 && rinfo->nsols > 0)  keep_going = false;
+   if (rinfo->nsols >= rinfo->maxsols)  keep_going = false;
+};
+
+// this function runs bp in the hierarchical mode (see above) on a prepared instance
+// -> X, S, op and info are the ones given to solveInstance (the complete solutions are treated as the
+//    solutions found by bp, but they are not stored in the pool of solutions, as they are not paths of a tree)
+void hierarchicalSolve(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION *info)
+{
+   int its;
+   double obj;
+   double **Xc;
+   HIERARCHY *h = inst->hier;
+   HIERRUN run;
+   OPTION opc;
+   INFORMATION infoc;
+   SEARCH Sc;
+
+   // data of the run
+   run.inst = inst;  run.X = X;  run.S = S;
+   run.op = op;  run.info = info;
+   info->incomplete = 0;
+
+   // options and infos for the coarse instance (the coarse solutions are given to coarseSolution)
+   opc = op;
+   opc.allone = 0;  opc.print = 0;  opc.best = 0;  opc.cluster = 0.0;  opc.dedup = 0;
+   opc.repeat = 0;  opc.smooth = 0;  opc.hier = 0;
+   infoc = *info;
+   infoc.output = NULL;  infoc.solution = coarseSolution;  infoc.feasible = coarseFeasible;  infoc.data = &run;
+   infoc.writer = NULL;  infoc.pool = NULL;  infoc.dedup = NULL;  infoc.topk = NULL;  infoc.cluster = NULL;
+   infoc.nsols = 0;  infoc.maxsols = INT_MAX;  infoc.pruning = 0;
+   infoc.nspg = 0;  infoc.nspgok = 0;  infoc.nstress = 0;  infoc.duplicates = 0;
+   infoc.best_sol = 0;  infoc.best_mde = INFTY;  infoc.best_lde = INFTY;
+   setupInstance(&h->cinst,&opc,&infoc);
+
+   // solving the coarse instance
+   allocateSearch(&Sc,h->cinst.nrep,h->cinst.m);
+   Xc = allocateMatrix(3,h->cinst.nrep);
+   info->ncalls = 0;
+   solveInstance(&h->cinst,Xc,Sc,opc,&infoc,&its,&obj);
+   info->ncalls = info->ncalls + infoc.ncalls;
+   info->pruning = info->pruning + infoc.pruning;
+   info->nspg = info->nspg + infoc.nspg;
+   info->nspgok = info->nspgok + infoc.nspgok;
+   info->nstress = info->nstress + infoc.nstress;
+   freeMatrix(3,Xc);
+   freeSearch(&Sc);
+};
@@ -0,0 +1,191 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - incremental mode
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (option -incr)
+************************************************************************************************************/
+
+#include "bp.h"
+
+extern size_t instlen;
+
+// in the incremental mode, the instance is a modified version of a previous instance, for which a solution is
+// available; the two distance lists are compared, and the first vertex (in the vertex order) whose distances to
+// the previous vertices changed is the first layer affected by the modifications: bp keeps the coordinates of the
+// previous solution for all vertices before this layer, and it explores the search tree only from this layer;
+// when spg is the selected method, the previous solution is the starting point
+// -> the distances between the kept vertices did not change, so that the kept prefix is as feasible as it was in
+//    the previous solution (when bp uses the refinement, spg may still slightly move the kept vertices)
+// -> the search is performed again from the beginning when the modifications concern the first layers
+// -> only the subtree of the kept prefix is explored: the solutions differing from the previous one before the
+//    first modified layer are not found
+
+// this function compares the distances of two vertex arrays with the same n vertices
+// -> the returning value is the first vertex whose set of distances to the previous vertices differs,
+//    or n if the two sets are identical for all vertices
+int firstChangedLayer(int n,VERTEX *v,VERTEX *w)
+{
+   int i;
+   REFERENCE *ref,*old;
+
+   for (i = 0; i < n; i++)
+   {
+      if (numberOfDistances(v[i].ref) != numberOfDistances(w[i].ref))  return i;
+      for (ref = v[i].ref; ref != NULL; ref = nextDistance(ref))
+      {
+         old = getReference(w,otherVertexId(ref),i);
+         if (old == NULL)  return i;
+         if (lowerBound(old) != lowerBound(ref) || upperBound(old) != upperBound(ref))  return i;
+      };
+   };
+   return n;
+};
+
+// this function reads a solution of the instance from a text file
+// -> every line containing at least three numbers gives the coordinates of one vertex (the last three numbers):
+//    when other words precede the coordinates, the first word is the vertex rank (XYZ files written by mdjeep),
+//    otherwise the vertices are given in the order of the instance
+// -> only the first solution is read when the file contains several ones (MODEL lines)
+// -> the returning value is the number of vertices whose coordinates were read, or -1 if an invalid vertex
+//    rank was found
+int readPreviousSolution(FILE *input,INSTANCE *inst,double **X)
+{
+   int i,k,nw,count;
+   size_t len;
+   char *line,*c,*end;
+   char *word[64];
+   double x[3];
+   bool *placed;
+
+   line = NULL;  len = 0;
+   count = 0;  k = 0;
+   placed = (bool*)calloc(inst->n,sizeof(bool));
+   while (getline(&line,&len,input) > 0)
+   {
+      // a second model ends the first solution
+      if (!strncmp(line,"MODEL",5))
+      {
+         if (count > 0)  break;
+         continue;
+      };
+
+      // splitting the line in words
+      nw = 0;
+      c = strtok(line," \t\r\n");
+      while (c != NULL && nw < 64)
+      {
+         word[nw] = c;
+         nw++;
+         c = strtok(NULL," \t\r\n");
+      };
+      if (nw < 3)  continue;
+
+      // coordinates
+      for (i = 0; i < 3; i++)
+      {
+         x[i] = strtod(word[nw-3+i],&end);
+         if (end == word[nw-3+i] || *end != '\0')  break;
+      };
+      if (i < 3)  continue;
+
+      // vertex
+      if (nw > 3)
+      {
+         if (!isInteger(word[0]))  continue;
+         k = atoi(word[0]) - inst->n0;
+      };
+      if (k < 0 || k >= inst->n || placed[k])
+      {
+         free(line);
+         free(placed);
+         return -1;
+      };
+      X[0][k] = x[0];  X[1][k] = x[1];  X[2][k] = x[2];
+      placed[k] = true;
+      count++;
+      k++;
+   };
+   free(line);
+   free(placed);
+   return count;
+};
+
+// this function prepares the incremental mode: the previous instance is compared with the current one, and the
+// previous solution is loaded in X (see readPreviousSolution)
+// -> the names of the files are in INFORMATION (previous and prevsol, see option -incr); the previous instance
+//    has the same format of the current one
+// -> the first layer explored by bp is given in info->resume (0 when the search needs to start from the beginning)
+// -> the returning value is a NULL char on success, and a char pointer to the error description otherwise
+char* previousSolution(INSTANCE *inst,INFORMATION *info,double **X)
+{
+   int i,k;
+   char *error;
+   FILE *input;
+   INSTANCE prev;
+
+   // the previous instance
+   info->resume = 0;
+   input = fopen(info->previous,"r");
+   if (input == NULL)
+   {
+      error = (char*)calloc(instlen+strlen(info->previous),sizeof(char));
+      sprintf(error,"mdjeep: error: cannot open the previous instance file '%s' (option -incr)",info->previous);
+      return error;
+   };
+   error = readInstance(input,info->sep,info->format,&prev);
+   fclose(input);
+   if (error != NULL)  return error;
+
+   // the two instances need to have the same vertices
+   k = -1;
+   if (prev.n == inst->n && prev.n0 == inst->n0)
+   {
+      for (i = 0; i < inst->n; i++)  if (prev.v[i].Id != inst->v[i].Id)  break;
+      if (i == inst->n)  k = firstChangedLayer(inst->n,inst->v,prev.v);
+   };
+   freeInstance(&prev);
+   if (k == -1)  return strdup("mdjeep: error: the previous instance does not contain the same vertices (option -incr)");
+
+   // the previous solution
+   input = fopen(info->prevsol,"r");
+   if (input == NULL)
+   {
+      error = (char*)calloc(instlen+strlen(info->prevsol),sizeof(char));
+      sprintf(error,"mdjeep: error: cannot open the previous solution file '%s' (option -incr)",info->prevsol);
+      return error;
+   };
+   i = readPreviousSolution(input,inst,X);
+   fclose(input);
+   if (i != inst->n)
+   {
+      return strdup("mdjeep: error: the previous solution does not contain the coordinates of all vertices (option -incr)");
+   };
+
+   // first layer explored by bp (at least the last vertex is placed again when nothing changed)
+   if (k > inst->n - 1)  k = inst->n - 1;
+   if (k < 4)  k = 0;
+   if (info->method == 0)  info->resume = k;
+   return NULL;
+};
+
+// this function runs bp from the layer info->resume, with the previous vertices at their positions in X
+// -> the boxes of the kept vertices are the ones bp would have generated for the exact positions
+void resumeSearch(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION *info)
+{
+   int i,k;
+
+   k = info->resume;
+   startSearch(inst->n,S,info);
+   for (i = 0; i < k; i++)
+   {
+      S.path[i] = 0;
+      createBox(i,X,op.eps,S.lX,S.uX);
+      if (!info->exact)  expandBounds(i,inst->v,S.lX,S.uX,op.be,op.eps);
+   };
+   if (info->exact)
+      bp_exact(k,inst->n,inst->v,X,S,op,info);
+   else
+      bp(k,inst->n,inst->v,X,S,op,info);
+};
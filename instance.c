@@ -0,0 +1,331 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - instance functions
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version for reading, verifying and preparing the
+                                    instances independently from the main program (instances can be cached)
+                                    contiguous arrays of distances for evaluating the solutions (see newEdges)
+                                    bounds for the look-ahead pruning device (option -lookahead)
+                                    bound smoothing before computing the reference triplets (option -smooth)
+                                    repetition order when the consecutivity assumption is not satisfied (option -repeat)
+                                    coarse instance and subproblems of the hierarchical mode (option -hier)
+                                    blocks of vertices solved separately (option -blocks)
+                                    memory of the vertices and the distances counted (see memory.c)
+************************************************************************************************************/
+
+#include "bp.h"
+
+// maximum length for the error messages generated by the functions below
+size_t instlen = 256;
+
+// this function gives the memory of the vertices and the distances of an instance (see memory.c)
+long instanceMemory(int n,int m)
+{
+   return (long)n*sizeof(VERTEX) + (long)m*sizeof(REFERENCE);
+};
+
+// this function reads an instance (distance list) from an input file and stores it in an INSTANCE structure
+// -> the input needs to be a valid file pointer (it can also be a memory stream)
+// -> sep is the separator and format is the format of the distance list (see readMDfile)
+// -> the returning value is a NULL char on success;
+// -> it is otherwise a char pointer to a string describing the error (allocated for instlen characters)
+char* readInstance(FILE *input,char sep,unsigned long format,INSTANCE *inst)
+{
+   int n,n0,verr;
+   size_t nlines,linelen,wordlen;
+   char *line;
+   char *error;
+   unsigned long typelist;
+
+   // initializing the instance
+   inst->n = 0;  inst->n0 = 0;
+   inst->m = 0;  inst->mexact = 0;
+   inst->v = NULL;  inst->refs = NULL;  inst->sym = NULL;  inst->edges = NULL;
+   inst->ahead = NULL;  inst->bounds = NULL;  inst->tightened = 0;
+   inst->nrep = 0;  inst->vrep = NULL;  inst->rep = NULL;  inst->hier = NULL;  inst->blocks = NULL;
+   inst->exact = false;  inst->consec = false;  inst->smallsine = false;
+
+   // initial check
+   if (input == NULL)  return strdup("mdjeep: error: the pointer to the instance file is invalid");
+
+   // verifying the length of words and lines in the text file (for proper memory allocations)
+   nlines = textFileAnalysis(input,sep,&wordlen,&linelen);
+   if (nlines == 0 || wordlen == 0 || linelen == 0)
+   {
+      return strdup("mdjeep: error while reading instance file: the file seems to be empty");
+   };
+
+   // memory allocation for the array of chars containing the text file lines
+   line = (char*)calloc(linelen+1,sizeof(char));
+
+   // verifying whether the instance file is valid (all lines contain the same list of data types)
+   if (!isDistanceFileValid(input,sep,&typelist,linelen,line))
+   {
+      free(line);
+      return strdup("mdjeep: error while reading instance file: different lines contain different lists of data types");
+   };
+
+   // counting the number of vertices in the instance file
+   n = numberOfVerticesInFile(input,sep,format,&n0,linelen,line);
+   if (n == 0)
+   {
+      free(line);
+      return strdup("mdjeep: error while reading instance file: it looks like the instance file does not respect the specified format");
+   };
+
+   // memory allocation for the array of vertex structures
+   inst->v = (VERTEX*)calloc(n,sizeof(VERTEX));
+
+   // loading the instance file in memory
+   verr = readDistanceFile(input,sep,n,n0,inst->v,format,linelen,line);
+   free(line);
+   if (verr != -1)
+   {
+      error = (char*)calloc(instlen,sizeof(char));
+      if (verr == -2)
+         sprintf(error,"mdjeep: error while reading instance file: it looks like the file does not respect the specified format");
+      else if (verr == -3)
+         sprintf(error,"mdjeep: error while reading instance file: the presence of a distance from a vertex to itself was detected");
+      else if (verr == -4)
+         sprintf(error,"mdjeep: error while reading instance file: some vertex ranks in the interval [%d,%d] are missing",n0,n0+n);
+      else if (verr == -5)
+         sprintf(error,"mdjeep: error while reading instance file: some lower bounds are strictly greater than the corresponding upper bounds");
+      else
+         sprintf(error,"mdjeep: error while reading instance file: vertex with rank %d was found for the second time but with a different set of attributes",n0+verr);
+      inst->v = freeVertex(n,inst->v);
+      return error;
+   };
+
+   // counting the distances
+   inst->n = n;  inst->n0 = n0;  inst->nrep = n;
+   inst->m = totalNumberOfDistances(n,inst->v);
+   memoryUsage(0,instanceMemory(inst->n,inst->m));
+
+   // ending
+   return NULL;
+};
+
+// this function verifies whether the loaded instance can be solved with the method selected in INFORMATION
+// -> the instance attributes "mexact" and "exact" are computed (the latter only when bp is the selected method)
+// -> op and info are updated through the function setupInstance
+// -> the returning value is a NULL char on success, and a char pointer to the error description otherwise
+char* checkInstance(INSTANCE *inst,OPTION *op,INFORMATION *info)
+{
+   int i,n,m;
+   bool clique;
+   char *error;
+   VERTEX *v;
+
+   // instance size
+   n = inst->n;  m = inst->m;  v = inst->v;
+
+   // the k best solutions are only kept by bp (the arguments may have been read before the method was selected)
+   if (info->method != 0 && op->best > 0)
+   {
+      return strdup("mdjeep: error: -best flag only applies to bp method");
+   };
+
+   // verifying the number of distances
+   if (info->method == 0 && m < 3*(n - 2))
+   {
+      return strdup("mdjeep: error: not enough distances to perform discretization necessary to execute bp method");
+   };
+
+   // counting the number of exact distances
+   inst->mexact = totalNumberOfExactDistances(n,v,op->eps);
+   if (info->method == 0 && inst->mexact < 2*(n - 3) + 3)
+   {
+      return strdup("mdjeep: error: not enough exact distances to perform discretization necessary to execute bp method\n"
+                    "               a distance [lb,ub] is considered as exact if ub-lb < tolerance eps");
+   };
+
+   // verifying whether all distances are exact (and precise)
+   // (we'll invoke bp_exact if at least 90% of the distances are "very precise")
+   inst->exact = false;
+   if (m == inst->mexact && info->method == 0)
+   {
+      if (totalNumberOfPreciseDistances(n,v,14) > 0.90*inst->mexact)  inst->exact = true;
+   };
+   setupInstance(inst,op,info);
+
+   // error if no refinement method was specified for bp, and the instance does not contain enough precise distances
+   if (!info->exact && info->method == 0 && info->refinement == -1)
+   {
+      return strdup("mdjeep: error: no refinement method specified for bp (instance contains interval distances)");
+   };
+
+   // checking whether the first three instance vertices form a clique (prerequisite for bp)
+   if (info->method == 0)
+   {
+      clique = initialClique(n,v,op->eps);
+      if (!clique)
+      {
+         return strdup("mdjeep: error: the first three vertices of the input instance do not form a clique\n"
+                       "               the instance cannot be discretized");
+      };
+
+      // checking whether the input instance is discretizable (prerequisite for bp)
+      i = isDDGP(n,v,op->eps,clique);
+      if (i != 0)
+      {
+         error = (char*)calloc(instlen,sizeof(char));
+         sprintf(error,"mdjeep: error: the input instance is not discretizable\n"
+                       "               not enough references for vertex %d (should have at least 3, at least 2 exact)",inst->n0+i);
+         return error;
+      };
+   };
+
+   // all tests passed
+   return NULL;
+};
+
+// this function prepares a verified instance (see above) for the selected method
+// -> the bounds of the interval distances are first tightened when op.smooth is set (see smooth.c)
+// -> the consecutivity assumption is verified when all distances are exact, or when check_consec is true
+// -> when it is not satisfied by an instance with exact distances only, and op.repeat is set, some vertices
+//    are repeated in the vertex order so that it is satisfied (see repeat.c)
+// -> the triplets of reference vertices are computed when bp is the selected method
+// -> the symmetric layers are identified (even when the main method is spg)
+// -> the coarse instance and the subproblems are defined when op.hier is set (only for bp, see hier.c)
+// -> the instance is divided into blocks when op.blocks is set (see blocks.c)
+// -> the returning value is a NULL char on success, and a char pointer to the error description otherwise
+char* prepareInstance(INSTANCE *inst,OPTION op,INFORMATION *info,bool check_consec)
+{
+   int i,n;
+   double cosine;
+   VERTEX *v;
+
+   // instance size
+   n = inst->n;  v = inst->v;
+   freeRepetitionOrder(inst);
+   inst->hier = freeHierarchy(inst->hier);
+   inst->blocks = freeBlocks(inst->blocks);
+
+   // tightening the bounds of the interval distances (optional)
+   inst->tightened = 0;
+   if (op.smooth)  inst->tightened = smoothBounds(inst,op.eps);
+
+   // checking the consecutivity assumption (optional)
+   inst->consec = false;
+   if (info->method == 0)
+   {
+      if (info->exact || check_consec)  inst->consec = isDMDGP(n,v,op.eps,true);
+   };
+   info->consec = inst->consec;
+
+   // preparing for calling bp method
+   inst->smallsine = false;
+   if (info->method == 0)
+   {
+      // memory allocation for the triplets
+      inst->refs = (triplet*)calloc(n,sizeof(triplet));
+
+      // initializing all reference triplets to null
+      for (i = 0; i < n; i++)  inst->refs[i] = nullTriplet();
+
+      // the definition of the reference vertices depends on the presence of interval distances
+      // for instances with exact distances only: the code below only verifies that the flattest triplet is not "too flat"
+      for (i = 3; i < n; i++)
+      {
+         if (info->exact || onlyPreciseDistances(v[i].ref,14))
+         {
+            // triplet of references with exact distances
+            cosine = 0.0;
+            inst->refs[i] = findReferencesExactCase(i,v,op.eps,&cosine);
+            if (isNullTriplet(inst->refs[i]))
+            {
+               free(inst->refs);  inst->refs = NULL;
+               return strdup("mdjeep: internal error: it was verified that the discretization assumptions were satisfied but they are actually not");
+            };
+            if (cosine == 0.0)
+            {
+               free(inst->refs);  inst->refs = NULL;
+               return strdup("mdjeep: error: one triplet of reference vertices forms a flat angle; no alternative triplet available");
+            };
+            if (fabs(sqrt(1.0 - cosine*cosine)) < op.eps)  inst->smallsine = true;
+         }
+         else
+         {
+            // triplet of references with one interval distance
+            inst->refs[i] = findReferencesIntervalCase(i,v,op.eps);
+            if (isNullTriplet(inst->refs[i]))
+            {
+               free(inst->refs);  inst->refs = NULL;
+               return strdup("mdjeep: internal error: it was verified that the discretization assumptions were satisfied but they are actually not");
+            };
+         };
+      };
+   };
+
+   // repetition order (optional, only for bp_exact): the layers of the tree are the positions in the order
+   if (info->method == 0 && info->exact && !inst->consec && op.repeat)
+   {
+      if (repeatVertices(inst) > 0)
+      {
+         n = inst->nrep;  v = inst->vrep;
+         if (!isRepetitionDMDGP(n,v,inst->rep,op.eps))
+         {
+            freeRepetitionOrder(inst);
+            return strdup("mdjeep: internal error: the repetition order does not satisfy the consecutivity assumption");
+         };
+         inst->consec = true;  // the consecutive references are used by bp_exact (see repeat.c)
+      };
+   };
+
+   // looking for symmetries
+   inst->sym = (bool*)calloc(n,sizeof(bool));
+   findSymmetries(n,v,inst->sym);
+   if (inst->rep != NULL)  findRepetitionSymmetries(n,inst->rep,inst->sym);
+
+   // distances in contiguous arrays (for evaluating the solutions)
+   inst->edges = newEdges(n,v,op.eps);
+   inst->edges->nv = inst->n;
+
+   // bounds implied by the next vertices (optional, only for bp: with interval distances, they are verified on the
+   // boxes of the vertices, see bp)
+   inst->ahead = NULL;
+   if (info->method == 0 && op.lookahead > 0)  inst->ahead = newLookAhead(n,inst->edges,op.lookahead);
+
+   // backbone first, then the other vertices of every group (optional, only for bp)
+   if (info->method == 0 && op.hier)  return newHierarchy(inst,op,info);
+
+   // blocks of vertices solved separately (optional)
+   if (op.blocks > 0)  return newBlocks(inst,op,info);
+
+   // ending
+   return NULL;
+};
+
+// this function transfers the instance properties to the OPTION and INFORMATION structures
+// -> it needs to be invoked every time a prepared instance is solved with a new set of options
+void setupInstance(INSTANCE *inst,OPTION *op,INFORMATION *info)
+{
+   info->exact = false;
+   if (info->method == 0 && inst->exact)
+   {
+      // the resolution parameter and the refinement method are disabled
+      op->r = 0.0;
+      info->exact = true;
+   };
+   info->consec = inst->consec;
+};
+
+// this function frees the memory allocated for an INSTANCE structure
+void freeInstance(INSTANCE *inst)
+{
+   if (inst->refs != NULL)  free(inst->refs);
+   if (inst->sym != NULL)  free(inst->sym);
+   inst->edges = freeEdges(inst->edges);
+   inst->ahead = freeLookAhead(inst->ahead);
+   if (inst->bounds != NULL)  freeVector(inst->bounds);
+   inst->bounds = NULL;  inst->tightened = 0;
+   freeRepetitionOrder(inst);
+   inst->hier = freeHierarchy(inst->hier);
+   inst->blocks = freeBlocks(inst->blocks);
+   if (inst->v != NULL)  memoryUsage(0,-instanceMemory(inst->n,inst->m));
+   if (inst->v != NULL)  freeVertex(inst->n,inst->v);
+   inst->refs = NULL;  inst->sym = NULL;  inst->v = NULL;
+   inst->n = 0;  inst->m = 0;  inst->nrep = 0;
+};
@@ -0,0 +1,256 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - L-BFGS-B
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (refinement and main method 'lbfgsb')
+************************************************************************************************************/
+
+#include "bp.h"
+
+extern int K;
+
+// the stress function (see objfun.c) is minimized over the same variables and the same box constraints used by spg
+// (the coordinates in X within the boxes S.lX and S.uX, the distances y within the distance bounds), with a limited
+// memory quasi-Newton method for bound constrained problems: at every iteration, the variables lying on a bound
+// where the gradient points outside the box are fixed, the L-BFGS direction is computed on the other variables
+// (two-loop recursion over the last lmemory pairs of steps and gradient differences), and a backtracking line search
+// is performed along the projection of the direction on the box
+// -> differently from the original L-BFGS-B, the active set is not identified by the generalized Cauchy point, but
+//    with the sign of the gradient on the bounds (projected L-BFGS)
+// -> all variables are stored in one vector: the K coordinates of the n vertices (by coordinate), followed by the
+//    m distances (in the order of the references of the vertices)
+
+// number of pairs kept in memory for the approximation of the inverse of the Hessian
+int lmemory = 5;
+
+// this function copies the variables (X,y) in one vector x (the coordinates first, then the distances)
+void packVariables(int n,double **X,int m,double *y,double *x)
+{
+   int i,j,k;
+
+   for (k = 0; k < K; k++)  for (i = 0; i < n; i++)  x[k*n+i] = X[k][i];
+   for (j = 0; j < m; j++)  x[K*n+j] = y[j];
+};
+
+// this function copies the vector x in the variables (X,y) (see packVariables)
+void unpackVariables(int n,double *x,int m,double **X,double *y)
+{
+   int i,j,k;
+
+   for (k = 0; k < K; k++)  for (i = 0; i < n; i++)  X[k][i] = x[k*n+i];
+   for (j = 0; j < m; j++)  y[j] = x[K*n+j];
+};
+
+// L-BFGS-B (projected limited memory BFGS)
+//
+//           input: the DGP instance (n,v), and the starting point X (the boxes are in S.lX and S.uX)
+//          output: the found solution replaces the starting point in X
+//                  the stress function value in the found solution (obj, pointer)
+//                  the number of iterations (it, pointer)
+// returning value: the flag indicating the termination status (0 = normal,
+//                                                              1 = projected gradient norm too small,
+//                                                              2 = max number of iterations)
+// The memory for the vector of the variables and for the pairs kept by the method is allocated at every call
+// (the one for y and for the gradient is in the workspace of SEARCH, see useWorkspace).
+int lbfgsb(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj)
+{
+   int i,j,k,h,N;
+   int m,nh,last;
+   int it,maxIt;
+   int ldigits;
+   short flag = 0;
+   REFERENCE *ref;
+   double objval,newobjval;
+   double alpha,beta,scale,gd,sy,yy,pg;
+   double *x,*g,*l,*u,*d,*xp,*gp;
+   double *hs,*hy,*rho,*a;
+   double *memory;
+   bool *fixed;
+   WORKSPACE *W = S.work;
+
+   // if lbfgsb is refinement method, max number of iterations depends on the problem size
+   if (info->refinement == 2)
+      maxIt = 50 + 10*n;
+   else
+      maxIt = op.maxit;
+
+   // number of distances
+   m = 0;
+   for (i = 0; i < n; i++)  m = m + numberOfDistances(v[i].ref);
+   N = K*n + m;
+
+   // memory allocation
+   useWorkspace(W,2);
+   memory = allocateVector((size_t)(7 + 2*lmemory)*N + 2*lmemory);
+   memoryUsage(1,vectorMemory((size_t)(7 + 2*lmemory)*N + 2*lmemory) + N*sizeof(bool));
+   x = memory;  g = x + N;  l = g + N;  u = l + N;  d = u + N;  xp = d + N;  gp = xp + N;
+   hs = gp + N;  hy = hs + lmemory*N;  rho = hy + lmemory*N;  a = rho + lmemory;
+   fixed = (bool*)calloc(N,sizeof(bool));
+
+   // bounds on the variables, and initial y variables
+   for (k = 0; k < K; k++)
+   {
+      for (i = 0; i < n; i++)
+      {
+         l[k*n+i] = S.lX[k][i];
+         u[k*n+i] = S.uX[k][i];
+      };
+   };
+   h = 0;
+   for (i = 0; i < n; i++)
+   {
+      ref = v[i].ref;
+      while (ref != NULL)
+      {
+         l[K*n+h] = lowerBound(ref);
+         u[K*n+h] = upperBound(ref);
+         W->y[h] = projection(distance(otherVertexId(ref),i,X),l[K*n+h],u[K*n+h],0.0);
+         ref = ref->next;
+         h++;
+      };
+   };
+   packVariables(n,X,m,W->y,x);
+   for (h = 0; h < K*n; h++)  x[h] = projection(x[h],l[h],u[h],0.0);
+   unpackVariables(n,x,m,X,W->y);
+
+   // computing initial objective function and gradient values
+   objval = compute_stress(n,v,X,W->y);
+   info->nstress++;
+   stress_gradient(n,v,X,W->y,W->gX,W->gy,W->memory);
+   packVariables(n,W->gX,m,W->gy,g);
+
+   // running the quasi-Newton method
+   it = 1;  nh = 0;  last = -1;
+   while (maxIt > it && objval > op.epsobj)
+   {
+      // monitor
+      if (info->method == 2 && op.monitor)
+      {
+         ldigits = numberOfDigits(it);
+         for (k = 0; k < info->ndigits + 9; k++)  fprintf(stderr,"\b");
+         for (k = 0; k < info->ndigits - ldigits; k++)  fprintf(stderr," ");
+         fprintf(stderr,"%d %8.2le",it,objval);
+      };
+
+      // projected gradient, and variables fixed on their bounds
+      pg = 0.0;
+      for (h = 0; h < N; h++)
+      {
+         alpha = projection(x[h] - g[h],l[h],u[h],0.0) - x[h];
+         pg = pg + alpha*alpha;
+         fixed[h] = (x[h] <= l[h] && g[h] > 0.0) || (x[h] >= u[h] && g[h] < 0.0);
+      };
+      if (sqrt(pg) < op.epsg)
+      {
+         flag = 1;
+         break;
+      };
+
+      // L-BFGS direction on the free variables (two-loop recursion, from the last pair to the first one)
+      for (h = 0; h < N; h++)  d[h] = fixed[h] ? 0.0 : -g[h];
+      for (j = 0; j < nh; j++)
+      {
+         k = (last - j + lmemory) % lmemory;
+         alpha = 0.0;
+         for (h = 0; h < N; h++)  if (!fixed[h])  alpha = alpha + hs[k*N+h]*d[h];
+         a[k] = rho[k]*alpha;
+         for (h = 0; h < N; h++)  if (!fixed[h])  d[h] = d[h] - a[k]*hy[k*N+h];
+      };
+      if (nh > 0)
+      {
+         scale = 1.0/(rho[last]*dotProdVector(N,hy+last*N,hy+last*N));
+         for (h = 0; h < N; h++)  d[h] = scale*d[h];
+      };
+      for (j = nh - 1; j >= 0; j--)
+      {
+         k = (last - j + lmemory) % lmemory;
+         beta = 0.0;
+         for (h = 0; h < N; h++)  if (!fixed[h])  beta = beta + hy[k*N+h]*d[h];
+         beta = rho[k]*beta;
+         for (h = 0; h < N; h++)  if (!fixed[h])  d[h] = d[h] + (a[k] - beta)*hs[k*N+h];
+      };
+
+      // the pairs are removed when the direction is not a descent direction
+      gd = dotProdVector(N,g,d);
+      if (gd >= 0.0)
+      {
+         nh = 0;  last = -1;
+         for (h = 0; h < N; h++)  d[h] = fixed[h] ? 0.0 : -g[h];
+         gd = dotProdVector(N,g,d);
+      };
+
+      // backtracking line search along the projected direction
+      // (the first step is scaled to the unit length when no pairs are available)
+      copyVector(N,x,xp);  copyVector(N,g,gp);
+      alpha = 1.0;
+      if (nh == 0 && gd < 0.0)  alpha = 1.0/sqrt(-gd);
+      if (alpha > 1.0)  alpha = 1.0;
+      do
+      {
+         for (h = 0; h < N; h++)  x[h] = projection(xp[h] + alpha*d[h],l[h],u[h],0.0);
+         gd = 0.0;
+         for (h = 0; h < N; h++)  gd = gd + gp[h]*(x[h] - xp[h]);
+         unpackVariables(n,x,m,X,W->y);
+         newobjval = compute_stress(n,v,X,W->y);
+         info->nstress++;
+         alpha = 0.5*alpha;
+      }
+      while (alpha > op.epsalpha && (gd >= 0.0 || newobjval > objval + op.gam*gd));
+
+      // the line search failed: the previous point is kept
+      if (gd >= 0.0 || newobjval > objval + op.gam*gd)
+      {
+         copyVector(N,xp,x);
+         unpackVariables(n,x,m,X,W->y);
+         break;
+      };
+
+      // gradient in the new point
+      objval = newobjval;
+      stress_gradient(n,v,X,W->y,W->gX,W->gy,W->memory);
+      packVariables(n,W->gX,m,W->gy,g);
+
+      // new pair, replacing the oldest one (only when the curvature condition is satisfied)
+      sy = 0.0;  yy = 0.0;
+      for (h = 0; h < N; h++)
+      {
+         sy = sy + (x[h] - xp[h])*(g[h] - gp[h]);
+         yy = yy + (g[h] - gp[h])*(g[h] - gp[h]);
+      };
+      if (sy > 1.e-10*yy && yy > 0.0)
+      {
+         last = (last + 1) % lmemory;
+         for (h = 0; h < N; h++)
+         {
+            hs[last*N+h] = x[h] - xp[h];
+            hy[last*N+h] = g[h] - gp[h];
+         };
+         rho[last] = 1.0/sy;
+         if (nh < lmemory)  nh++;
+      };
+
+      it++;
+   };
+
+   // printing (optional)
+   if (info->method == 2)
+   {
+      if (op.print > 0)
+      {
+         printSolution(n,v,X,op,info,0);
+      };
+   };
+
+   // updating output info
+   *its = it;
+   *obj = objval;
+   if (it == maxIt)  flag = 2;
+
+   // freeing memory
+   memoryUsage(1,-vectorMemory((size_t)(7 + 2*lmemory)*N + 2*lmemory) - N*sizeof(bool));
+   free(fixed);
+   freeVector(memory);
+   return flag;
+};
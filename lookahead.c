@@ -0,0 +1,212 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - look-ahead bounds
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (option -lookahead)
+                                    the implied bounds are also verified by bp, on the boxes of the vertices
+************************************************************************************************************/
+
+#include "bp.h"
+
+extern double INFTY;
+
+// when vertex i is placed, its distances to the vertices placed later are not verified by DDF; however, a vertex f
+// placed later and having distances to both i and a previous vertex a implies, through the triangle inequality,
+// bounds on the distance between i and a:
+//     d(i,a) <= U(i,f) + ub(f,a)     and     d(i,a) >= max( lb(f,a) - U(i,f) , lb(i,f) - ub(f,a) )
+// where U(i,f) is an upper bound on d(i,f): the upper bound of the distance (i,f), or the length of a path from
+// i to f through other vertices placed later (with at most "hops" distances); these implied bounds only depend
+// on the instance, and are computed once for every vertex (see LookAheadDDF in pruningtest.c)
+// -> when the instance contains interval distances, the previous vertices may still be moved by the refinement
+//    method: bp verifies the implied bounds on the distances between the boxes of the vertices (see BoxLookAheadDDF),
+//    which are often too large for a bound to be violated
+
+// this function computes the implied bounds for all vertices of an instance with n vertices
+// -> e contains the distances of the instance (see newEdges), hops is the maximum number of distances in the paths
+LOOKAHEAD* newLookAhead(int n,EDGES *e,int hops)
+{
+   int i,j,k,h,a,f,x,r;
+   int nreached,nfront,nnext,npairs,capacity;
+   int *deg,*adj,*astart,*mark,*stamp,*reached,*front,*next,*pairs,*tmp;
+   double c,lo,hi;
+   double *alb,*aub,*U,*L,*Lo,*Hi;
+   LOOKAHEAD *la;
+
+   // symmetric lists of neighbors
+   deg = (int*)calloc(n+1,sizeof(int));
+   for (i = 0; i < n; i++)
+   {
+      for (h = e->start[i]; h < e->start[i+1]; h++)
+      {
+         deg[i]++;
+         deg[e->other[h]]++;
+      };
+   };
+   astart = (int*)calloc(n+1,sizeof(int));
+   for (i = 0; i < n; i++)  astart[i+1] = astart[i] + deg[i];
+   adj = (int*)calloc(astart[n] > 0 ? astart[n] : 1,sizeof(int));
+   alb = allocateVector(astart[n] > 0 ? astart[n] : 1);
+   aub = allocateVector(astart[n] > 0 ? astart[n] : 1);
+   for (i = 0; i < n; i++)  deg[i] = astart[i];
+   for (i = 0; i < n; i++)
+   {
+      for (h = e->start[i]; h < e->start[i+1]; h++)
+      {
+         j = e->other[h];
+         adj[deg[i]] = j;  alb[deg[i]] = e->lb[h];  aub[deg[i]] = e->ub[h];  deg[i]++;
+         adj[deg[j]] = i;  alb[deg[j]] = e->lb[h];  aub[deg[j]] = e->ub[h];  deg[j]++;
+      };
+   };
+   free(deg);
+
+   // memory
+   U = allocateVector(n);  L = allocateVector(n);
+   Lo = allocateVector(n);  Hi = allocateVector(n);
+   for (i = 0; i < n; i++)  U[i] = INFTY;
+   for (i = 0; i < n; i++)  L[i] = 0.0;
+   mark = (int*)calloc(n,sizeof(int));
+   stamp = (int*)calloc(n,sizeof(int));
+   for (i = 0; i < n; i++)  mark[i] = -1;
+   for (i = 0; i < n; i++)  stamp[i] = -1;
+   reached = (int*)calloc(n,sizeof(int));
+   front = (int*)calloc(n,sizeof(int));
+   next = (int*)calloc(n,sizeof(int));
+   pairs = (int*)calloc(n,sizeof(int));
+   la = (LOOKAHEAD*)calloc(1,sizeof(LOOKAHEAD));
+   la->n = n;
+   la->m = 0;
+   la->start = (int*)calloc(n+1,sizeof(int));
+   capacity = 1024;
+   la->other = (int*)calloc(capacity,sizeof(int));
+   la->lb = allocateVector(capacity);
+   la->ub = allocateVector(capacity);
+
+   // the first three vertices are fixed (no branching)
+   for (i = 0; i < n; i++)
+   {
+      la->start[i] = la->m;
+      if (i < 3)  continue;
+
+      // upper bounds on the distances from i to the vertices placed later
+      U[i] = 0.0;
+      nreached = 0;  nfront = 1;  front[0] = i;
+      for (r = 0; r < hops && nfront > 0; r++)
+      {
+         nnext = 0;
+         for (k = 0; k < nfront; k++)
+         {
+            x = front[k];
+            for (h = astart[x]; h < astart[x+1]; h++)
+            {
+               f = adj[h];
+               if (f <= i)  continue;
+               if (r == 0)  L[f] = alb[h];
+               c = U[x] + aub[h];
+               if (c < U[f])
+               {
+                  if (U[f] == INFTY)  reached[nreached++] = f;
+                  U[f] = c;
+                  if (stamp[f] != r)
+                  {
+                     stamp[f] = r;
+                     next[nnext++] = f;
+                  };
+               };
+            };
+         };
+         tmp = front;  front = next;  next = tmp;
+         nfront = nnext;
+      };
+
+      // implied bounds on the distances between i and the previous vertices
+      npairs = 0;
+      for (k = 0; k < nreached; k++)
+      {
+         f = reached[k];
+         for (h = astart[f]; h < astart[f+1]; h++)
+         {
+            a = adj[h];
+            if (a >= i)  continue;
+            hi = U[f] + aub[h];
+            lo = alb[h] - U[f];
+            if (L[f] - aub[h] > lo)  lo = L[f] - aub[h];
+            if (lo < 0.0)  lo = 0.0;
+            if (mark[a] != i)
+            {
+               mark[a] = i;
+               pairs[npairs++] = a;
+               Lo[a] = lo;  Hi[a] = hi;
+            }
+            else
+            {
+               if (lo > Lo[a])  Lo[a] = lo;
+               if (hi < Hi[a])  Hi[a] = hi;
+            };
+         };
+      };
+
+      // the distances between i and the previous vertices are already verified by DDF:
+      // the implied bounds are kept only when they are tighter
+      for (h = e->start[i]; h < e->start[i+1]; h++)
+      {
+         a = e->other[h];
+         if (mark[a] == i)  if (Lo[a] <= e->lb[h] && Hi[a] >= e->ub[h])  mark[a] = -1;
+      };
+
+      // storing the implied bounds
+      for (k = 0; k < npairs; k++)
+      {
+         a = pairs[k];
+         if (mark[a] != i)  continue;
+         if (la->m == capacity)
+         {
+            capacity = 2*capacity;
+            la->other = (int*)realloc(la->other,capacity*sizeof(int));
+            la->lb = (double*)realloc(la->lb,capacity*sizeof(double));
+            la->ub = (double*)realloc(la->ub,capacity*sizeof(double));
+         };
+         la->other[la->m] = a;
+         la->lb[la->m] = Lo[a];
+         la->ub[la->m] = Hi[a];
+         la->m++;
+      };
+
+      // cleaning
+      U[i] = INFTY;
+      for (k = 0; k < nreached; k++)
+      {
+         U[reached[k]] = INFTY;
+         L[reached[k]] = 0.0;
+         stamp[reached[k]] = -1;
+      };
+   };
+   la->start[n] = la->m;
+
+   // freeing memory
+   free(pairs);  free(next);  free(front);  free(reached);
+   free(stamp);  free(mark);
+   freeVector(Hi);  freeVector(Lo);  freeVector(L);  freeVector(U);
+   freeVector(aub);  freeVector(alb);
+   free(adj);  free(astart);
+   memoryUsage(0,lookAheadMemory(la));
+   return la;
+};
+
+// this function gives the memory of the LOOKAHEAD structure (see memory.c)
+long lookAheadMemory(LOOKAHEAD *la)
+{
+   return sizeof(LOOKAHEAD) + (long)(la->n + 1 + la->m)*sizeof(int) + 2*(long)la->m*sizeof(double);
+};
+
+// this function frees the LOOKAHEAD structure
+LOOKAHEAD* freeLookAhead(LOOKAHEAD *la)
+{
+   if (la == NULL)  return NULL;
+   memoryUsage(0,-lookAheadMemory(la));
+   free(la->start);  free(la->other);
+   freeVector(la->lb);  freeVector(la->ub);
+   free(la);
+   return NULL;
+};
@@ -9,14 +9,37 @@
               Jun 28 2019  v.0.3.0  adding functions for vector and matrix manipulation
               Mar 21 2020  v.0.3.1  adding functions areSameVector and areSameMatrix (for tests)
               May 19 2020  v.0.3.2  no changes
+              Oct 18 2026  v.0.3.3  adding function dotProdVector (see lbfgsb.c)
+                                    adding function symmetricEigen (see start.c)
+                                    vectors and matrices in aligned contiguous memory
+                                    vectors and matrices of single precision values (see spg.c)
 **************************************************************************************************/ 
 
 #include "bp.h"
 
+// the vectors, and the rows of the matrices, start at addresses which are multiple of valign bytes, and their
+// length is rounded up to a multiple of valign bytes (the loops over their elements can then be vectorized)
+// -> all rows of a matrix are in one block of memory: the row pointers only point inside the block
+size_t valign = 64;
+
+// this function allocates aligned memory for n doubles, initialized to zero (it can be freed with free)
+double* alignedBlock(size_t n)
+{
+   size_t size;
+   void *block;
+
+   size = n*sizeof(double);
+   size = (size + valign - 1)/valign*valign;
+   if (size == 0)  size = valign;
+   if (posix_memalign(&block,valign,size) != 0)  return NULL;
+   memset(block,0,size);
+   return (double*)block;
+};
+
 // this function allocates memory for a vector (1-dim array of double)
 double* allocateVector(size_t n)
 {
-   return (double*) calloc(n,sizeof(double));
+   return alignedBlock(n);
 };
 
 // this function copies a vector into another
@@ -42,6 +65,15 @@ double normVector(size_t n,double *v)
    return sqrt(sqnorm);
 };
 
+// this function computes the scalar product between two vectors of the same length
+double dotProdVector(size_t n,double *v1,double *v2)
+{
+   int i;
+   double prod = 0.0;
+   for (i = 0; i < n; i++)  prod = prod + v1[i]*v2[i];
+   return prod;
+};
+
 // this function verifies whether two vectors contain the same sequence of values
 bool areSameVector(size_t n,double *v1,double *v2)
 {
@@ -79,11 +111,35 @@ double* freeVector(double *v)
 };
 
 // this function allocates memory for a matrix (2D array of double)
+// -> the n rows of length m are consecutive in the same block (the row length is padded, see valign)
 double** allocateMatrix(size_t n,size_t m)
 {
-   int i;
-   double **A = (double**)calloc(n,sizeof(double));
-   for (i = 0; i < n; i++)  A[i] = (double*)calloc(m,sizeof(double));
+   size_t i,stride;
+   double **A;
+
+   stride = (m*sizeof(double) + valign - 1)/valign*valign/sizeof(double);
+   A = (double**)calloc(n > 0 ? n : 1,sizeof(double*));
+   A[0] = alignedBlock(n*stride);
+   for (i = 1; i < n; i++)  A[i] = A[0] + i*stride;
+   return A;
+};
+
+// this function allocates memory for a vector of single precision values (aligned as the vectors of double)
+float* allocateFloatVector(size_t n)
+{
+   return (float*)alignedBlock((n + 1)/2);
+};
+
+// this function allocates memory for a matrix of single precision values (organized as in allocateMatrix)
+float** allocateFloatMatrix(size_t n,size_t m)
+{
+   size_t i,stride;
+   float **A;
+
+   stride = (m*sizeof(float) + valign - 1)/valign*valign/sizeof(float);
+   A = (float**)calloc(n > 0 ? n : 1,sizeof(float*));
+   A[0] = (float*)alignedBlock((n*stride + 1)/2);
+   for (i = 1; i < n; i++)  A[i] = A[0] + i*stride;
    return A;
 };
 
@@ -186,11 +242,80 @@ void printMatrix(size_t n,size_t m,double **a)
    };
 };
 
-// this function frees a matrix
+// this function computes the eigenvalues and the eigenvectors of the symmetric n x n matrix A (cyclic Jacobi method)
+// -> A is destroyed, its diagonal contains the eigenvalues at the end
+// -> the eigenvectors are the columns of V (pre-allocated n x n matrix)
+void symmetricEigen(int n,double **A,double **V)
+{
+   int i,j,k,sweep;
+   double off,total,theta,t,c,s,tau,h,g;
+
+   total = 0.0;
+   for (i = 0; i < n; i++)
+   {
+      for (j = 0; j < n; j++)
+      {
+         V[i][j] = (i == j) ? 1.0 : 0.0;
+         total = total + fabs(A[i][j]);
+      };
+   };
+   for (sweep = 0; sweep < 50; sweep++)
+   {
+      off = 0.0;
+      for (i = 0; i < n - 1; i++)  for (j = i + 1; j < n; j++)  off = off + fabs(A[i][j]);
+      if (off <= 1.e-15*total)  break;
+      for (i = 0; i < n - 1; i++)
+      {
+         for (j = i + 1; j < n; j++)
+         {
+            if (fabs(A[i][j]) < 1.e-300)  continue;
+            theta = 0.5*(A[j][j] - A[i][i])/A[i][j];
+            t = 1.0/(fabs(theta) + sqrt(1.0 + theta*theta));
+            if (theta < 0.0)  t = -t;
+            c = 1.0/sqrt(1.0 + t*t);  s = t*c;
+            tau = s/(1.0 + c);
+            h = t*A[i][j];
+            A[i][i] = A[i][i] - h;  A[j][j] = A[j][j] + h;
+            A[i][j] = 0.0;  A[j][i] = 0.0;
+            for (k = 0; k < n; k++)
+            {
+               if (k == i || k == j)  continue;
+               g = A[k][i];  h = A[k][j];
+               A[k][i] = g - s*(h + g*tau);  A[i][k] = A[k][i];
+               A[k][j] = h + s*(g - h*tau);  A[j][k] = A[k][j];
+            };
+            for (k = 0; k < n; k++)
+            {
+               g = V[k][i];  h = V[k][j];
+               V[k][i] = g - s*(h + g*tau);
+               V[k][j] = h + s*(g - h*tau);
+            };
+         };
+      };
+   };
+};
+
+// this function frees a matrix (allocated with allocateMatrix)
 double** freeMatrix(size_t n,double **a)
 {
-   int i;
-   for (i = 0; i < n; i++)  free(a[i]);
+   if (a == NULL)  return NULL;
+   free(a[0]);
+   free(a);
+   return NULL;
+};
+
+// this function frees a vector of single precision values
+float* freeFloatVector(float *v)
+{
+   free(v);
+   return NULL;
+};
+
+// this function frees a matrix of single precision values (allocated with allocateFloatMatrix)
+float** freeFloatMatrix(size_t n,float **a)
+{
+   if (a == NULL)  return NULL;
+   free(a[0]);
    free(a);
    return NULL;
 };
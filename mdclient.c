@@ -0,0 +1,164 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - client for the solver daemon
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version
+************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// client usage
+void mdclient_usage(void)
+{
+   fprintf(stderr,"mdclient: too few arguments\n");
+   fprintf(stderr,"        syntax: ./mdclient socket [options] MDfile.mdf [instance ...]\n");
+   fprintf(stderr,"                ./mdclient socket -shutdown\n");
+   fprintf(stderr," The options are the mdjeep options (e.g. -1, -l, -sym, -consec) and are sent to the solver.\n");
+   fprintf(stderr," One job is submitted for every given instance file (the instance in the MDfile is used if none);\n");
+   fprintf(stderr," when the instance is '-', the distance list is read from the standard input and sent inline.\n");
+   fprintf(stderr," The replies of the solver (started with mdjeep --serve socket) are written on the standard output.\n");
+};
+
+// sending one job to the solver and writing its reply on the standard output
+// -> the returning value is true if the solver successfully processed the job
+bool mdclient_job(FILE *in,FILE *out,int nopt,char *opt[],char *mdfile,char *instance)
+{
+   int i;
+   bool ok;
+   size_t len,tlen,tsize;
+   ssize_t nread;
+   char *line,*text,*cwd;
+
+   // working directory, MDfile and instance
+   cwd = getcwd(NULL,0);
+   if (cwd != NULL)  fprintf(out,"directory: %s\n",cwd);
+   free(cwd);
+   fprintf(out,"mdfile: %s\n",mdfile);
+   if (instance != NULL && strcmp(instance,"-"))  fprintf(out,"instance: %s\n",instance);
+
+   // options
+   if (nopt > 0)
+   {
+      fprintf(out,"option:");
+      for (i = 0; i < nopt; i++)  fprintf(out," %s",opt[i]);
+      fprintf(out,"\n");
+   };
+
+   // inline distance list
+   line = NULL;  len = 0;
+   if (instance != NULL && !strcmp(instance,"-"))
+   {
+      text = NULL;  tlen = 0;  tsize = 0;
+      i = 0;
+      while ((nread = getline(&line,&len,stdin)) > 0)
+      {
+         if (tlen + nread + 2 > tsize)
+         {
+            tsize = 2*(tlen + nread + 2);
+            text = (char*)realloc(text,tsize);
+         };
+         memcpy(text+tlen,line,nread);
+         tlen = tlen + nread;
+         if (text[tlen-1] != '\n')  text[tlen++] = '\n';
+         i++;
+      };
+      fprintf(out,"distances: %d\n",i);
+      if (tlen > 0)  fwrite(text,1,tlen,out);
+      free(text);
+   };
+   fprintf(out,"end\n");
+   fflush(out);
+
+   // reading the reply
+   ok = false;
+   while ((nread = getline(&line,&len,in)) > 0)
+   {
+      fputs(line,stdout);
+      if (!strncmp(line,"status: ok",10))  ok = true;
+      if (!strcmp(line,"end\n"))  break;
+   };
+   free(line);
+   return ok;
+};
+
+// main program of the client
+int main(int argc,char *argv[])
+{
+   int i,k,fd;
+   int nopt;
+   bool ok;
+   char *mdfile;
+   size_t l;
+   struct sockaddr_un address;
+   FILE *in,*out;
+
+   // checking input arguments
+   if (argc < 3)
+   {
+      mdclient_usage();
+      return 1;
+   };
+
+   // connecting to the solver
+   fd = socket(AF_UNIX,SOCK_STREAM,0);
+   if (fd < 0 || strlen(argv[1]) >= sizeof(address.sun_path))
+   {
+      fprintf(stderr,"mdclient: error: impossible to create the socket\n");
+      return 1;
+   };
+   memset(&address,0,sizeof(address));
+   address.sun_family = AF_UNIX;
+   strcpy(address.sun_path,argv[1]);
+   if (connect(fd,(struct sockaddr*)&address,sizeof(address)) < 0)
+   {
+      fprintf(stderr,"mdclient: error: impossible to connect to the solver on socket '%s'\n",argv[1]);
+      close(fd);
+      return 1;
+   };
+   in = fdopen(fd,"r");
+   out = fdopen(dup(fd),"w");
+
+   // stopping the solver
+   if (!strcmp(argv[2],"-shutdown"))
+   {
+      fprintf(out,"shutdown\n");
+      fclose(out);  fclose(in);
+      return 0;
+   };
+
+   // the options are all arguments preceding the MDfile (identified by its extension)
+   k = 2;  mdfile = NULL;
+   while (k < argc && mdfile == NULL)
+   {
+      l = strlen(argv[k]);
+      if (l > 4 && !strcmp(argv[k]+l-4,".mdf"))  mdfile = argv[k];
+      k++;
+   };
+   if (mdfile == NULL)
+   {
+      fprintf(stderr,"mdclient: error: no MDfile (with mdf extension) in the list of arguments\n");
+      fclose(out);  fclose(in);
+      return 1;
+   };
+   nopt = k - 3;
+
+   // submitting the jobs (one per instance)
+   ok = true;
+   if (k == argc)
+      ok = mdclient_job(in,out,nopt,argv+2,mdfile,NULL);
+   else
+      for (i = k; i < argc; i++)  ok = mdclient_job(in,out,nopt,argv+2,mdfile,argv[i]) && ok;
+
+   // ending
+   fclose(out);  fclose(in);
+   return ok ? 0 : 1;
+};
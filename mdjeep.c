@@ -0,0 +1,877 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - library interface
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (libmdjeep, see mdjeep.h)
+                                    resumable solution iterator (mdjeep_next_solution)
+                                    pool of solutions stored as paths, rebuilt on demand (mdjeep_rebuild)
+                                    output file name also set for options -best and -cluster
+                                    number of clusters in the statistics
+                                    the distance arrays of the instance are rebuilt when it is prepared again
+                                    the look-ahead bounds are rebuilt when the instance is prepared again
+                                    the original distance bounds are restored before preparing the instance again
+                                    the search tree may have more layers than vertices (repetition orders)
+                                    previous solution loaded at every run in the incremental mode (option -incr)
+                                    memory counted (see memory.c)
+                                    attribute precision (spg in single precision, with a polish in double precision)
+                                    the interruption flag (^C) is cleared before every run
+************************************************************************************************************/
+
+#include "bp.h"
+#include <limits.h>
+
+double INFTY = 1.e+30;
+extern size_t instlen;
+extern __thread bool keep_going;
+extern __thread struct timeval startime;
+
+// handle whose search is currently suspended by the solution iterator (NULL if no iterator is active)
+MDJEEP *searching = NULL;
+
+// this function creates a new MDJEEP handle
+// -> the selected method is bp with spg as a refinement method; all other attributes have default values
+// -> differently from the mdjeep program, the monitor is disabled
+MDJEEP* mdjeep_new(void)
+{
+   MDJEEP *md;
+
+   md = (MDJEEP*)calloc(1,sizeof(MDJEEP));
+   defaultAttributes(&md->op,&md->info);
+   md->info.method = 0;
+   md->info.refinement = 1;
+   defaultOptions(&md->op,&md->info);
+   md->op.monitor = false;
+   md->loaded = false;  md->prepared = false;
+   md->check_consec = false;  md->started = false;
+   md->X = NULL;
+   md->nd = 0;  md->dsize = 0;
+   md->did1 = NULL;  md->did2 = NULL;  md->dlb = NULL;  md->dub = NULL;
+   md->solution = NULL;  md->data = NULL;
+   md->iterating = 0;  md->stack = NULL;
+   md->pooling = false;  md->pool = NULL;  md->path = NULL;
+   return md;
+};
+
+// this function frees the MDJEEP handle (together with the instance it contains)
+void mdjeep_free(MDJEEP *md)
+{
+   if (md == NULL)  return;
+   mdjeep_unload(md);
+   if (md->info.name != NULL)  free(md->info.name);
+   if (md->info.filename != NULL)  free(md->info.filename);
+   if (md->info.start != NULL)  free(md->info.start);
+   if (md->info.output != NULL)  free(md->info.output);
+   if (md->info.previous != NULL)  free(md->info.previous);
+   if (md->info.prevsol != NULL)  free(md->info.prevsol);
+   freePool(md->pool);
+   free(md->path);
+   free(md);
+};
+
+// this function removes the loaded instance (and the distances given one by one) from the handle
+void mdjeep_unload(MDJEEP *md)
+{
+   mdjeep_stop(md);
+   if (md->loaded)
+   {
+      freeMatrix(3,md->X);
+      freeInstance(&md->inst);
+   };
+   md->X = NULL;
+   md->loaded = false;  md->prepared = false;  md->started = false;
+   md->pool = freePool(md->pool);
+   free(md->path);
+   md->path = NULL;
+   free(md->did1);  free(md->did2);  free(md->dlb);  free(md->dub);
+   md->did1 = NULL;  md->did2 = NULL;  md->dlb = NULL;  md->dub = NULL;
+   md->nd = 0;  md->dsize = 0;
+};
+
+// this function reads the method and its attributes from an MDfile
+// -> the input can be any valid file pointer (for example, a memory stream)
+// -> the instance file specified in the MDfile is loaded only when invoking mdjeep_load_file
+char* mdjeep_read_mdfile(MDJEEP *md,FILE *input)
+{
+   if (md->info.name != NULL)  free(md->info.name);
+   if (md->info.filename != NULL)  free(md->info.filename);
+   if (md->info.start != NULL)  free(md->info.start);
+   md->prepared = false;
+   return readMDfile(input,&md->op,&md->info);
+};
+
+// this function builds the error message for an invalid attribute value
+char* attributeError(const char *attribute,const char *value)
+{
+   char *error;
+
+   error = (char*)calloc(instlen+strlen(attribute)+strlen(value),sizeof(char));
+   sprintf(error,"mdjeep: error: '%s' is not a valid value for attribute '%s'",value,attribute);
+   return error;
+};
+
+// this function sets up one attribute, with the same names and the same values used in the MDfiles
+// -> the attributes "method" ("bp", "spg", "lbfgsb" or "smacof") and "refinement" ("spg", "lbfgsb" or "none") select the methods
+// -> "name", "format" and "separator" are the instance attributes (the separator is given as one char)
+// -> "startpoint" is the file of the starting point of the local methods, or a built-in starting point ("mds" or "random")
+// -> all other attributes refer to the selected methods (e.g. "resolution", "tolerance", "maxit")
+char* mdjeep_set(MDJEEP *md,const char *attribute,const char *value)
+{
+   char *c;
+   char *error;
+   unsigned long format;
+
+   if (attribute == NULL || value == NULL)  return strdup("mdjeep: error: attribute name or value missing");
+   md->prepared = false;
+   c = (char*)value;
+
+   if (!strcmp(attribute,"method"))
+   {
+      if (!strcmp(c,"bp"))
+         md->info.method = 0;
+      else if (!strcmp(c,"spg"))
+         md->info.method = 1;
+      else if (!strcmp(c,"lbfgsb"))
+         md->info.method = 2;
+      else if (!strcmp(c,"smacof"))
+         md->info.method = 3;
+      else
+         return attributeError(attribute,value);
+      if (md->info.method > 0 && md->info.refinement > 0)  md->info.refinement = -1;
+   }
+   else if (!strcmp(attribute,"refinement"))
+   {
+      if (!strcmp(c,"spg") && md->info.method == 0)
+         md->info.refinement = 1;
+      else if (!strcmp(c,"lbfgsb") && md->info.method == 0)
+         md->info.refinement = 2;
+      else if (!strcmp(c,"none"))
+         md->info.refinement = -1;
+      else
+         return attributeError(attribute,value);
+   }
+   else if (!strcmp(attribute,"name"))
+   {
+      if (md->info.name != NULL)  free(md->info.name);
+      md->info.name = strdup(c);
+   }
+   else if (!strcmp(attribute,"format"))
+   {
+      format = readFormat(c);
+      if (format < 6UL)  return attributeError(attribute,value);
+      md->info.format = format;
+   }
+   else if (!strcmp(attribute,"separator"))
+   {
+      if (strlen(c) != 1)  return attributeError(attribute,value);
+      md->info.sep = c[0];
+   }
+   else if (!strcmp(attribute,"resolution"))
+   {
+      if (!isReal(c) || atof(c) <= 0.0)  return attributeError(attribute,value);
+      md->op.r = atof(c);
+   }
+   else if (!strcmp(attribute,"tolerance"))
+   {
+      if (!isReal(c) || atof(c) <= 0.0)  return attributeError(attribute,value);
+      md->op.eps = atof(c);
+   }
+   else if (!strcmp(attribute,"maxtime"))
+   {
+      if (!isInteger(c) || atoi(c) <= 0)  return attributeError(attribute,value);
+      md->op.maxtime = atoi(c);
+   }
+   else if (!strcmp(attribute,"startpoint"))
+   {
+      if (md->info.start != NULL)  free(md->info.start);
+      md->info.start = NULL;
+      md->started = false;
+      if (!strcmp(c,"mds"))
+         md->info.initial = 1;
+      else if (!strcmp(c,"random"))
+         md->info.initial = 2;
+      else
+      {
+         md->info.initial = 0;
+         md->info.start = strdup(c);
+      };
+   }
+   else if (!strcmp(attribute,"maxit"))
+   {
+      if (!isInteger(c) || atoi(c) <= 0)  return attributeError(attribute,value);
+      md->op.maxit = atoi(c);
+   }
+   else if (!strcmp(attribute,"eta"))
+   {
+      if (!isReal(c) || atof(c) < 0.80 || atof(c) > 1.0)  return attributeError(attribute,value);
+      md->op.eta = atof(c);
+   }
+   else if (!strcmp(attribute,"gamma"))
+   {
+      if (!isReal(c) || atof(c) < 0.0 || atof(c) >= 1.0)  return attributeError(attribute,value);
+      md->op.gam = atof(c);
+   }
+   else if (!strcmp(attribute,"epsobj"))
+   {
+      if (!isReal(c) || atof(c) < 0.0 || atof(c) >= 1.0)  return attributeError(attribute,value);
+      md->op.epsobj = atof(c);
+   }
+   else if (!strcmp(attribute,"epsg"))
+   {
+      if (!isReal(c) || atof(c) < 0.0 || atof(c) >= 1.0)  return attributeError(attribute,value);
+      md->op.epsg = atof(c);
+   }
+   else if (!strcmp(attribute,"epsalpha"))
+   {
+      if (!isReal(c) || atof(c) < 0.0 || atof(c) >= 1.0)  return attributeError(attribute,value);
+      md->op.epsalpha = atof(c);
+   }
+   else if (!strcmp(attribute,"mumin"))
+   {
+      if (!isReal(c) || atof(c) < 0.0 || atof(c) > 1.0)  return attributeError(attribute,value);
+      md->op.mumin = atof(c);
+   }
+   else if (!strcmp(attribute,"mumax"))
+   {
+      if (!isReal(c) || atof(c) < 1.0)  return attributeError(attribute,value);
+      md->op.mumax = atof(c);
+   }
+   else if (!strcmp(attribute,"precision"))
+   {
+      if (!strcmp(c,"double"))
+         md->op.precision = 0;
+      else if (!strcmp(c,"single"))
+         md->op.precision = 1;
+      else
+         return attributeError(attribute,value);
+   }
+   else
+   {
+      error = (char*)calloc(instlen+strlen(attribute),sizeof(char));
+      sprintf(error,"mdjeep: error: unknown attribute '%s'",attribute);
+      return error;
+   };
+
+   return NULL;
+};
+
+// this function reads the mdjeep options from an array of command-line arguments (see readArguments)
+char* mdjeep_arguments(MDJEEP *md,int argc,char *argv[])
+{
+   md->prepared = false;
+   return readArguments(argc,argv,&md->op,&md->info,&md->check_consec);
+};
+
+// this function loads an instance (distance list) from a stream, with the format and the separator
+// specified in the MDfile (or through mdjeep_set); the previously loaded instance is removed
+char* mdjeep_load(MDJEEP *md,FILE *input)
+{
+   char *errmsg;
+
+   mdjeep_unload(md);
+   if (md->info.format == 0UL)  return strdup("mdjeep: error: the format of the distance list is not specified");
+   errmsg = readInstance(input,md->info.sep,md->info.format,&md->inst);
+   if (errmsg != NULL)  return errmsg;
+   md->X = allocateMatrix(3,md->inst.n);
+   md->loaded = true;
+   return NULL;
+};
+
+// this function loads an instance from a text file (the one specified in the MDfile if filename is NULL)
+char* mdjeep_load_file(MDJEEP *md,const char *filename)
+{
+   char *errmsg;
+   FILE *input;
+
+   if (filename == NULL)  filename = md->info.filename;
+   if (filename == NULL)  return strdup("mdjeep: error: no instance file specified");
+   input = fopen(filename,"r");
+   if (input == NULL)
+   {
+      errmsg = (char*)calloc(instlen+strlen(filename),sizeof(char));
+      sprintf(errmsg,"mdjeep: cannot open instance file '%s'",filename);
+      return errmsg;
+   };
+   errmsg = mdjeep_load(md,input);
+   fclose(input);
+   return errmsg;
+};
+
+// this function loads an instance from a memory buffer containing the distance list (len chars)
+char* mdjeep_load_memory(MDJEEP *md,const char *text,size_t len)
+{
+   char *errmsg;
+   FILE *input;
+
+   if (text == NULL || len == 0)  return strdup("mdjeep: error while reading instance: the distance list is empty");
+   input = fmemopen((void*)text,len,"r");
+   if (input == NULL)  return strdup("mdjeep: error: impossible to open a memory stream on the distance list");
+   errmsg = mdjeep_load(md,input);
+   fclose(input);
+   return errmsg;
+};
+
+// this function adds one distance to the instance under construction
+// -> the previously loaded instance is removed when the first distance is added
+// -> the vertex ranks need to form an interval of consecutive integers (names and groups are not specified)
+char* mdjeep_add_distance(MDJEEP *md,int id1,int id2,double lb,double ub)
+{
+   if (md->loaded)  mdjeep_unload(md);
+   if (id1 == id2)  return strdup("mdjeep: error: the presence of a distance from a vertex to itself was detected");
+   if (lb < 0.0 || lb > ub)  return strdup("mdjeep: error: invalid distance bounds (lb needs to be nonnegative, and not greater than ub)");
+
+   // enlarging the arrays
+   if (md->nd == md->dsize)
+   {
+      md->dsize = 2*md->dsize + 64;
+      md->did1 = (int*)realloc(md->did1,md->dsize*sizeof(int));
+      md->did2 = (int*)realloc(md->did2,md->dsize*sizeof(int));
+      md->dlb = (double*)realloc(md->dlb,md->dsize*sizeof(double));
+      md->dub = (double*)realloc(md->dub,md->dsize*sizeof(double));
+   };
+
+   // adding the distance
+   md->did1[md->nd] = id1;  md->did2[md->nd] = id2;
+   md->dlb[md->nd] = lb;    md->dub[md->nd] = ub;
+   md->nd++;
+   return NULL;
+};
+
+// this function makes sure that an instance is loaded
+// -> when the distances were given one by one, the instance is built here
+char* mdjeep_instance(MDJEEP *md)
+{
+   int i,j,k,l,n,n0,nmax;
+   char *error;
+   VERTEX *v;
+
+   if (md->loaded)  return NULL;
+   if (md->nd == 0)  return strdup("mdjeep: error: no instance loaded");
+
+   // vertex ranks
+   n0 = md->did1[0];  nmax = md->did1[0];
+   for (k = 0; k < md->nd; k++)
+   {
+      if (md->did1[k] < n0)  n0 = md->did1[k];
+      if (md->did2[k] < n0)  n0 = md->did2[k];
+      if (md->did1[k] > nmax)  nmax = md->did1[k];
+      if (md->did2[k] > nmax)  nmax = md->did2[k];
+   };
+   n = nmax - n0 + 1;
+
+   // vertex array
+   v = (VERTEX*)calloc(n,sizeof(VERTEX));
+   for (i = 0; i < n; i++)  v[i].Id = -1;
+   for (k = 0; k < md->nd; k++)
+   {
+      i = md->did1[k] - n0;
+      j = md->did2[k] - n0;
+      if (v[i].Id == -1)  initVertex(&v[i],md->did1[k],0,"(no name)","(no group name)");
+      if (v[j].Id == -1)  initVertex(&v[j],md->did2[k],0,"(no name)","(no group name)");
+      if (i > j)
+      {
+         l = i;  i = j;  j = l;
+      };
+      if (v[j].ref == NULL)
+         v[j].ref = initReference(i,md->dlb[k],md->dub[k]);
+      else if (getReference(v,i,j) == NULL)
+         addDistance(v[j].ref,i,md->dlb[k],md->dub[k]);
+   };
+
+   // verifying that all vertices were defined
+   for (i = 0; i < n; i++)
+   {
+      if (v[i].Id == -1)
+      {
+         freeVertex(n,v);
+         error = (char*)calloc(instlen,sizeof(char));
+         sprintf(error,"mdjeep: error: some vertex ranks in the interval [%d,%d] are missing",n0,nmax);
+         return error;
+      };
+   };
+
+   // the instance is ready
+   mdjeep_unload(md);
+   md->inst.n = n;  md->inst.n0 = n0;
+   md->inst.m = totalNumberOfDistances(n,v);
+   memoryUsage(0,instanceMemory(n,md->inst.m));
+   md->inst.mexact = 0;  md->inst.v = v;
+   md->inst.refs = NULL;  md->inst.sym = NULL;
+   md->inst.edges = freeEdges(md->inst.edges);
+   md->inst.ahead = freeLookAhead(md->inst.ahead);
+   md->inst.bounds = NULL;  md->inst.tightened = 0;
+   md->inst.nrep = n;  md->inst.vrep = NULL;  md->inst.rep = NULL;  md->inst.hier = NULL;  md->inst.blocks = NULL;
+   md->inst.exact = false;  md->inst.consec = false;  md->inst.smallsine = false;
+   md->X = allocateMatrix(3,n);
+   md->loaded = true;
+   return NULL;
+};
+
+// this function verifies and prepares the loaded instance for the selected method
+// -> it is automatically invoked by mdjeep_solve when the instance or the options change
+char* mdjeep_prepare(MDJEEP *md)
+{
+   char *errmsg;
+
+   errmsg = mdjeep_instance(md);
+   if (errmsg != NULL)  return errmsg;
+   if (md->prepared)  return NULL;
+
+   // removing the data of a previous preparation (a pending solution iterator is stopped,
+   // and the solutions in the pool cannot be rebuilt anymore, the number of layers may change)
+   mdjeep_stop(md);
+   md->pool = freePool(md->pool);
+   free(md->path);
+   md->path = NULL;
+   if (md->inst.refs != NULL)  free(md->inst.refs);
+   if (md->inst.sym != NULL)  free(md->inst.sym);
+   md->inst.refs = NULL;  md->inst.sym = NULL;
+   md->inst.edges = freeEdges(md->inst.edges);
+   md->inst.ahead = freeLookAhead(md->inst.ahead);
+   restoreBounds(&md->inst);
+
+   // verifying and preparing
+   errmsg = checkInstance(&md->inst,&md->op,&md->info);
+   if (errmsg != NULL)  return errmsg;
+   errmsg = prepareInstance(&md->inst,md->op,&md->info,md->check_consec);
+   if (errmsg != NULL)  return errmsg;
+
+   // the coordinates are computed at every layer of the tree (some vertices may be repeated)
+   if (md->inst.nrep > md->inst.n)
+   {
+      freeMatrix(3,md->X);
+      md->X = allocateMatrix(3,md->inst.nrep);
+   };
+   md->prepared = true;
+   return NULL;
+};
+
+// this function reads the starting point for spg from a stream (see readStartingPoint)
+char* mdjeep_read_start(MDJEEP *md,FILE *input)
+{
+   char *errmsg;
+
+   errmsg = mdjeep_instance(md);
+   if (errmsg != NULL)  return errmsg;
+   md->started = false;
+   if (input == NULL)  return strdup("mdjeep: error while opening file containing starting point for spg");
+   if (readStartingPoint(input,md->inst.n,md->X) != md->inst.n)
+   {
+      return strdup("mdjeep: error while reading starting point for spg, it seems it doesnt contain the expected number of vertex positions");
+   };
+   md->started = true;
+   return NULL;
+};
+
+// this function reads the starting point for spg from a file (the one specified in the MDfile if filename is NULL)
+char* mdjeep_start_file(MDJEEP *md,const char *filename)
+{
+   char *errmsg;
+   FILE *input;
+
+   if (filename == NULL)  filename = md->info.start;
+   input = NULL;
+   if (filename != NULL)  input = fopen(filename,"r");
+   errmsg = mdjeep_read_start(md,input);
+   if (input != NULL)  fclose(input);
+   return errmsg;
+};
+
+// this function sets up the starting point for spg from an array of n triplets of coordinates
+char* mdjeep_start(MDJEEP *md,const double *xyz)
+{
+   int i,k;
+   char *errmsg;
+
+   errmsg = mdjeep_instance(md);
+   if (errmsg != NULL)  return errmsg;
+   for (i = 0; i < md->inst.n; i++)  for (k = 0; k < 3; k++)  md->X[k][i] = xyz[3*i+k];
+   md->started = true;
+   return NULL;
+};
+
+// this function sets up the function invoked on every solution (NULL to remove it)
+void mdjeep_callback(MDJEEP *md,mdjeep_solution f,void *data)
+{
+   md->solution = f;
+   md->data = data;
+};
+
+// this function forwards the solutions found by bp to the function given with mdjeep_callback
+void mdjeep_bpsolution(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info)
+{
+   MDJEEP *md = (MDJEEP*)info->data;
+   md->solution(info->nsols,n,X,lde,mde,md->data);
+};
+
+// this function prepares the handle for a new run of the selected method
+// -> the instance is prepared (if necessary), and the counters, the monitor and the output file name are set up
+char* mdjeep_setup(MDJEEP *md)
+{
+   char *errmsg;
+
+   // the peak memory is measured from here (see memory.c)
+   resetPeakMemory();
+
+   // preparing the instance
+   errmsg = mdjeep_prepare(md);
+   if (errmsg != NULL)  return errmsg;
+   setupInstance(&md->inst,&md->op,&md->info);
+
+   // previous solution (incremental mode): starting point for spg, and vertices kept by bp
+   md->info.resume = 0;
+   if (md->info.previous != NULL)
+   {
+      errmsg = previousSolution(&md->inst,&md->info,md->X);
+      if (errmsg != NULL)  return errmsg;
+      md->started = true;
+   };
+   if (md->info.method > 0 && !md->started && md->info.start == NULL)
+   {
+      // built-in starting point (see start.c)
+      builtinStart(md->inst.n,md->inst.v,md->X,md->op.eps,&md->info);
+      md->started = true;
+   };
+   if (md->info.method > 0 && !md->started)  return strdup("mdjeep: error: no starting point given for the local method");
+   if (md->info.method > 0 && md->op.maxit == -1)  return strdup("mdjeep: error: maxit attribute needs to be specified when a local method is the main method");
+
+   // resetting the counters
+   md->info.ncalls = 0;  md->info.nspg = 0;  md->info.nspgok = 0;  md->info.nstress = 0;
+   md->info.nsols = 0;  md->info.pruning = 0;
+   md->info.best_sol = 0;  md->info.best_mde = INFTY;  md->info.best_lde = INFTY;
+
+   // counting the maximum number of digits for monitor (optional)
+   if (md->op.monitor)
+   {
+      if (md->info.method == 0)
+         md->info.ndigits = numberOfDigits(md->inst.nrep);
+      else
+         md->info.ndigits = numberOfDigits(md->op.maxit);
+   };
+
+   // setting up output filename (if necessary)
+   if (md->info.output != NULL)  free(md->info.output);
+   md->info.output = NULL;
+   if (md->op.print != 0 || md->op.best > 0 || md->op.cluster > 0.0)
+   {
+      if (md->info.filename != NULL)
+         md->info.output = removExtension(md->info.filename);
+      else if (md->info.name != NULL)
+         md->info.output = strdup(md->info.name);
+      else
+         md->info.output = strdup("mdjeep");
+   };
+
+   // pool of solutions (emptied at every run, not used when bp does not start from the first layer)
+   md->info.pool = NULL;
+   if (md->pooling)
+   {
+      if (md->pool == NULL)  md->pool = newPool(md->inst.nrep);
+      clearPool(md->pool);
+      if (md->info.resume == 0)  md->info.pool = md->pool;
+   };
+
+   // solution function
+   md->info.solution = NULL;
+   if (md->solution != NULL)  md->info.solution = mdjeep_bpsolution;
+   md->info.data = md;
+   return NULL;
+};
+
+// this function collects the results of a run in the MDSTATS structure
+// -> for spg, the final solution is evaluated and passed to the function given with mdjeep_callback
+void mdjeep_results(MDJEEP *md,int its,double obj,int flag,double time)
+{
+   int n;
+   double lde,mde;
+
+   // the solution found by spg, lbfgsb or smacof
+   n = md->inst.n;
+   if (md->info.method > 0)
+   {
+      lde = compute_lde(n,md->inst.v,md->X,md->op.eps);
+      mde = compute_mde(n,md->inst.v,md->X,md->op.eps);
+      md->info.nsols = 1;  md->info.best_sol = 1;
+      md->info.best_lde = lde;  md->info.best_mde = mde;
+      if (md->solution != NULL)  md->solution(1,n,md->X,lde,mde,md->data);
+   };
+
+   // results
+   md->stats.nsols = md->info.nsols;
+   md->stats.pruning = md->info.pruning;
+   md->stats.duplicates = md->info.duplicates;
+   md->stats.clusters = md->info.clusters;
+   md->stats.nspg = md->info.nspg;
+   md->stats.nspgok = md->info.nspgok;
+   md->stats.nstress = md->info.nstress;
+   md->stats.best_sol = md->info.best_sol;
+   md->stats.best_lde = md->info.best_lde;
+   md->stats.best_mde = md->info.best_mde;
+   md->stats.its = its;
+   md->stats.obj = obj;
+   md->stats.flag = flag;
+   md->stats.time = time;
+   for (n = 0; n < 4; n++)  md->stats.peakmem[n] = peakMemory(n);
+};
+
+// this function runs the selected method on the loaded instance
+// -> every solution is given to the function selected with mdjeep_callback
+// -> the results are then available through mdjeep_stats
+char* mdjeep_solve(MDJEEP *md)
+{
+   int its,flag;
+   double obj;
+   char *errmsg;
+   SEARCH S;
+   struct timeval t1,t2;
+
+   // a pending solution iterator is stopped (bp cannot run while another search is suspended)
+   mdjeep_stop(md);
+   if (searching != NULL)  return strdup("mdjeep: error: a solution iterator is active on another handle");
+
+   // preparing the run
+   errmsg = mdjeep_setup(md);
+   if (errmsg != NULL)  return errmsg;
+
+   // calling the selected method
+   allocateSearch(&S,md->inst.nrep,md->inst.m);
+   its = 0;  obj = 0.0;
+   clearInterrupt();
+   gettimeofday(&t1,0);
+   flag = solveInstance(&md->inst,md->X,S,md->op,&md->info,&its,&obj);
+   gettimeofday(&t2,0);
+   freeSearch(&S);
+
+   // results
+   mdjeep_results(md,its,obj,flag,elapsedTime(t1,t2));
+   return NULL;
+};
+
+// this function gives the time in seconds elapsed between t1 and t2
+double elapsedTime(struct timeval t1,struct timeval t2)
+{
+   return (double)(t2.tv_sec - t1.tv_sec) + 1.e-6*(double)(t2.tv_usec - t1.tv_usec);
+};
+
+// Solution iterator
+// -----------------
+// bp is executed as a coroutine on a separate stack: the search is suspended every time a solution is found
+// (see mdjeep_yield), and it is resumed, from the same point of the tree, when the next solution is requested;
+// bp keeps part of its status in global variables, so that only one iterator can be active at a time
+
+// stack size for the coroutine running bp (the memory is actually used only when touched)
+size_t mdstack = 64*1024*1024;
+
+// this function is executed on the coroutine stack: it runs bp from the root of the tree
+// (when bp ends, the control goes back to the caller of mdjeep_next_solution through uc_link)
+void mdjeep_search(void)
+{
+   int its;
+   double obj;
+   MDJEEP *md = searching;
+
+   clearInterrupt();
+   solveInstance(&md->inst,md->X,md->S,md->op,&md->info,&its,&obj);
+   md->iterating = 2;
+};
+
+// this function replaces mdjeep_bpsolution while iterating: the solution is exposed to the caller
+// of mdjeep_next_solution, and the search is suspended until the next solution is requested
+void mdjeep_yield(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info)
+{
+   MDJEEP *md = (MDJEEP*)info->data;
+   struct timeval t1,t2;
+
+   // the solution is passed to the function given with mdjeep_callback (if any)
+   if (md->solution != NULL)  md->solution(info->nsols,n,X,lde,mde,md->data);
+
+   // the solution is exposed to the caller
+   md->current.s = info->nsols;  md->current.n = n;  md->current.X = X;
+   md->current.lde = lde;  md->current.mde = mde;
+
+   // suspending the search (the time spent outside bp does not count for maxtime)
+   gettimeofday(&t1,0);
+   swapcontext(&md->search,&md->caller);
+   gettimeofday(&t2,0);
+   startime.tv_sec = startime.tv_sec + (t2.tv_sec - t1.tv_sec);
+   startime.tv_usec = startime.tv_usec + (t2.tv_usec - t1.tv_usec);
+
+   // the iterator was stopped: bp needs to go back to the root of the tree
+   if (md->stopping)  keep_going = false;
+};
+
+// this function gives the next solution of the selected method
+// -> the first call starts the search, the following calls resume it from the last found solution
+// -> the limit on the number of solutions (-l) is not applied: the caller decides when to stop
+// -> sol->s is the integer label of the solution, it is 0 when no more solutions can be found;
+//    the matrix of coordinates sol->X is only valid until the next call
+// -> the iterator is reset with mdjeep_stop (the next call will start a new search)
+char* mdjeep_next_solution(MDJEEP *md,MDSOLUTION *sol)
+{
+   char *errmsg;
+   struct timeval t1,t2;
+
+   sol->s = 0;  sol->n = 0;  sol->X = NULL;
+   sol->lde = INFTY;  sol->mde = INFTY;
+
+   // the search was already completed
+   if (md->iterating == 2)  return NULL;
+
+   // starting the search
+   if (md->iterating == 0)
+   {
+      if (searching != NULL)  return strdup("mdjeep: error: another solution iterator is active (only one iterator at a time)");
+      errmsg = mdjeep_setup(md);
+      if (errmsg != NULL)  return errmsg;
+
+      // spg, lbfgsb and smacof only give one solution
+      if (md->info.method > 0)
+      {
+         errmsg = mdjeep_solve(md);
+         if (errmsg != NULL)  return errmsg;
+         md->iterating = 2;
+         sol->s = 1;  sol->n = md->inst.n;  sol->X = md->X;
+         sol->lde = md->stats.best_lde;  sol->mde = md->stats.best_mde;
+         return NULL;
+      };
+
+      // coroutine running bp
+      allocateSearch(&md->S,md->inst.nrep,md->inst.m);
+      md->maxsols = md->info.maxsols;
+      md->info.maxsols = INT_MAX;
+      md->info.solution = mdjeep_yield;
+      md->stopping = false;
+      md->elapsed = 0.0;
+      md->stack = (char*)malloc(mdstack);
+      getcontext(&md->search);
+      md->search.uc_stack.ss_sp = md->stack;
+      md->search.uc_stack.ss_size = mdstack;
+      md->search.uc_link = &md->caller;
+      makecontext(&md->search,mdjeep_search,0);
+      searching = md;
+      md->iterating = 1;
+   };
+
+   // resuming the search until the next solution (or the end of the search)
+   md->current.s = 0;
+   gettimeofday(&t1,0);
+   swapcontext(&md->caller,&md->search);
+   gettimeofday(&t2,0);
+   md->elapsed = md->elapsed + elapsedTime(t1,t2);
+
+   // the search is over
+   if (md->iterating == 2)
+   {
+      md->info.maxsols = md->maxsols;
+      freeSearch(&md->S);
+      free(md->stack);  md->stack = NULL;
+      searching = NULL;
+      mdjeep_results(md,0,0.0,0,md->elapsed);
+      if (md->stopping)  md->iterating = 0;
+      return NULL;
+   };
+
+   // new solution
+   (*sol) = md->current;
+   return NULL;
+};
+
+// this function stops the solution iterator (the search is unwound up to the root of the tree)
+// -> the next call to mdjeep_next_solution starts a new search
+void mdjeep_stop(MDJEEP *md)
+{
+   MDSOLUTION sol;
+
+   if (md->iterating == 1)
+   {
+      md->stopping = true;
+      mdjeep_next_solution(md,&sol);
+   };
+   md->iterating = 0;
+};
+
+// Pool of solutions
+// -----------------
+
+// this function enables (or disables) the pool of solutions for the next runs of bp
+// -> the pool keeps the path in the search tree of every solution (a few bits per vertex), instead of the
+//    coordinates, so that a large number of solutions can be kept in memory (see pool.c)
+void mdjeep_pool(MDJEEP *md,bool enable)
+{
+   md->pooling = enable;
+   if (!enable)  md->pool = freePool(md->pool);
+};
+
+// this function gives the number of solutions in the pool (found during the last run)
+int mdjeep_pool_size(MDJEEP *md)
+{
+   if (md->pool == NULL)  return 0;
+   return md->pool->size;
+};
+
+// this function rebuilds the solution k (from 1 to the pool size) from its path in the search tree
+// -> the solution is rebuilt with the instance and the options of the run that found it: they cannot be
+//    modified in the meanwhile (and no iterator can be active)
+// -> the matrix of coordinates sol->X is only valid until the next request (see rebuildSolution)
+char* mdjeep_rebuild(MDJEEP *md,int k,MDSOLUTION *sol)
+{
+   bool ok;
+   SEARCH S;
+
+   sol->s = 0;  sol->n = 0;  sol->X = NULL;
+   sol->lde = INFTY;  sol->mde = INFTY;
+   if (searching != NULL)  return strdup("mdjeep: error: solutions cannot be rebuilt while a solution iterator is active");
+   if (md->pool == NULL || k < 1 || k > md->pool->size)  return strdup("mdjeep: error: the requested solution is not in the pool");
+   if (!md->prepared)  return strdup("mdjeep: error: the instance or the options were modified after the search");
+
+   // replaying the path
+   if (md->path == NULL)  md->path = (int*)calloc(md->inst.nrep,sizeof(int));
+   getPath(md->pool,k-1,md->path);
+   allocateSearch(&S,md->inst.nrep,md->inst.m);
+   ok = rebuildSolution(&md->inst,md->X,S,md->op,md->info,md->path);
+   freeSearch(&S);
+   if (!ok)  return strdup("mdjeep: error: the search was interrupted while rebuilding the solution");
+
+   // the rebuilt solution
+   sol->s = k;  sol->n = md->inst.n;  sol->X = md->X;
+   sol->lde = compute_lde(md->inst.n,md->inst.v,md->X,md->op.eps);
+   sol->mde = compute_mde(md->inst.n,md->inst.v,md->X,md->op.eps);
+   return NULL;
+};
+
+// this function gives the results of the last run
+MDSTATS mdjeep_stats(MDJEEP *md)
+{
+   return md->stats;
+};
+
+// this function gives the number of vertices of the loaded instance (0 if no instance is loaded)
+int mdjeep_size(MDJEEP *md)
+{
+   char *errmsg;
+
+   errmsg = mdjeep_instance(md);
+   if (errmsg != NULL)
+   {
+      free(errmsg);
+      return 0;
+   };
+   return md->inst.n;
+};
+
+// these functions give the rank, the name and the group name of the vertex i (from 0 to n-1) of the loaded instance
+int mdjeep_vertex_id(MDJEEP *md,int i)
+{
+   return getVertexId(md->inst.v[i]);
+};
+
+const char* mdjeep_vertex_name(MDJEEP *md,int i)
+{
+   return md->inst.v[i].Name;
+};
+
+const char* mdjeep_vertex_group(MDJEEP *md,int i)
+{
+   return md->inst.v[i].Group;
+};
@@ -0,0 +1,118 @@
+/*******************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - library header file
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (public interface of libmdjeep)
+                                    solution iterator added
+                                    pool of solutions added
+                                    number of duplicated solutions in MDSTATS
+                                    number of clusters in MDSTATS
+                                    peak memory by category in MDSTATS
+********************************************************************************************************/
+
+#ifndef MDJEEP_H
+#define MDJEEP_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+// all functions returning a char pointer return NULL on success, and an allocated string describing
+// the error otherwise (the string needs to be freed by the caller)
+
+// MDJEEP: handle containing the options, the instance and the results of the last run
+typedef struct mdjeep MDJEEP;
+
+// MDSTATS: results of the last run
+typedef struct mdstats MDSTATS;
+struct mdstats
+{
+   int nsols;        // number of found solutions (always 1 for spg, lbfgsb and smacof)
+   int pruning;      // number of pruned branches (bp)
+   int duplicates;   // number of solutions discarded as duplicates (bp, option -dedup)
+   int clusters;     // number of clusters of solutions (bp, option -cluster)
+   int nspg;         // number of calls to the refinement method (bp)
+   int nspgok;       // number of successful calls to the refinement method (bp)
+   int nstress;      // number of evaluations of the stress function (spg, lbfgsb and smacof)
+   int best_sol;     // integer label of the best solution
+   double best_lde;  // LDE function value in the best solution
+   double best_mde;  // MDE function value in the best solution
+   int its;          // number of iterations (spg, lbfgsb and smacof)
+   double obj;       // final stress function value (spg, lbfgsb and smacof)
+   int flag;         // reason why the method stopped: 0 = convergence, 1 = small gradient or decrease, 2 = maxit
+   double time;      // running time in seconds
+   size_t peakmem[4]; // peak memory in bytes during the run: graph of the instance, workspace of the methods,
+                      // solutions kept in memory, output buffers (only the main data structures are counted)
+};
+
+// MDSOLUTION: solution given by the solution iterator
+typedef struct mdsolution MDSOLUTION;
+struct mdsolution
+{
+   int s;          // integer label of the solution (0 if no more solutions can be found)
+   int n;          // number of vertices
+   double **X;     // 3xn matrix of coordinates (only valid until the next request)
+   double lde;     // LDE function value
+   double mde;     // MDE function value
+};
+
+// function invoked on every solution
+// -> s is the integer label of the solution, n is the number of vertices
+// -> X is the 3xn matrix of coordinates (X[0][i], X[1][i] and X[2][i] are the coordinates of vertex i);
+//    it is only valid during the call
+// -> data is the pointer given to mdjeep_callback
+typedef void (*mdjeep_solution)(int s,int n,double **X,double lde,double mde,void *data);
+
+// handle creation (bp with spg refinement and default attributes) and destruction
+MDJEEP* mdjeep_new(void);
+void mdjeep_free(MDJEEP *md);
+
+// options: MDfile (from any stream, e.g. a memory stream), single attributes, command-line options
+char* mdjeep_read_mdfile(MDJEEP *md,FILE *input);
+char* mdjeep_set(MDJEEP *md,const char *attribute,const char *value);
+char* mdjeep_arguments(MDJEEP *md,int argc,char *argv[]);
+
+// instance: distance list from a stream, a file (NULL for the file in the MDfile), or a memory buffer
+char* mdjeep_load(MDJEEP *md,FILE *input);
+char* mdjeep_load_file(MDJEEP *md,const char *filename);
+char* mdjeep_load_memory(MDJEEP *md,const char *text,size_t len);
+
+// instance: distances given one by one (the instance is built by mdjeep_prepare or mdjeep_solve)
+char* mdjeep_add_distance(MDJEEP *md,int id1,int id2,double lb,double ub);
+
+// verification and preprocessing of the loaded instance (otherwise performed by mdjeep_solve)
+char* mdjeep_prepare(MDJEEP *md);
+
+// starting point for spg, lbfgsb and smacof: from a stream, a file (NULL for the file in the MDfile), or an array of
+// n triplets of coordinates (smacof has a built-in starting point when none is given)
+char* mdjeep_read_start(MDJEEP *md,FILE *input);
+char* mdjeep_start_file(MDJEEP *md,const char *filename);
+char* mdjeep_start(MDJEEP *md,const double *xyz);
+
+// solution callback, and execution of the selected method
+void mdjeep_callback(MDJEEP *md,mdjeep_solution f,void *data);
+char* mdjeep_solve(MDJEEP *md);
+MDSTATS mdjeep_stats(MDJEEP *md);
+
+// solution iterator: the search is suspended after every solution, and resumed from the same point of the
+// tree at the next request; mdjeep_stop ends the search (the next request starts a new one)
+// (only one iterator can be active at a time; the limit on the number of solutions is not applied)
+char* mdjeep_next_solution(MDJEEP *md,MDSOLUTION *sol);
+void mdjeep_stop(MDJEEP *md);
+
+// pool of solutions: when enabled, bp stores every solution as its path in the search tree (a few bits per
+// vertex) and not as coordinates, so that a large number of solutions can be kept in memory; the solutions of
+// the last run are then rebuilt on demand (k from 1 to the pool size; the coordinates are the ones found during
+// the search for instances consisting of exact distances, they may slightly differ when the refinement is used)
+void mdjeep_pool(MDJEEP *md,bool enable);
+int mdjeep_pool_size(MDJEEP *md);
+char* mdjeep_rebuild(MDJEEP *md,int k,MDSOLUTION *sol);
+
+// loaded instance
+int mdjeep_size(MDJEEP *md);
+int mdjeep_vertex_id(MDJEEP *md,int i);
+const char* mdjeep_vertex_name(MDJEEP *md,int i);
+const char* mdjeep_vertex_group(MDJEEP *md,int i);
+
+#endif
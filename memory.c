@@ -0,0 +1,96 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - memory footprint
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (peak memory by category in the run report)
+************************************************************************************************************/
+
+#include "bp.h"
+
+extern size_t valign;
+
+// the memory of the main data structures is counted by category when they are allocated and freed:
+// 0 = graph of the instance (vertices and distances, and the structures derived from them)
+// 1 = workspace of the methods (SEARCH, and the memory of spg, lbfgsb and smacof)
+// 2 = solutions kept in memory (pool of paths, k best solutions, duplicates and clusters)
+// 3 = output buffers (queue and stream of the asynchronous writer)
+// -> the counters are shared by all threads (and by all handles of the library)
+// -> the small allocations (names of the vertices, omega lists, etc) are not counted
+
+// memory in use, and largest memory in use since the last reset, by category
+size_t memcurrent[4] = {0,0,0,0};
+size_t mempeak[4] = {0,0,0,0};
+pthread_mutex_t memlock = PTHREAD_MUTEX_INITIALIZER;
+
+// this function updates the memory in use in the given category (bytes is negative when the memory is freed)
+void memoryUsage(int category,long bytes)
+{
+   pthread_mutex_lock(&memlock);
+   if (bytes < 0 && (size_t)(-bytes) > memcurrent[category])
+      memcurrent[category] = 0;
+   else
+      memcurrent[category] = memcurrent[category] + bytes;
+   if (memcurrent[category] > mempeak[category])  mempeak[category] = memcurrent[category];
+   pthread_mutex_unlock(&memlock);
+};
+
+// this function sets the peak memory of every category to the memory currently in use (it is invoked before every run)
+void resetPeakMemory(void)
+{
+   int c;
+
+   pthread_mutex_lock(&memlock);
+   for (c = 0; c < 4; c++)  mempeak[c] = memcurrent[c];
+   pthread_mutex_unlock(&memlock);
+};
+
+// this function gives the peak memory of the given category since the last reset
+size_t peakMemory(int category)
+{
+   size_t peak;
+
+   pthread_mutex_lock(&memlock);
+   peak = mempeak[category];
+   pthread_mutex_unlock(&memlock);
+   return peak;
+};
+
+// this function gives the memory of a matrix with n rows of length m (see allocateMatrix)
+long matrixMemory(size_t n,size_t m)
+{
+   size_t stride;
+
+   stride = (m*sizeof(double) + valign - 1)/valign*valign;
+   if (n == 0)  return (long)(sizeof(double*) + valign);
+   return (long)(n*sizeof(double*) + n*stride);
+};
+
+// this function gives the memory of a vector of length n (see allocateVector)
+long vectorMemory(size_t n)
+{
+   size_t size;
+
+   size = (n*sizeof(double) + valign - 1)/valign*valign;
+   if (size == 0)  size = valign;
+   return (long)size;
+};
+
+// this function writes an amount of memory in a string (with the most suitable unit)
+// -> the returning string needs to be freed
+char* memoryString(size_t bytes)
+{
+   char *s;
+
+   s = (char*)calloc(32,sizeof(char));
+   if (bytes < 1024)
+      sprintf(s,"%lu bytes",(unsigned long)bytes);
+   else if (bytes < 1024*1024)
+      sprintf(s,"%.1f kB",bytes/1024.0);
+   else if (bytes < 1024UL*1024*1024)
+      sprintf(s,"%.1f MB",bytes/(1024.0*1024.0));
+   else
+      sprintf(s,"%.2f GB",bytes/(1024.0*1024.0*1024.0));
+   return s;
+};
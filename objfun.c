@@ -7,6 +7,9 @@
   History:    Jul 28 2019  v.0.3.0  introduced in this version
               Mar 21 2020  v.0.3.1  no changes
               May 19 2020  v.0.3.2  no changes
+              Oct 18 2026  v.0.3.3  MDE and LDE computed together on contiguous arrays of distances
+                                    memory of the EDGES structure counted (see memory.c)
+                                    MDE averaged over the vertices, also when some vertices are repeated
 ****************************************************************************************************/
 
 #include "bp.h"
@@ -99,6 +102,150 @@ double compute_lde(int n,VERTEX *v,double **X,double eps)
    return max;
 };
 
+// this function creates the EDGES structure of a VERTEX array (n,v): the distances are copied in contiguous
+// arrays, in the same order as in the lists of references, so that MDE and LDE can be evaluated in one pass
+// (eps is the tolerance to discriminate between exact and interval distances)
+EDGES* newEdges(int n,VERTEX *v,double eps)
+{
+   int i,h;
+   REFERENCE *ref;
+   EDGES *e;
+
+   e = (EDGES*)calloc(1,sizeof(EDGES));
+   e->n = n;
+   e->nv = n;
+   e->start = (int*)calloc(n+1,sizeof(int));
+   e->m = 0;
+   for (i = 0; i < n; i++)
+   {
+      e->start[i] = e->m;
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)  e->m++;
+   };
+   e->start[n] = e->m;
+   e->other = (int*)calloc(e->m > 0 ? e->m : 1,sizeof(int));
+   e->lb = allocateVector(e->m > 0 ? e->m : 1);
+   e->ub = allocateVector(e->m > 0 ? e->m : 1);
+   e->norm = allocateVector(e->m > 0 ? e->m : 1);
+   h = 0;
+   for (i = 0; i < n; i++)
+   {
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
+      {
+         e->other[h] = otherVertexId(ref);
+         if (isExactDistance(ref,eps))
+         {
+            e->lb[h] = lowerBound(ref);
+            e->ub[h] = lowerBound(ref);
+            e->norm[h] = lowerBound(ref);
+         }
+         else
+         {
+            e->lb[h] = lowerBound(ref);
+            e->ub[h] = upperBound(ref);
+            e->norm[h] = 0.5*(lowerBound(ref) + upperBound(ref));
+         };
+         h++;
+      };
+   };
+   memoryUsage(0,edgesMemory(e));
+   return e;
+};
+
+// this function gives the memory of the EDGES structure (see memory.c)
+long edgesMemory(EDGES *e)
+{
+   return sizeof(EDGES) + (long)(e->n + 1 + e->m)*sizeof(int) + 3*vectorMemory(e->m > 0 ? e->m : 1);
+};
+
+// this function frees the EDGES structure
+EDGES* freeEdges(EDGES *e)
+{
+   if (e == NULL)  return NULL;
+   memoryUsage(0,-edgesMemory(e));
+   free(e->start);  free(e->other);
+   freeVector(e->lb);  freeVector(e->ub);  freeVector(e->norm);
+   free(e);
+   return NULL;
+};
+
+// this function computes MDE and LDE of the realization X in one pass over the distances
+// -> the values are the ones given by compute_mde and compute_lde (the operations are performed in the same order)
+// -> verr, if not NULL, contains at the end the sum of the distance errors involving every vertex (n values)
+void compute_errors(EDGES *e,double **X,double *verr,double *lde,double *mde)
+{
+   int i,j,h;
+   double dx,dy,dz,dist,diff;
+   double sum = 0.0;
+   double max = 0.0;
+
+   if (verr != NULL)  for (i = 0; i < e->n; i++)  verr[i] = 0.0;
+   for (i = 0; i < e->n; i++)
+   {
+      for (h = e->start[i]; h < e->start[i+1]; h++)
+      {
+         j = e->other[h];
+         dx = X[0][j] - X[0][i];  dy = X[1][j] - X[1][i];  dz = X[2][j] - X[2][i];
+         dist = sqrt((dx*dx) + (dy*dy) + (dz*dz));
+         if (dist < e->lb[h])
+            diff = e->lb[h] - dist;
+         else if (dist > e->ub[h])
+            diff = dist - e->ub[h];
+         else
+            continue;
+         sum = sum + diff/e->norm[h];
+         if (diff > max)  max = diff;
+         if (verr != NULL)
+         {
+            verr[i] = verr[i] + diff;
+            verr[j] = verr[j] + diff;
+         };
+      };
+   };
+   if (e->m > 0)  sum = sum/e->nv;
+   *lde = max;
+   *mde = sum;
+};
+
+// this function computes MDE and LDE of the realization X by evaluating again only the vertices from k to n-1
+// -> esum[i] and emax[i] are the partial MDE sum and the partial LDE over the distances of the vertices 0, ..., i:
+//    the values for the vertices before k are the ones of a previous evaluation (the coordinates of the vertices
+//    from 0 to k-1 need to be unchanged), the values for the other vertices are updated
+void update_errors(EDGES *e,int k,double **X,double *esum,double *emax,double *lde,double *mde)
+{
+   int i,j,h;
+   double dx,dy,dz,dist,diff;
+   double sum = 0.0;
+   double max = 0.0;
+
+   if (k > 0)
+   {
+      sum = esum[k-1];
+      max = emax[k-1];
+   };
+   for (i = k; i < e->n; i++)
+   {
+      for (h = e->start[i]; h < e->start[i+1]; h++)
+      {
+         j = e->other[h];
+         dx = X[0][j] - X[0][i];  dy = X[1][j] - X[1][i];  dz = X[2][j] - X[2][i];
+         dist = sqrt((dx*dx) + (dy*dy) + (dz*dz));
+         if (dist < e->lb[h])
+            diff = e->lb[h] - dist;
+         else if (dist > e->ub[h])
+            diff = dist - e->ub[h];
+         else
+            continue;
+         sum = sum + diff/e->norm[h];
+         if (diff > max)  max = diff;
+      };
+      esum[i] = sum;
+      emax[i] = max;
+   };
+   if (e->m > 0)  sum = sum/e->nv;
+   *lde = max;
+   *mde = sum;
+};
+
 // STRESS function
 // given a VERTEX array (n,v), a realization X, and vector y of selected distances from the intervals [lb,ub],
 // this function computes the stress function [Glunt at al, "Molecular Conformations from Distance Matrices", 1993]
@@ -0,0 +1,735 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - vertex orders
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (option --order)
+************************************************************************************************************/
+
+#include "bp.h"
+
+extern size_t instlen;
+
+// bp can only be invoked when the vertex order of the instance satisfies the discretization assumptions: the
+// first three vertices form a clique of exact distances, and every other vertex has at least 3 distances to the
+// previous vertices, with at least 2 exact distances (DDGP order); the consecutivity assumption additionally
+// requires the 3 reference vertices to be the 3 immediately preceding ones, with exact distances to the last 2
+// (DMDGP order); the functions below look for such an order, starting from every clique of exact distances:
+// -> DDGP: a vertex that can be added to a partial order can still be added after adding other vertices, so that
+//    the greedy choice of the next vertex finds an order whenever one exists (for the given initial clique)
+// -> DMDGP: the next vertex is chosen among the neighbors of the last three, with backtracking (the number of
+//    explored partial orders is limited, see obudget)
+// the next vertex is the one with the largest number of distances to the previous ones, and among these, the
+// ones having at least 3 exact distances (no interval distance is necessary for the discretization) are preferred;
+// the orders found from different initial cliques are compared by number of vertices needing an interval distance
+// for the discretization, and then by average layer of the pruning distances (the earlier, the better)
+
+// maximum number of orders compared (one per initial clique)
+int omaxorders = 32;
+
+// maximum number of partial orders explored when looking for a DMDGP order (from one initial clique, and in total)
+long oattempt = 5000L;
+long obudget = 500000L;
+
+// this function creates the VORDER structure for an instance with n vertices
+VORDER* newOrder(int n,VERTEX *v,double eps)
+{
+   int i,j,h,k,tmp;
+   int *fill;
+   bool btmp;
+   REFERENCE *ref,*rtmp;
+   VORDER *o;
+
+   o = (VORDER*)calloc(1,sizeof(VORDER));
+   o->n = n;
+   o->start = (int*)calloc(n+1,sizeof(int));
+   for (i = 0; i < n; i++)
+   {
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
+      {
+         o->start[i+1]++;
+         o->start[otherVertexId(ref)+1]++;
+      };
+   };
+   for (i = 0; i < n; i++)  o->start[i+1] = o->start[i+1] + o->start[i];
+
+   // symmetric lists of neighbors, sorted by vertex id
+   k = o->start[n] > 0 ? o->start[n] : 1;
+   o->adj = (int*)calloc(k,sizeof(int));
+   o->exact = (bool*)calloc(k,sizeof(bool));
+   o->ref = (REFERENCE**)calloc(k,sizeof(REFERENCE*));
+   fill = (int*)calloc(n+1,sizeof(int));
+   for (i = 0; i < n; i++)  fill[i] = o->start[i];
+   for (i = 0; i < n; i++)
+   {
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
+      {
+         j = otherVertexId(ref);
+         o->adj[fill[i]] = j;  o->exact[fill[i]] = isExactDistance(ref,eps);  o->ref[fill[i]] = ref;  fill[i]++;
+         o->adj[fill[j]] = i;  o->exact[fill[j]] = isExactDistance(ref,eps);  o->ref[fill[j]] = ref;  fill[j]++;
+      };
+   };
+   free(fill);
+   for (i = 0; i < n; i++)
+   {
+      for (h = o->start[i] + 1; h < o->start[i+1]; h++)
+      {
+         for (k = h; k > o->start[i] && o->adj[k-1] > o->adj[k]; k--)
+         {
+            tmp = o->adj[k];  o->adj[k] = o->adj[k-1];  o->adj[k-1] = tmp;
+            btmp = o->exact[k];  o->exact[k] = o->exact[k-1];  o->exact[k-1] = btmp;
+            rtmp = o->ref[k];  o->ref[k] = o->ref[k-1];  o->ref[k-1] = rtmp;
+         };
+      };
+   };
+
+   // the partial order
+   o->size = 0;
+   o->order = (int*)calloc(n,sizeof(int));
+   o->rank = (int*)calloc(n,sizeof(int));
+   o->cnt = (int*)calloc(n,sizeof(int));
+   o->cex = (int*)calloc(n,sizeof(int));
+   for (i = 0; i < n; i++)  o->rank[i] = -1;
+   o->budget = 0L;
+   o->stamp = 0;
+   o->mark = (int*)calloc(n,sizeof(int));
+   o->queue = (int*)calloc(n,sizeof(int));
+   o->hint = (int*)calloc(n,sizeof(int));
+   for (i = 0; i < n; i++)  o->hint[i] = i;
+   return o;
+};
+
+// this function frees the VORDER structure
+VORDER* freeOrder(VORDER *o)
+{
+   if (o == NULL)  return NULL;
+   free(o->start);  free(o->adj);  free(o->exact);  free(o->ref);
+   free(o->order);  free(o->rank);  free(o->cnt);  free(o->cex);
+   free(o->mark);  free(o->queue);  free(o->hint);
+   free(o);
+   return NULL;
+};
+
+// this function looks for the distance between the vertices a and b
+// -> the returning value is the position of b in the list of neighbors of a, or -1 if there is no such distance
+int orderDistance(VORDER *o,int a,int b)
+{
+   int h,l,u;
+
+   l = o->start[a];  u = o->start[a+1];
+   while (l < u)
+   {
+      h = (l + u)/2;
+      if (o->adj[h] < b)
+         l = h + 1;
+      else
+         u = h;
+   };
+   if (l < o->start[a+1] && o->adj[l] == b)  return l;
+   return -1;
+};
+
+// this function appends the vertex x to the partial order
+void placeVertex(VORDER *o,int x)
+{
+   int h;
+
+   o->rank[x] = o->size;
+   o->order[o->size] = x;
+   o->size++;
+   for (h = o->start[x]; h < o->start[x+1]; h++)
+   {
+      o->cnt[o->adj[h]]++;
+      if (o->exact[h])  o->cex[o->adj[h]]++;
+   };
+};
+
+// this function removes the last vertex from the partial order
+void unplaceVertex(VORDER *o)
+{
+   int h,x;
+
+   o->size--;
+   x = o->order[o->size];
+   o->rank[x] = -1;
+   for (h = o->start[x]; h < o->start[x+1]; h++)
+   {
+      o->cnt[o->adj[h]]--;
+      if (o->exact[h])  o->cex[o->adj[h]]--;
+   };
+};
+
+// this function removes all vertices from the partial order
+void clearOrder(VORDER *o)
+{
+   while (o->size > 0)  unplaceVertex(o);
+};
+
+// this function verifies whether the vertex x can be appended to the partial order: it needs at least 3 distances
+// to the placed vertices, with at least 2 exact distances; when all these distances are exact, 3 of the reference
+// vertices also need to form a clique of exact distances (see findReferencesExactCase)
+bool orderReferences(VORDER *o,int x)
+{
+   int h,k,l,a,b,c,p;
+
+   if (o->cnt[x] < 3 || o->cex[x] < 2)  return false;
+   if (o->cex[x] < o->cnt[x])  return true;
+   for (h = o->start[x]; h < o->start[x+1]; h++)
+   {
+      a = o->adj[h];
+      if (o->rank[a] < 0)  continue;
+      for (k = h + 1; k < o->start[x+1]; k++)
+      {
+         b = o->adj[k];
+         if (o->rank[b] < 0)  continue;
+         p = orderDistance(o,a,b);
+         if (p < 0 || !o->exact[p])  continue;
+         for (l = k + 1; l < o->start[x+1]; l++)
+         {
+            c = o->adj[l];
+            if (o->rank[c] < 0)  continue;
+            p = orderDistance(o,a,c);
+            if (p < 0 || !o->exact[p])  continue;
+            p = orderDistance(o,b,c);
+            if (p >= 0 && o->exact[p])  return true;
+         };
+      };
+   };
+   return false;
+};
+
+// this function completes the partial order with the greedy choice of the next vertex (DDGP order)
+// -> the returning value is true if all vertices could be placed
+bool greedyDDGP(VORDER *o)
+{
+   int x,best;
+
+   while (o->size < o->n)
+   {
+      best = -1;
+      for (x = 0; x < o->n; x++)
+      {
+         if (o->rank[x] >= 0)  continue;
+         if (!orderReferences(o,x))  continue;
+         if (best < 0)
+            best = x;
+         else if ((o->cex[x] >= 3) != (o->cex[best] >= 3))
+         {
+            if (o->cex[x] >= 3)  best = x;
+         }
+         else if (o->cnt[x] > o->cnt[best])
+            best = x;
+      };
+      if (best < 0)  return false;
+      placeVertex(o,best);
+   };
+   return true;
+};
+
+// this function verifies whether the partial order can still be completed (necessary conditions, DMDGP orders):
+// -> every vertex needs its 3 preceding vertices to be neighbors (with exact distances to the last 2), so that
+//    it needs enough neighbors among the vertices not placed yet and the last 3 placed ones; only the neighbors of
+//    the vertex that left the last three with the last placed vertex need to be verified
+// -> two consecutive vertices have an exact distance, so that the vertices not placed yet form a path of exact
+//    distances starting from a neighbor of the last placed vertex: they need to be connected (through exact
+//    distances) to the last placed vertex, and at most one of them can be the end of the path (a vertex having
+//    only one exact distance to the other vertices not placed yet, not adjacent to the last placed vertex)
+// -> the returning value is true if the partial order cannot be completed
+bool orderDeadEnd(VORDER *o)
+{
+   int h,k,p,x,y,nfree,fexact,nreached,nends,head;
+
+   if (o->size == o->n)  return false;
+
+   // vertices that lost one of their possible preceding vertices
+   if (o->size >= 4)
+   {
+      x = o->order[o->size-4];
+      for (h = o->start[x]; h < o->start[x+1]; h++)
+      {
+         y = o->adj[h];
+         if (o->rank[y] >= 0)  continue;
+         nfree = 0;  fexact = 0;
+         for (p = o->start[y]; p < o->start[y+1]; p++)
+         {
+            if (o->rank[o->adj[p]] >= 0)  continue;
+            nfree++;
+            if (o->exact[p])  fexact++;
+         };
+         for (k = o->size - 3; k < o->size; k++)
+         {
+            p = orderDistance(o,y,o->order[k]);
+            if (p < 0)  continue;
+            nfree++;
+            if (o->exact[p])  fexact++;
+         };
+         if (nfree < 3 || fexact < 2)  return true;
+      };
+   };
+
+   // path of exact distances through the vertices not placed yet
+   o->stamp++;
+   x = o->order[o->size-1];
+   nreached = 0;
+   for (h = o->start[x]; h < o->start[x+1]; h++)
+   {
+      y = o->adj[h];
+      if (o->rank[y] >= 0 || !o->exact[h] || o->mark[y] == o->stamp)  continue;
+      o->mark[y] = o->stamp;
+      o->queue[nreached++] = y;
+   };
+   nends = 0;
+   for (head = 0; head < nreached; head++)
+   {
+      y = o->queue[head];
+      k = 0;
+      for (p = o->start[y]; p < o->start[y+1]; p++)
+      {
+         if (o->rank[o->adj[p]] >= 0 || !o->exact[p])  continue;
+         k++;
+         if (o->mark[o->adj[p]] == o->stamp)  continue;
+         o->mark[o->adj[p]] = o->stamp;
+         o->queue[nreached++] = o->adj[p];
+      };
+      if (k <= 1 && orderDistance(o,y,x) < 0)  nends++;
+   };
+   if (nreached < o->n - o->size)  return true;
+   if (nends > 1)  return true;
+   return false;
+};
+
+// this function completes the partial order with backtracking, so that the consecutivity assumption is
+// satisfied (DMDGP order); the partial order needs to contain at least 3 vertices
+// -> the returning value is true if all vertices could be placed (false if no order was found within the budget)
+bool searchDMDGP(VORDER *o)
+{
+   int h,k,x,c,ncand,tmp;
+   int a1,a2,a3,p2,p3;
+   int *cand,*score;
+   bool found;
+
+   if (o->size == o->n)  return true;
+   if (o->budget <= 0L)  return false;
+   o->budget--;
+
+   // candidates: neighbors of the last vertex, with exact distances to the last two and a distance to the third
+   a1 = o->order[o->size-1];  a2 = o->order[o->size-2];  a3 = o->order[o->size-3];
+   cand = (int*)calloc(o->start[a1+1] - o->start[a1] + 1,sizeof(int));
+   score = (int*)calloc(o->start[a1+1] - o->start[a1] + 1,sizeof(int));
+   ncand = 0;
+   for (h = o->start[a1]; h < o->start[a1+1]; h++)
+   {
+      x = o->adj[h];
+      if (o->rank[x] >= 0 || !o->exact[h])  continue;
+      p2 = orderDistance(o,x,a2);
+      if (p2 < 0 || !o->exact[p2])  continue;
+      p3 = orderDistance(o,x,a3);
+      if (p3 < 0)  continue;
+
+      // the candidates are sorted by score (insertion)
+      if (o->rule == 0)
+         c = -o->hint[x];
+      else
+      {
+         c = 0;
+         for (k = o->size - 6; k < o->size; k++)  if (k >= 0)  if (orderDistance(o,x,o->order[k]) >= 0)  c++;
+         c = 4*o->n*c - 2*(o->start[x+1] - o->start[x] - o->cnt[x]);
+      };
+      cand[ncand] = x;  score[ncand] = c;
+      for (k = ncand; k > 0 && score[k-1] < score[k]; k--)
+      {
+         tmp = cand[k];  cand[k] = cand[k-1];  cand[k-1] = tmp;
+         tmp = score[k];  score[k] = score[k-1];  score[k-1] = tmp;
+      };
+      ncand++;
+   };
+
+   // exploring the candidates
+   found = false;
+   for (k = 0; k < ncand && !found; k++)
+   {
+      if (!orderReferences(o,cand[k]))  continue;
+      placeVertex(o,cand[k]);
+      if (!orderDeadEnd(o))  found = searchDMDGP(o);
+      if (!found)  unplaceVertex(o);
+   };
+   free(score);  free(cand);
+   return found;
+};
+
+// this function evaluates an order of the vertices
+// -> ninterval is the number of vertices having less than 3 exact distances to the previous ones
+// -> the returning value is the average layer of the pruning distances (the distances to the previous vertices
+//    in addition to the 3 necessary for the discretization), or n if there are no pruning distances
+double orderQuality(VORDER *o,int *order,int *ninterval)
+{
+   int h,k,x,c,ce,*rank;
+   double sum,npruning;
+
+   rank = (int*)calloc(o->n,sizeof(int));
+   for (k = 0; k < o->n; k++)  rank[order[k]] = k;
+   (*ninterval) = 0;
+   sum = 0.0;  npruning = 0.0;
+   for (k = 3; k < o->n; k++)
+   {
+      x = order[k];
+      c = 0;  ce = 0;
+      for (h = o->start[x]; h < o->start[x+1]; h++)
+      {
+         if (rank[o->adj[h]] >= k)  continue;
+         c++;
+         if (o->exact[h])  ce++;
+      };
+      if (ce < 3)  (*ninterval)++;
+      if (c > 3)
+      {
+         sum = sum + (double)k*(c - 3);
+         npruning = npruning + (c - 3);
+      };
+   };
+   free(rank);
+   if (npruning == 0.0)  return (double)o->n;
+   return sum/npruning;
+};
+
+// this function looks for a DDGP order (or a DMDGP order if consec is true) of the vertices of an instance
+// -> the initial cliques are tried by increasing number of distances of their vertices (the vertices at the ends
+//    of a chain have less distances, and a DMDGP order can only start at one end); the search for a DMDGP order
+//    from one initial clique is limited to oattempt partial orders, and the whole search to obudget
+// -> order needs to be pre-allocated for n integers: order[k] is the vertex placed at rank k
+// -> the returning value is true if an order was found
+bool findOrder(int n,VERTEX *v,double eps,bool consec,int *order)
+{
+   int a,b,c,ha,hb,hc,k,p,t,tmp,norders,ninterval,bestinterval,ncliques,capacity;
+   int perm[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+   int *clique,*key;
+   long remaining;
+   double layer,bestlayer;
+   bool found;
+   VORDER *o;
+
+   if (n < 3)  return false;
+   o = newOrder(n,v,eps);
+
+   // all cliques of exact distances (a < b < c), sorted by number of distances of their vertices
+   ncliques = 0;  capacity = 1024;
+   clique = (int*)calloc(3*capacity,sizeof(int));
+   key = (int*)calloc(capacity,sizeof(int));
+   for (a = 0; a < n; a++)
+   {
+      for (ha = o->start[a]; ha < o->start[a+1]; ha++)
+      {
+         b = o->adj[ha];
+         if (b <= a || !o->exact[ha])  continue;
+         for (hb = o->start[b]; hb < o->start[b+1]; hb++)
+         {
+            c = o->adj[hb];
+            if (c <= b || !o->exact[hb])  continue;
+            hc = orderDistance(o,a,c);
+            if (hc < 0 || !o->exact[hc])  continue;
+            if (ncliques == capacity)
+            {
+               capacity = 2*capacity;
+               clique = (int*)realloc(clique,3*capacity*sizeof(int));
+               key = (int*)realloc(key,capacity*sizeof(int));
+            };
+            clique[3*ncliques] = a;  clique[3*ncliques+1] = b;  clique[3*ncliques+2] = c;
+            key[ncliques] = (o->start[a+1] - o->start[a]) + (o->start[b+1] - o->start[b]) + (o->start[c+1] - o->start[c]);
+            if (a == 0 && b == 1 && c == 2)  key[ncliques] = -1;
+            ncliques++;
+         };
+      };
+   };
+   for (k = 1; k < ncliques; k++)
+   {
+      for (t = k; t > 0 && key[t-1] > key[t]; t--)
+      {
+         tmp = key[t];  key[t] = key[t-1];  key[t-1] = tmp;
+         for (p = 0; p < 3; p++)
+         {
+            tmp = clique[3*t+p];  clique[3*t+p] = clique[3*(t-1)+p];  clique[3*(t-1)+p] = tmp;
+         };
+      };
+   };
+
+   // trying the initial cliques
+   norders = 0;
+   bestinterval = n;  bestlayer = (double)n;
+   remaining = obudget;
+   for (t = 0; t < ncliques && norders < omaxorders && remaining > 0L; t++)
+   {
+      // the order of the clique vertices only matters for the consecutivity assumption
+      for (p = 0; p < (consec ? 6 : 1) && norders < omaxorders && remaining > 0L; p++)
+      {
+         found = false;
+         for (o->rule = 0; o->rule < (consec ? 2 : 1) && !found && remaining > 0L; o->rule++)
+         {
+            clearOrder(o);
+            for (k = 0; k < 3; k++)  placeVertex(o,clique[3*t+perm[p][k]]);
+            if (consec)
+            {
+               o->budget = remaining < oattempt ? remaining : oattempt;
+               remaining = remaining - o->budget;
+               found = searchDMDGP(o);
+               remaining = remaining + o->budget;
+            }
+            else
+               found = greedyDDGP(o);
+         };
+         if (!found)  continue;
+
+         // comparing to the best found order (the first DMDGP order is kept)
+         norders++;
+         layer = orderQuality(o,o->order,&ninterval);
+         if (norders == 1 || ninterval < bestinterval || (ninterval == bestinterval && layer < bestlayer))
+         {
+            bestinterval = ninterval;  bestlayer = layer;
+            memcpy(order,o->order,n*sizeof(int));
+         };
+         if (consec)  norders = omaxorders;
+      };
+   };
+   free(key);  free(clique);
+   freeOrder(o);
+   return norders > 0;
+};
+
+// this function writes the instance with the vertices in a new order, in the same format of the input file
+// -> order[k] is the vertex placed at rank k; the vertex ids are the ranks in the new order (starting from n0)
+// -> format and sep are the format and the separator of the distance list (see readDistanceFile)
+// -> the returning value is a NULL char on success, and a char pointer to the error description otherwise
+char* writeOrderedInstance(INSTANCE *inst,int *order,unsigned long format,char sep,char *filename)
+{
+   int h,k,l,nf,nformat,x,y,tmp;
+   int *rank,*prev;
+   unsigned long f,cf;
+   char *error;
+   REFERENCE *ref;
+   FILE *output;
+   VORDER *o;
+
+   output = fopen(filename,"w");
+   if (output == NULL)
+   {
+      error = (char*)calloc(instlen+strlen(filename),sizeof(char));
+      sprintf(error,"mdjeep: error: cannot open file '%s' for writing the reordered instance",filename);
+      return error;
+   };
+
+   // number of bits used for the format
+   f = format;
+   nformat = 0;
+   while (f != 0UL)
+   {
+      nformat = nformat + 4;
+      f = f >> 4;
+   };
+
+   // the distances of every vertex to the previous ones in the new order, sorted by rank
+   o = newOrder(inst->n,inst->v,0.0);
+   rank = (int*)calloc(inst->n,sizeof(int));
+   prev = (int*)calloc(inst->n+1,sizeof(int));
+   for (k = 0; k < inst->n; k++)  rank[order[k]] = k;
+   for (k = 0; k < inst->n; k++)
+   {
+      x = order[k];
+      l = 0;
+      for (h = o->start[x]; h < o->start[x+1]; h++)
+      {
+         if (rank[o->adj[h]] > k)  continue;
+         prev[l] = h;
+         for (y = l; y > 0 && rank[o->adj[prev[y-1]]] > rank[o->adj[prev[y]]]; y--)
+         {
+            tmp = prev[y];  prev[y] = prev[y-1];  prev[y-1] = tmp;
+         };
+         l++;
+      };
+
+      // one line per distance (the vertex x is the first vertex)
+      for (h = 0; h < l; h++)
+      {
+         y = o->adj[prev[h]];
+         ref = o->ref[prev[h]];
+         for (nf = nformat - 4; nf >= 0; nf = nf - 4)
+         {
+            cf = (format >> nf) & 15UL;
+            if (cf == 6UL)
+               fprintf(output,"%d",inst->n0 + k);
+            else if (cf == 7UL)
+               fprintf(output,"%d",inst->n0 + rank[y]);
+            else if (cf == 8UL)
+               fprintf(output,"%d",inst->v[x].groupId);
+            else if (cf == 9UL)
+               fprintf(output,"%d",inst->v[y].groupId);
+            else if (cf == 10UL)
+               fprintf(output,"%s",inst->v[x].Name);
+            else if (cf == 11UL)
+               fprintf(output,"%s",inst->v[y].Name);
+            else if (cf == 12UL)
+               fprintf(output,"%s",inst->v[x].Group);
+            else if (cf == 13UL)
+               fprintf(output,"%s",inst->v[y].Group);
+            else if (cf == 14UL)
+               fprintf(output,"%.17g",lowerBound(ref));
+            else if (cf == 15UL)
+               fprintf(output,"%.17g",upperBound(ref));
+            else
+               fprintf(output,"0");
+            fprintf(output,"%c",nf > 0 ? sep : '\n');
+         };
+      };
+   };
+   free(prev);  free(rank);
+   freeOrder(o);
+
+   // closing
+   error = NULL;
+   if (ferror(output))  error = strdup("mdjeep: error while writing the reordered instance");
+   if (fclose(output) != 0 && error == NULL)  error = strdup("mdjeep: error while writing the reordered instance");
+   return error;
+};
+
+// this function writes a copy of the MDfile where the instance file is replaced by the reordered instance
+// -> the new order is reported in the comments at the beginning of the file
+// -> the returning value is a NULL char on success, and a char pointer to the error description otherwise
+char* writeOrderedMDfile(char *mdfile,char *outfile,char *instfile,INSTANCE *inst,int *order)
+{
+   int k;
+   size_t nlines,wordlen,linelen;
+   char *c,*line,*error;
+   FILE *input,*output;
+
+   input = fopen(mdfile,"r");
+   if (input == NULL)  return strdup("mdjeep: error: cannot open the MDfile again for writing its reordered copy");
+   output = fopen(outfile,"w");
+   if (output == NULL)
+   {
+      fclose(input);
+      error = (char*)calloc(instlen+strlen(outfile),sizeof(char));
+      sprintf(error,"mdjeep: error: cannot open file '%s' for writing the reordered MDfile",outfile);
+      return error;
+   };
+
+   // the new order
+   fprintf(output,"# vertex order found by mdjeep --order (new vertex id: original vertex id)\n");
+   for (k = 0; k < inst->n; k++)
+   {
+      if (k%8 == 0)  fprintf(output,"#");
+      fprintf(output," %d:%d",inst->n0 + k,getVertexId(inst->v[order[k]]));
+      if (k%8 == 7 || k == inst->n - 1)  fprintf(output,"\n");
+   };
+   fprintf(output,"\n");
+
+   // copying the MDfile (the instance file is replaced)
+   nlines = textFileAnalysis(input,' ',&wordlen,&linelen);
+   rewind(input);
+   line = (char*)calloc(linelen+2,sizeof(char));
+   while (nlines > 0 && fgets(line,linelen+2,input) != NULL)
+   {
+      removEndingChars(line);
+      c = line;
+      if (c[0] != '#' && !strncmp(c,"with",4))
+      {
+         c = nextNonBlank(c+4);
+         if (c != NULL && !strncmp(c,"file",4))
+         {
+            fprintf(output,"with file: %s\n",instfile);
+            continue;
+         };
+      };
+      fprintf(output,"%s\n",line);
+   };
+   free(line);
+   fclose(input);
+
+   // closing
+   error = NULL;
+   if (ferror(output))  error = strdup("mdjeep: error while writing the reordered MDfile");
+   if (fclose(output) != 0 && error == NULL)  error = strdup("mdjeep: error while writing the reordered MDfile");
+   return error;
+};
+
+// this function builds the name of a file written by orderInstance: "_ordered" is added before the extension
+char* orderedFileName(char *filename)
+{
+   char *base,*outfile;
+
+   base = removExtension(filename);
+   outfile = (char*)calloc(strlen(filename)+16,sizeof(char));
+   sprintf(outfile,"%s_ordered%s",base,filename+strlen(base));
+   free(base);
+   return outfile;
+};
+
+// this function looks for a new vertex order for the instance of an MDfile, and writes the reordered instance
+// -> a DMDGP order is required if consec is true, a DDGP order otherwise
+// -> the reordered instance and a copy of the MDfile are written with the suffix "_ordered" (see orderedFileName)
+// -> the returning value is a NULL char on success, and a char pointer to the error description otherwise
+char* orderInstance(char *mdfile,bool consec)
+{
+   int n,ninterval;
+   int *order;
+   double layer,eps;
+   char *errmsg,*instfile,*outfile;
+   FILE *input;
+   MDJEEP *md;
+   VORDER *o;
+
+   // reading the MDfile and the instance
+   input = fopen(mdfile,"r");
+   if (input == NULL)
+   {
+      errmsg = (char*)calloc(instlen+strlen(mdfile),sizeof(char));
+      sprintf(errmsg,"mdjeep: error while opening MDfile '%s'",mdfile);
+      return errmsg;
+   };
+   md = mdjeep_new();
+   errmsg = mdjeep_read_mdfile(md,input);
+   fclose(input);
+   if (errmsg == NULL)  errmsg = mdjeep_load_file(md,NULL);
+   if (errmsg != NULL)
+   {
+      mdjeep_free(md);
+      return errmsg;
+   };
+   n = md->inst.n;  eps = md->op.eps;
+   fprintf(stderr,"mdjeep: instance file '%s' read: %d vertices / %d distances\n",md->info.filename,n,md->inst.m);
+
+   // the given order
+   order = (int*)calloc(n > 0 ? n : 1,sizeof(int));
+   for (n = 0; n < md->inst.n; n++)  order[n] = n;
+   n = md->inst.n;
+   o = newOrder(n,md->inst.v,eps);
+   if (initialClique(n,md->inst.v,eps) && isDDGP(n,md->inst.v,eps,true) == 0)
+   {
+      layer = orderQuality(o,order,&ninterval);
+      fprintf(stderr,"mdjeep: the given order is discretizable (%s): %d vertices need an interval distance, "
+                     "pruning distances at layer %.1lf on average\n",isDMDGP(n,md->inst.v,eps,true) ? "DMDGP" : "DDGP",ninterval,layer);
+   }
+   else
+      fprintf(stderr,"mdjeep: the given order is not discretizable\n");
+
+   // looking for a new order
+   if (!findOrder(n,md->inst.v,eps,consec,order))
+   {
+      free(order);  freeOrder(o);  mdjeep_free(md);
+      if (consec)  return strdup("mdjeep: error: no DMDGP order was found for the instance");
+      return strdup("mdjeep: error: no DDGP order was found for the instance");
+   };
+   layer = orderQuality(o,order,&ninterval);
+   fprintf(stderr,"mdjeep: %s order found: %d vertices need an interval distance, pruning distances at layer %.1lf on average\n",
+                  consec ? "DMDGP" : "DDGP",ninterval,layer);
+   freeOrder(o);
+
+   // writing the reordered instance and MDfile
+   instfile = orderedFileName(md->info.filename);
+   outfile = orderedFileName(mdfile);
+   errmsg = writeOrderedInstance(&md->inst,order,md->info.format,md->info.sep,instfile);
+   if (errmsg == NULL)  errmsg = writeOrderedMDfile(mdfile,outfile,instfile,&md->inst,order);
+   if (errmsg == NULL)  fprintf(stderr,"mdjeep: reordered instance written in '%s', MDfile written in '%s'\n",instfile,outfile);
+   free(outfile);  free(instfile);
+   free(order);
+   mdjeep_free(md);
+   return errmsg;
+};
@@ -0,0 +1,187 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - pool of solutions
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (solutions stored as paths in the search tree)
+                                    paths over the layers of repetition orders (see repeat.c)
+                                    no pruning function during the replay
+                                    memory counted (see memory.c)
+************************************************************************************************************/
+
+#include "bp.h"
+
+extern double INFTY;
+
+// a solution found by bp is completely determined by the branch taken at every layer of the tree:
+// the sign of the omega angle for bp_exact (1 bit), the index of the omega sub-interval for bp;
+// the pool stores these branch indices with a fixed number of bits per layer, which is increased
+// (and the stored paths are packed again) when a larger index is found
+
+// this function creates an empty pool for a search tree with n layers (paths over the layers 3, ..., n-1)
+POOL* newPool(int n)
+{
+   POOL *p;
+
+   p = (POOL*)calloc(1,sizeof(POOL));
+   p->n = n - 3;
+   if (p->n < 0)  p->n = 0;
+   p->width = 1;
+   p->stride = (p->n + 7)/8;
+   p->size = 0;
+   p->capacity = 0;
+   p->paths = NULL;
+   memoryUsage(2,poolMemory(p));
+   return p;
+};
+
+// this function gives the memory of the pool (see memory.c)
+long poolMemory(POOL *p)
+{
+   return sizeof(POOL) + (long)p->capacity*p->stride;
+};
+
+// this function removes all solutions from the pool (the memory is kept for the next run)
+void clearPool(POOL *p)
+{
+   memoryUsage(2,-poolMemory(p));
+   p->size = 0;
+   p->width = 1;
+   p->stride = (p->n + 7)/8;
+   memoryUsage(2,poolMemory(p));
+};
+
+// this function frees the pool
+POOL* freePool(POOL *p)
+{
+   if (p == NULL)  return NULL;
+   memoryUsage(2,-poolMemory(p));
+   free(p->paths);
+   free(p);
+   return NULL;
+};
+
+// this function writes the branch index b for layer l in a packed path of the given width
+void setPathBits(unsigned char *path,int width,int l,int b)
+{
+   int k;
+   size_t bit;
+
+   bit = (size_t)l*width;
+   for (k = 0; k < width; k++, bit++)
+   {
+      if ((b >> k) & 1)
+         path[bit >> 3] |= (unsigned char)(1 << (bit & 7));
+      else
+         path[bit >> 3] &= (unsigned char)~(1 << (bit & 7));
+   };
+};
+
+// this function reads the branch index for layer l in a packed path of the given width
+int getPathBits(unsigned char *path,int width,int l)
+{
+   int k,b;
+   size_t bit;
+
+   b = 0;
+   bit = (size_t)l*width;
+   for (k = 0; k < width; k++, bit++)  b = b | (((path[bit >> 3] >> (bit & 7)) & 1) << k);
+   return b;
+};
+
+// this function packs again all stored paths with a larger number of bits per layer
+void widenPool(POOL *p,int width)
+{
+   int k,l;
+   size_t stride;
+   unsigned char *paths;
+
+   memoryUsage(2,-poolMemory(p));
+   stride = ((size_t)p->n*width + 7)/8;
+   paths = (unsigned char*)calloc(p->capacity > 0 ? (size_t)p->capacity*stride : 1,sizeof(unsigned char));
+   for (k = 0; k < p->size; k++)
+   {
+      for (l = 0; l < p->n; l++)
+      {
+         setPathBits(paths+k*stride,width,l,getPathBits(p->paths+k*p->stride,p->width,l));
+      };
+   };
+   free(p->paths);
+   p->paths = paths;
+   p->width = width;
+   p->stride = stride;
+   memoryUsage(2,poolMemory(p));
+};
+
+// this function adds a solution to the pool
+// -> path contains the branch index at every layer of the tree (path[i] for the vertex i, with i from 3 to n-1)
+void addToPool(POOL *p,int *path)
+{
+   int l,b,width;
+
+   // number of bits necessary for the largest branch index
+   b = 0;
+   for (l = 0; l < p->n; l++)  if (path[l+3] > b)  b = path[l+3];
+   width = p->width;
+   while ((b >> width) != 0)  width++;
+   if (width > p->width)  widenPool(p,width);
+
+   // enlarging the pool
+   if (p->size == p->capacity)
+   {
+      memoryUsage(2,-poolMemory(p));
+      p->capacity = 2*p->capacity + 1024;
+      p->paths = (unsigned char*)realloc(p->paths,(size_t)p->capacity*p->stride);
+      memoryUsage(2,poolMemory(p));
+   };
+
+   // packing the path
+   for (l = 0; l < p->n; l++)  setPathBits(p->paths+p->size*p->stride,p->width,l,path[l+3]);
+   p->size++;
+};
+
+// this function extracts the path of the solution k (from 0 to size-1) from the pool
+// -> path needs to contain at least n integers (path[i] for the vertex i, with i from 3 to n-1)
+void getPath(POOL *p,int k,int *path)
+{
+   int l;
+
+   for (l = 0; l < p->n; l++)  path[l+3] = getPathBits(p->paths+k*p->stride,p->width,l);
+};
+
+// this function rebuilds a solution from its path, by running bp along the path only
+// -> X contains the rebuilt solution, S is the SEARCH structure with pre-allocated memory (see allocateSearch)
+// -> op and info are the ones of the run that found the solution (they are not modified)
+// -> the rebuilt solution is identical to the found one when the coordinates only depend on the path: this is
+//    the case for bp_exact, and for bp without refinement; otherwise the refinement is performed along the path
+//    only (during the search, it was also performed in the branches explored before), so that the rebuilt
+//    solution is in the same branches of the tree but its coordinates (and its LDE and MDE) may be different
+// -> when some vertices are repeated (see repeat.c), the copies are removed from the rebuilt solution
+// -> the returning value is false if the replay was interrupted (time limit or ^C)
+bool rebuildSolution(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION info,int *path)
+{
+   op.print = 0;  op.monitor = false;  op.allone = 1;
+   info.nsols = 0;  info.maxsols = 1;  info.pruning = 0;
+   info.nspg = 0;  info.nspgok = 0;  info.nstress = 0;
+   info.best_sol = 0;  info.best_mde = INFTY;  info.best_lde = INFTY;
+   info.solution = NULL;  info.feasible = NULL;  info.writer = NULL;  info.pool = NULL;  info.dedup = NULL;
+   info.topk = NULL;  info.cluster = NULL;
+   S.refs = inst->refs;
+   S.sym = inst->sym;
+   S.edges = inst->edges;
+   S.ahead = inst->ahead;
+   S.rep = inst->rep;
+   S.vsol = inst->v;
+   S.replay = path;
+   if (info.exact && inst->vrep != NULL)
+   {
+      bp_exact(0,inst->nrep,inst->vrep,X,S,op,&info);
+      contractSolution(inst->nrep,inst->rep,X,X);
+   }
+   else if (info.exact)
+      bp_exact(0,inst->n,inst->v,X,S,op,&info);
+   else
+      bp(0,inst->n,inst->v,X,S,op,&info);
+   return info.nsols == 1;
+};
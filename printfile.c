@@ -9,65 +9,169 @@
               Jul 28 2019  v.0.3.0  generic function "printfile" added, some modifications on "printpdb"
               Mar 21 2020  v.0.3.1  no changes
               May 19 2020  v.0.3.2  undefined vertex attributes are not printed
+              Oct 18 2026  v.0.3.3  functions writing on an open stream (used by the asynchronous writer)
+                                    errors while opening the output files do not abort the execution
+                                    binary trajectory files (writing, and conversion to XYZ and PDB)
 *********************************************************************************************************/
 
 #include "bp.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// output file name: filename with the given extension (the returned string needs to be freed)
+char* outputFileName(char *filename,char *extension)
+{
+   char *outfile;
+
+   outfile = (char*)calloc(strlen(filename)+strlen(extension)+2,sizeof(char));
+   sprintf(outfile,"%s.%s",filename,extension);
+   return outfile;
+};
+
+// vertex attributes written before the coordinates on every line of the output files
+// (they do not change from one solution to another, so that they can be formatted only once)
+// -> format is 0 for XYZ (see printfile) and 1 for PDB (see printpdb)
+// -> the returning value is an array of n strings (to be freed with freePrefixes)
+char** vertexPrefixes(int n,VERTEX *v,int format)
+{
+   int i;
+   int groupId;
+   bool group;
+   char **prefix;
+
+   // groupId will not be printed if it always contain the same value
+   group = false;  groupId = v[0].groupId;
+   for (i = 1; i < n && !group; i++)  group = group || (groupId != v[i].groupId);
+
+   // formatting the vertex attributes
+   prefix = (char**)calloc(n,sizeof(char*));
+   for (i = 0; i < n; i++)
+   {
+      prefix[i] = (char*)calloc(strlen(v[i].Name)+strlen(v[i].Group)+64,sizeof(char));
+      if (format == 0)
+      {
+         // Id
+         sprintf(prefix[i]," %d",v[i].Id);
+
+         // Name
+         if (strcmp(v[i].Name,"(no name)"))  sprintf(prefix[i]+strlen(prefix[i])," %s",v[i].Name);
+
+         // groupId
+         if (group)  sprintf(prefix[i]+strlen(prefix[i])," %d",v[i].groupId);
+
+         // Group
+         if (strcmp(v[i].Group,"(no group name)"))  sprintf(prefix[i]+strlen(prefix[i])," %s",v[i].Group);
+      }
+      else
+      {
+         // Id
+         sprintf(prefix[i],"%-6s%5d  ","ATOM",v[i].Id);
+
+         // atom code
+         if (strcmp(v[i].Name,"(no name)"))
+            sprintf(prefix[i]+strlen(prefix[i]),"%-4s",v[i].Name);
+         else
+            sprintf(prefix[i]+strlen(prefix[i]),"%-4s","XX");
+
+         // amino acid code
+         if (strcmp(v[i].Group,"(no group name)"))
+            sprintf(prefix[i]+strlen(prefix[i]),"%-3s ",v[i].Group);
+         else
+            sprintf(prefix[i]+strlen(prefix[i]),"%-3s ","UNK");
+
+         // other info
+         sprintf(prefix[i]+strlen(prefix[i]),"%s%4d    ","A",v[i].groupId);
+      };
+   };
+   return prefix;
+};
+
+// frees the strings created by vertexPrefixes
+char** freePrefixes(int n,char **prefix)
+{
+   int i;
+
+   for (i = 0; i < n; i++)  free(prefix[i]);
+   free(prefix);
+   return NULL;
+};
+
+// writes one solution with the available vertex attributes on an open stream
+// -> prefix contains the vertex attributes (see vertexPrefixes)
+// (s=0 : only one solution in the file; solution number s>0 : multiple solutions in the same file)
+void writeXYZ(FILE *output,int n,char **prefix,double **X,int s)
+{
+   int i;
+
+   if (s != 0)  fprintf(output,"MODEL %d\n",s);
+   for (i = 0; i < n; i++)
+   {
+      fputs(prefix[i],output);
+      fprintf(output," %13.9lf %13.9lf %13.9lf\n",X[0][i],X[1][i],X[2][i]);
+   };
+};
+
+// writes one solution in PDB format on an open stream
+// -> prefix contains the vertex attributes (see vertexPrefixes)
+// (s=0 : only one solution in the file; solution number s>0 : multiple solutions in the same file)
+// -> the header is written for s < 2 (new file), outfile is the file name reported in the header
+void writePDB(FILE *output,int n,char **prefix,double **X,int s,char *outfile)
+{
+   int i;
+
+   // writing header file (only if new file or overwriting)
+   if (s < 2)
+   {
+      fprintf(output,"HEADER      MD-jeep version 0.3.2\n");
+      fprintf(output,"REMARK   1 \n");
+      fprintf(output,"REMARK   1  Branch and Prune for Discretizable Distance Geometry\n");
+      fprintf(output,"REMARK   1 \n");
+      fprintf(output,"REMARK   1  by: Mucherino, Goncalves, Lavor, Liberti, Lin, Maculan\n");
+      fprintf(output,"REMARK   1 \n");
+      fprintf(output,"REMARK   1  filename: '%s'\n",outfile);
+      fprintf(output,"REMARK   1 \n");
+   };
+
+   // writing the PDB model
+   if (s != 0)  fprintf(output,"MODEL%9d\n",s);
+   for (i = 0; i < n; i++)
+   {
+      fputs(prefix[i],output);
+      fprintf(output,"%8.3f%8.3f%8.3f \n",X[0][i],X[1][i],X[2][i]);
+   };
+   if (s != 0)  fprintf(output,"ENDMDL%8d\n",s);
+};
 
 // print solutions with the available vertex attributes in a text file
 // (s=0 : prints only one solution; solution number s>0 : prints multiple solutions in the same file)
 void printfile(int n,VERTEX *v,double **X,char *filename,int s)
 {
-   int i,k;
-   int groupId;
    char *outfile;
-   bool group;
+   char **prefix;
    FILE *output;
 
    // if n is not positive, there is nothing to print
    if (n <= 0)  return;
 
-   // file name (txt extension)
-   outfile = (char*)calloc(strlen(filename)+5,sizeof(char));
-   for (k = 0; k < strlen(filename); k++)  outfile[k] = filename[k];
-   outfile[k] = '.';  k++;
-   outfile[k] = 't';  k++;
-   outfile[k] = 'x';  k++;
-   outfile[k] = 't';
-
    // opening output file (rewriting or appending)
+   outfile = outputFileName(filename,"txt");
    if (s < 2)
       output = fopen(outfile,"w");
    else
       output = fopen(outfile,"a");
    if (output == NULL)
    {
-      fprintf(stderr,"printfile: error while opening file '%s' to write\n",filename);
-      abort();
+      fprintf(stderr,"printfile: error while opening file '%s' to write\n",outfile);
+      free(outfile);
+      return;
    };
 
-   // groupId will not be printed if it always contain the same value
-   group = false;  groupId = v[0].groupId;
-   for (i = 1; i < n && !group; i++)  group = group || (groupId != v[i].groupId);
- 
    // writing file
-   if (s != 0)  fprintf(output,"MODEL %d\n",s);
-   for (i = 0; i < n; i++)
-   {
-      // Id
-      fprintf(output," %d",v[i].Id);
-
-      // Name
-      if (strcmp(v[i].Name,"(no name)"))  fprintf(output," %s",v[i].Name);
-
-      // groupId
-      if (group)  fprintf(output," %d",v[i].groupId);
-
-      // Group
-      if (strcmp(v[i].Group,"(no group name)"))  fprintf(output," %s",v[i].Group);
-
-      // coordinates
-      fprintf(output," %13.9lf %13.9lf %13.9lf\n",X[0][i],X[1][i],X[2][i]);
-   };
+   prefix = vertexPrefixes(n,v,0);
+   writeXYZ(output,n,prefix,X,s);
+   freePrefixes(n,prefix);
    fclose(output);
    free(outfile);
 };
@@ -76,71 +180,314 @@ void printfile(int n,VERTEX *v,double **X,char *filename,int s)
 // (s=0 : prints only one solution; solution number s>0 : prints multiple solutions in the same file)
 void printpdb(int n,VERTEX *v,double **X,char *filename,int s)
 {
-   int i,k;
    char *outfile;
+   char **prefix;
    FILE *output;
 
    // if n is not positive, there is nothing to print
    if (n <= 0)  return;
 
-   // file name (pdb extension)
-   outfile = (char*)calloc(strlen(filename)+5,sizeof(char));
-   for (k = 0; k < strlen(filename); k++)  outfile[k] = filename[k];
-   outfile[k] = '.';  k++;
-   outfile[k] = 'p';  k++;
-   outfile[k] = 'd';  k++;
-   outfile[k] = 'b';
-
    // opening output file (rewriting or appending)
+   outfile = outputFileName(filename,"pdb");
    if (s < 2)
       output = fopen(outfile,"w");
    else
       output = fopen(outfile,"a");
    if (output == NULL)
    {
-      fprintf(stderr,"printfile: error while opening file '%s' to write\n",filename);
-      abort();
+      fprintf(stderr,"printfile: error while opening file '%s' to write\n",outfile);
+      free(outfile);
+      return;
    };
 
+   // writing file
+   prefix = vertexPrefixes(n,v,1);
+   writePDB(output,n,prefix,X,s,outfile);
+   freePrefixes(n,prefix);
+   fclose(output);
+   free(outfile);
+};
+
+// binary trajectory files (extension "mdt") contain all solutions of one run: the vertex attributes are stored
+// only once in the header, and every solution is stored in a frame of fixed size, so that the files can be
+// appended and directly read through mmap (frame k begins at hsize + k*fsize, see MDTHEADER)
+// -> header : MDTHEADER, n vertex records (MDTVERTEX), string table with the vertex names and groups
+// -> frame  : MDTFRAME, followed by the coordinates (float or double) stored row by row
+// -> header and frames are padded to multiples of 8 bytes; integers and reals are in the byte order of the writer
+
+// size of the frames in a binary trajectory file with n vertices and coordinates of the given size
+int64_t trajectoryFrameSize(int n,int precision)
+{
+   int64_t size;
+
+   size = sizeof(MDTFRAME) + 3*(int64_t)n*precision;
+   return (size + 7)/8*8;
+};
+
+// writes one solution in the binary trajectory format on an open stream
+// -> precision is the size of the coordinates (4 = float, 8 = double)
+// -> the header is written for s < 2 (new file), with the number of vertices of this solution
+void writeMDT(FILE *output,int n,VERTEX *v,double **X,int s,double lde,double mde,int precision)
+{
+   int i,j,k,h;
+   int32_t offset;
+   int64_t size;
+   float buffer[256];
+   char zero[8] = {0};
+   MDTHEADER header;
+   MDTVERTEX vertex;
+   MDTFRAME frame;
+
    // writing header file (only if new file or overwriting)
    if (s < 2)
    {
-      fprintf(output,"HEADER      MD-jeep version 0.3.2\n");
-      fprintf(output,"REMARK   1 \n");
-      fprintf(output,"REMARK   1  Branch and Prune for Discretizable Distance Geometry\n");
-      fprintf(output,"REMARK   1 \n");
-      fprintf(output,"REMARK   1  by: Mucherino, Goncalves, Lavor, Liberti, Lin, Maculan\n");
-      fprintf(output,"REMARK   1 \n");
-      fprintf(output,"REMARK   1  filename: '%s'\n",outfile);
-      fprintf(output,"REMARK   1 \n");
+      size = 0;
+      for (i = 0; i < n; i++)  size = size + strlen(v[i].Name) + strlen(v[i].Group) + 2;
+      memset(&header,0,sizeof(MDTHEADER));
+      strcpy(header.magic,"MDJEEPT");
+      header.order = 0x01020304;
+      header.version = 1;
+      header.precision = precision;
+      header.n = n;
+      header.hsize = (sizeof(MDTHEADER) + n*sizeof(MDTVERTEX) + size + 7)/8*8;
+      header.fsize = trajectoryFrameSize(n,precision);
+      fwrite(&header,sizeof(MDTHEADER),1,output);
+
+      // vertex records
+      offset = 0;
+      for (i = 0; i < n; i++)
+      {
+         vertex.Id = v[i].Id;
+         vertex.groupId = v[i].groupId;
+         vertex.Name = offset;
+         offset = offset + strlen(v[i].Name) + 1;
+         vertex.Group = offset;
+         offset = offset + strlen(v[i].Group) + 1;
+         fwrite(&vertex,sizeof(MDTVERTEX),1,output);
+      };
+
+      // string table
+      for (i = 0; i < n; i++)
+      {
+         fwrite(v[i].Name,1,strlen(v[i].Name)+1,output);
+         fwrite(v[i].Group,1,strlen(v[i].Group)+1,output);
+      };
+      fwrite(zero,1,header.hsize - sizeof(MDTHEADER) - n*sizeof(MDTVERTEX) - size,output);
    };
 
-   // writing the PDB model
-   if (s != 0)  fprintf(output,"MODEL%9d\n",s);
-   for (i = 0; i < n; i++)
+   // writing the frame
+   frame.s = s;  frame.n = n;
+   frame.lde = lde;  frame.mde = mde;
+   fwrite(&frame,sizeof(MDTFRAME),1,output);
+   for (k = 0; k < 3; k++)
    {
-      // Id
-      fprintf(output,"%-6s%5d  ","ATOM",v[i].Id);
-
-      // atom code
-      if (strcmp(v[i].Name,"(no name)"))
-         fprintf(output,"%-4s",v[i].Name);
+      if (precision == 8)
+      {
+         fwrite(X[k],sizeof(double),n,output);
+      }
       else
-         fprintf(output,"%-4s","XX");
+      {
+         for (i = 0; i < n; i = i + 256)
+         {
+            h = n - i;
+            if (h > 256)  h = 256;
+            for (j = 0; j < h; j++)  buffer[j] = (float) X[k][i+j];
+            fwrite(buffer,sizeof(float),h,output);
+         };
+      };
+   };
+   fwrite(zero,1,trajectoryFrameSize(n,precision) - sizeof(MDTFRAME) - 3*(int64_t)n*precision,output);
+};
 
-      // amino acid code
-      if (strcmp(v[i].Group,"(no group name)"))
-         fprintf(output,"%-3s ",v[i].Group);
-      else
-         fprintf(output,"%-3s ","UNK");
+// print solutions in a binary trajectory file
+// (s=0 : only one solution in the file; solution number s>0 : multiple solutions in the same file)
+// -> eps is the tolerance used for computing LDE and MDE, precision is the size of the coordinates (see writeMDT)
+void printmdt(int n,VERTEX *v,double **X,char *filename,int s,double eps,int precision)
+{
+   char *outfile;
+   FILE *output;
 
-      // other info, including coordinates
-      fprintf(output,"%s%4d    %8.3f%8.3f%8.3f \n","A",v[i].groupId,X[0][i],X[1][i],X[2][i]);
+   // if n is not positive, there is nothing to print
+   if (n <= 0)  return;
+
+   // opening output file (rewriting or appending)
+   outfile = outputFileName(filename,"mdt");
+   if (s < 2)
+      output = fopen(outfile,"w");
+   else
+      output = fopen(outfile,"a");
+   if (output == NULL)
+   {
+      fprintf(stderr,"printmdt: error while opening file '%s' to write\n",outfile);
+      free(outfile);
+      return;
    };
-   if (s != 0)  fprintf(output,"ENDMDL%8d\n",s);
 
-   // ending
+   // writing file
+   writeMDT(output,n,v,X,s,compute_lde(n,v,X,eps),compute_mde(n,v,X,eps),precision);
    fclose(output);
    free(outfile);
 };
 
+// converts a binary trajectory file to a text file in XYZ (format 0) or PDB (format 1) format
+// -> the text file has the name of the trajectory file, with extension "txt" or "pdb"
+// -> the returning value is NULL on success, and an allocated error message otherwise
+char* convertTrajectory(char *trajfile,int format)
+{
+   int i,j,k,fn,nframes;
+   int fd;
+   int64_t size,strsize;
+   char *map,*strings;
+   char *base,*outfile;
+   char *error;
+   char **prefix,**fprefix;
+   double **X,**Y;
+   float *coords;
+   MDTHEADER *header;
+   MDTVERTEX *record;
+   MDTFRAME *frame;
+   VERTEX *v;
+   struct stat st;
+   FILE *output;
+
+   // mapping the trajectory file in memory
+   error = (char*)calloc(strlen(trajfile)+200,sizeof(char));
+   fd = open(trajfile,O_RDONLY);
+   if (fd < 0 || fstat(fd,&st) < 0)
+   {
+      sprintf(error,"mdjeep: error while opening trajectory file '%s' (%s)",trajfile,strerror(errno));
+      if (fd >= 0)  close(fd);
+      return error;
+   };
+   size = st.st_size;
+   map = NULL;
+   if (size >= sizeof(MDTHEADER))  map = (char*)mmap(NULL,size,PROT_READ,MAP_PRIVATE,fd,0);
+   close(fd);
+   if (map == NULL || map == MAP_FAILED)
+   {
+      sprintf(error,"mdjeep: error: '%s' is not a binary trajectory file",trajfile);
+      return error;
+   };
+
+   // verifying the header
+   header = (MDTHEADER*)map;
+   if (strcmp(header->magic,"MDJEEPT"))
+      sprintf(error,"mdjeep: error: '%s' is not a binary trajectory file",trajfile);
+   else if (header->order != 0x01020304)
+      sprintf(error,"mdjeep: error: trajectory file '%s' was written on a machine with a different byte order",trajfile);
+   else if (header->version != 1)
+      sprintf(error,"mdjeep: error: trajectory file '%s' has an unknown version (%d)",trajfile,header->version);
+   else if ((header->precision != 4 && header->precision != 8) || header->n <= 0
+         || header->fsize != trajectoryFrameSize(header->n,header->precision)
+         || header->hsize < sizeof(MDTHEADER) + header->n*sizeof(MDTVERTEX) || header->hsize > size)
+      sprintf(error,"mdjeep: error: trajectory file '%s' has a corrupted header",trajfile);
+   if (error[0] != '\0')
+   {
+      munmap(map,size);
+      return error;
+   };
+
+   // vertex attributes (names and groups are kept in the mapped string table)
+   record = (MDTVERTEX*)(map + sizeof(MDTHEADER));
+   strings = (char*)(record + header->n);
+   strsize = header->hsize - sizeof(MDTHEADER) - header->n*sizeof(MDTVERTEX);
+   v = (VERTEX*)calloc(header->n,sizeof(VERTEX));
+   for (i = 0; i < header->n && error[0] == '\0'; i++)
+   {
+      v[i].Id = record[i].Id;
+      v[i].groupId = record[i].groupId;
+      if (record[i].Name < 0 || record[i].Name >= strsize || record[i].Group < 0 || record[i].Group >= strsize
+       || memchr(strings+record[i].Name,'\0',strsize-record[i].Name) == NULL
+       || memchr(strings+record[i].Group,'\0',strsize-record[i].Group) == NULL)
+      {
+         sprintf(error,"mdjeep: error: trajectory file '%s' has a corrupted header",trajfile);
+      }
+      else
+      {
+         v[i].Name = strings + record[i].Name;
+         v[i].Group = strings + record[i].Group;
+      };
+   };
+   if (error[0] != '\0')
+   {
+      free(v);
+      munmap(map,size);
+      return error;
+   };
+
+   // opening the output file
+   base = removExtension(trajfile);
+   if (format == 0)
+      outfile = outputFileName(base,"txt");
+   else
+      outfile = outputFileName(base,"pdb");
+   free(base);
+   output = fopen(outfile,"w");
+   if (output == NULL)
+   {
+      free(error);
+      error = (char*)calloc(strlen(outfile)+200,sizeof(char));
+      sprintf(error,"mdjeep: error while opening file '%s' to write (%s)",outfile,strerror(errno));
+      free(outfile);
+      free(v);
+      munmap(map,size);
+      return error;
+   };
+
+   // converting the frames (a frame truncated at the end of the file is ignored)
+   prefix = vertexPrefixes(header->n,v,format);
+   X = (double**)calloc(3,sizeof(double*));
+   Y = NULL;
+   if (header->precision == 4)  Y = allocateMatrix(3,header->n);
+   nframes = (size - header->hsize)/header->fsize;
+   for (k = 0; k < nframes && error[0] == '\0'; k++)
+   {
+      frame = (MDTFRAME*)(map + header->hsize + k*header->fsize);
+      fn = frame->n;
+      if (fn <= 0 || fn > header->n)
+      {
+         sprintf(error,"mdjeep: error: frame %d of trajectory file '%s' is corrupted",k+1,trajfile);
+         break;
+      };
+
+      // coordinates (in the mapped memory for double precision)
+      for (i = 0; i < 3; i++)
+      {
+         if (header->precision == 8)
+         {
+            X[i] = (double*)(frame + 1) + i*fn;
+         }
+         else
+         {
+            coords = (float*)(frame + 1) + i*fn;
+            for (j = 0; j < fn; j++)  Y[i][j] = coords[j];
+            X[i] = Y[i];
+         };
+      };
+
+      // the vertex attributes of partial solutions are formatted again (see writeQueued)
+      fprefix = prefix;
+      if (fn < header->n)  fprefix = vertexPrefixes(fn,v,format);
+      if (format == 0)
+         writeXYZ(output,fn,fprefix,X,frame->s);
+      else
+         writePDB(output,fn,fprefix,X,frame->s,outfile);
+      if (fprefix != prefix)  freePrefixes(fn,fprefix);
+   };
+   if (ferror(output) && error[0] == '\0')  sprintf(error,"mdjeep: error while writing the converted trajectory");
+   if (fclose(output) != 0 && error[0] == '\0')  sprintf(error,"mdjeep: error while writing the converted trajectory");
+
+   // freeing memory
+   freePrefixes(header->n,prefix);
+   free(X);
+   if (Y != NULL)  freeMatrix(3,Y);
+   free(outfile);
+   free(v);
+   munmap(map,size);
+   if (error[0] == '\0')
+   {
+      free(error);
+      error = NULL;
+   };
+   return error;
+};
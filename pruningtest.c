@@ -11,6 +11,9 @@
               Mar 21 2020  v.0.3.1  function BoxDDF added
               May 19 2020  v 0.3.2  DDF and BoxDDF now output the partial error
                                     BoxDDF uses the function box_distance (distance.c)
+              Oct 18 2026  v.0.3.3  function LookAheadDDF added (bounds implied by the next vertices)
+                                    function BoundedDDF added (selection of the triplets in bp_exact)
+                                    function BoxLookAheadDDF added (look-ahead pruning device in bp)
 ******************************************************************************************************/
 
 #include "bp.h"
@@ -43,6 +46,107 @@ double DDF(int id,VERTEX *v,double **X)
    return error;
 };
 
+// Direct Distance Feasibility with a bound on the partial error (see DDF)
+// -> the computation stops when the partial error is larger than bound: the returning value is then larger than
+//    bound, but it may be smaller than the one given by DDF (the terms of the partial error are non-negative)
+// -> otherwise, the returning value is the one given by DDF (the operations are performed in the same order)
+double BoundedDDF(int id,VERTEX *v,double **X,double bound)
+{
+   int n,m;
+   double error,dist,diff;
+   REFERENCE *ref;
+
+   // normalization factor (see DDF)
+   m = numberOfDistances(v[id].ref);
+
+   // collecting distances and verifying error
+   n = 0;  error = 0.0;
+   for (ref = v[id].ref; ref != NULL; ref = ref->next)
+   {
+      n++;
+      dist = distance(otherVertexId(ref),id,X);
+      diff = lowerBound(ref) - dist;  if (diff > 0.0)  error = error + diff;  // only one of the two
+      diff = dist - upperBound(ref);  if (diff > 0.0)  error = error + diff;  // per time can be true
+      if (error/m > bound)  return error/m;
+   };
+
+   // normalizing over the number of reference distances
+   if (n != 0)  error = error/n;
+
+   return error;
+};
+
+// Direct Distance Feasibility on a complete realization
+// -> n is the number of vertices, v is the set of VERTEX structures, and X is the realization
+// -> SolutionDDF outputs the largest partial error given by DDF over all vertices: a realization whose value is
+//    smaller than the tolerance would not be pruned at any layer by bp (its vertices satisfy the distances as the
+//    ones of the solutions found by bp)
+double SolutionDDF(int n,VERTEX *v,double **X)
+{
+   int i;
+   double err,maxerr;
+
+   maxerr = 0.0;
+   for (i = 0; i < n; i++)
+   {
+      err = DDF(i,v,X);
+      if (err > maxerr)  maxerr = err;
+   };
+   return maxerr;
+};
+
+// Look-Ahead Direct Distance Feasibility pruning device
+// -> id is the vertex id for which it is necessary to verify the bounds implied by the vertices placed later
+// -> la contains the implied bounds (see lookahead.c), and X is the current conformation
+// -> LookAheadDDF outputs the partial error on the implied bounds related to the vertex id (as DDF)
+double LookAheadDDF(int id,LOOKAHEAD *la,double **X)
+{
+   int h,n;
+   double error,dist,diff;
+
+   // collecting distances and verifying error
+   n = 0;  error = 0.0;
+   for (h = la->start[id]; h < la->start[id+1]; h++)
+   {
+      n++;
+      dist = distance(la->other[h],id,X);
+      diff = la->lb[h] - dist;  if (diff > 0.0)  error = error + diff;
+      diff = dist - la->ub[h];  if (diff > 0.0)  error = error + diff;
+   };
+
+   // normalizing over the number of implied bounds
+   if (n != 0)  error = error/n;
+
+   return error;
+};
+
+// Box Look-Ahead Direct Distance Feasibility pruning device
+// -> id is the vertex id for which it is necessary to verify the bounds implied by the vertices placed later
+// -> la contains the implied bounds (see lookahead.c), and [lX,uX] is the set of boxes up to vertex id
+// -> BoxLookAheadDDF outputs the partial error on the implied bounds related to the vertex id, where the
+//    distances are the ones between the boxes (as BoxDDF)
+double BoxLookAheadDDF(int id,LOOKAHEAD *la,double **lX,double **uX)
+{
+   int h,n;
+   double error,diff;
+   double min,max;
+
+   // collecting distances and verifying error
+   n = 0;  error = 0.0;
+   for (h = la->start[id]; h < la->start[id+1]; h++)
+   {
+      n++;
+      min = box_distance(id,la->other[h],lX,uX,&max);
+      diff = la->lb[h] - max;  if (diff > 0.0)  error = error + diff;
+      diff = min - la->ub[h];  if (diff > 0.0)  error = error + diff;
+   };
+
+   // normalizing over the number of implied bounds
+   if (n != 0)  error = error/n;
+
+   return error;
+};
+
 // Box Direct Distance Feasibility pruning device
 // -> id is the vertex id whose box needs to be verified for feasibility
 // -> v is the set of VERTEX structures (with size > id), and [lX,uX] is the set of boxes up to vertex id
@@ -5,6 +5,12 @@
   Sources:    ansi C
   License:    GNU General Public License v.3
   History:    May 19 2020  v.0.3.2 introduced in this version
+              Oct 18 2026  v.0.3.3 default MDfile attributes set up in a separate function
+                                   lbfgsb can be selected as main method and as refinement method
+                                   smacof can be selected as main method
+                                   built-in starting points 'mds' and 'random' (startpoint is optional)
+                                   no memory leaks on lines not containing distances (readDistanceFile)
+                                   attribute precision (spg in single precision, with a polish in double precision)
 *************************************************************************************************************/
 
 #include "bp.h"
@@ -66,6 +72,32 @@ size_t textFileAnalysis(FILE *input,char sep,size_t *wordlen,size_t *linelen)
    return nlines;
 };
 
+// this function sets up the default values for the attributes that can be specified in the MDfile
+// -> the main method and the refinement method are not selected (-1)
+void defaultAttributes(OPTION *op,INFORMATION *info)
+{
+   info->name = NULL;
+   info->filename = NULL;
+   info->format = 0UL;
+   info->sep = ' ';  // default
+   info->start = NULL;
+   info->initial = 0;
+   info->method = -1;
+   info->refinement = -1;
+   op->r = 5.0;  // default (for bp)
+   op->eps = 0.001;  // default (for bp)
+   op->maxtime = 3600;  // default (for bp)
+   op->maxit = -1;
+   op->eta = 0.99;  // default (for spg)
+   op->gam = 1.e-4;  // default (for spg)
+   op->epsobj = 1.e-7;   // default (for spg)
+   op->epsg = 1.e-8;     // default (for spg)
+   op->epsalpha = 1.e-12; // default (for spg)
+   op->mumin = 1.e-12;    // default (for spg)
+   op->mumax = 1.e+12;    // default (for spg)
+   op->precision = 0;     // default (for spg)
+};
+
 // this function reads the MDfile and stores the information in the OPTION and INFORMATION structures
 // -> the input needs to be a valid file pointer
 // -> the returning value is a NULL char on success;
@@ -94,23 +126,7 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
    error = (char*)calloc(errlen,sizeof(char));
 
    // initializing the mandatory variables (in info and op, some of them double-checked after reading the file)
-   info->filename = NULL;
-   info->format = 0UL;
-   info->sep = ' ';  // default
-   info->start = NULL;
-   info->method = -1;
-   info->refinement = -1;
-   op->r = 5.0;  // default (for bp)
-   op->eps = 0.001;  // default (for bp)
-   op->maxtime = 3600;  // default (for bp)
-   op->maxit = -1;
-   op->eta = 0.99;  // default (for spg)
-   op->gam = 1.e-4;  // default (for spg)
-   op->epsobj = 1.e-7;   // default (for spg)
-   op->epsg = 1.e-8;     // default (for spg)
-   op->epsalpha = 1.e-12; // default (for spg)
-   op->mumin = 1.e-12;    // default (for spg)
-   op->mumax = 1.e+12;    // default (for spg)
+   defaultAttributes(op,info);
 
    // reading the MDfile
    last = -1;  count = 0;
@@ -165,6 +181,14 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
                   {
                      info->method = 1;  // spg
                   }
+                  else if (!strcmp(c,"lbfgsb"))
+                  {
+                     info->method = 2;  // lbfgsb
+                  }
+                  else if (!strcmp(c,"smacof"))
+                  {
+                     info->method = 3;  // smacof
+                  }
                   else
                   {
                      sprintf(error,"mdjeep: error while reading MDfile: '%s' is an unknown method",c);
@@ -193,6 +217,10 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
                   else if (!strcmp(c,"spg"))
                   {
                      info->refinement = 1;  // spg
+                  }
+                  else if (!strcmp(c,"lbfgsb"))
+                  {
+                     info->refinement = 2;  // lbfgsb
                   };
                }
                else if (!strncmp(c,"with",4))
@@ -390,16 +418,16 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
                            free(line);  return error;
                         };
                      }
-                     else if (!strncmp(c,"startpoint",10))  // startpoint (spg)
+                     else if (!strncmp(c,"startpoint",10))  // startpoint (spg, lbfgsb and smacof)
                      {
-                        if (info->method != 1)
+                        if (info->method < 1)
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: startpoint at line %d is not an attribute of the method",count);
                            free(line);  return error;
                         };
                         if (last == 2)
                         {
-                           sprintf(error,"mdjeep: error while reading MDfile: startpoint at line %d cannot be set up when spg is refinement method",count);
+                           sprintf(error,"mdjeep: error while reading MDfile: startpoint at line %d cannot be set up for the refinement method",count);
                            free(line);  return error;
                         };
                         c = nextColon(c+10);
@@ -414,16 +442,26 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
                            sprintf(error,"mdjeep: error while reading MDfile: unexpected end of line after 'with startpoint:' at line %d",count);
                            free(line);  return error;
                         };
-                        info->start = strdup(c);
+                        if (info->start != NULL)  free(info->start);
+                        info->start = NULL;
+                        if (!strcmp(c,"mds"))
+                           info->initial = 1;  // built-in starting point (see start.c)
+                        else if (!strcmp(c,"random"))
+                           info->initial = 2;
+                        else
+                        {
+                           info->initial = 0;
+                           info->start = strdup(c);
+                        };
                      }
-                     else if (!strncmp(c,"maxit",5))  // maxit (spg)
+                     else if (!strncmp(c,"maxit",5))  // maxit (spg, lbfgsb and smacof)
                      {
-                        if (last == 1 && info->method != 1)
+                        if (last == 1 && info->method < 1)
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: maxit is not an attribute of selected method");
                            free(line);  return error;
                         };
-                        if (last == 2 && info->refinement != 1)
+                        if (last == 2 && info->refinement < 1)
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: maxit is not an attribute of refinement method");
                            free(line);  return error;
@@ -488,14 +526,14 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
                            free(line);  return error;
                         };
                      }
-                     else if (!strncmp(c,"gamma",5))  // gamma (spg)
+                     else if (!strncmp(c,"gamma",5))  // gamma (spg and lbfgsb)
                      {
-                        if (last == 1 && info->method != 1)
+                        if (last == 1 && (info->method < 1 || info->method == 3))
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: gamma is not an attribute of selected method");
                            free(line);  return error;
                         };
-                        if (last == 2 && info->refinement != 1)
+                        if (last == 2 && info->refinement < 1)
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: gamma is not an attribute of refinement method");
                            free(line);  return error;
@@ -524,14 +562,14 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
                            free(line);  return error;
                         };
                      }
-                     else if (!strncmp(c,"epsobj",6))  // epsobj (spg)
+                     else if (!strncmp(c,"epsobj",6))  // epsobj (spg, lbfgsb and smacof)
                      {
-                        if (last == 1 && info->method != 1)
+                        if (last == 1 && info->method < 1)
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: epsobj is not an attribute of selected method");
                            free(line);  return error;
                         };
-                        if (last == 2 && info->refinement != 1)
+                        if (last == 2 && info->refinement < 1)
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: epsobj is not an attribute of refinement method");
                            free(line);  return error;
@@ -560,14 +598,14 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
                            free(line);  return error;
                         };
                      }
-                     else if (!strncmp(c,"epsg",4))  // epsg (spg)
+                     else if (!strncmp(c,"epsg",4))  // epsg (spg, lbfgsb and smacof)
                      {
-                        if (last == 1 && info->method != 1)
+                        if (last == 1 && info->method < 1)
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: epsg is not an attribute of selected method");
                            free(line);  return error;
                         };
-                        if (last == 2 && info->refinement != 1)
+                        if (last == 2 && info->refinement < 1)
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: epsg is not an attribute of refinement method");
                            free(line);  return error;
@@ -596,14 +634,14 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
                            free(line);  return error;
                         };
                      }
-                     else if (!strncmp(c,"epsalpha",8))  // epsalpha (spg)
+                     else if (!strncmp(c,"epsalpha",8))  // epsalpha (spg, lbfgsb and smacof)
                      {
-                        if (last == 1 && info->method != 1)
+                        if (last == 1 && info->method < 1)
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: epsalpha is not an attribute of selected method");
                            free(line);  return error;
                         };
-                        if (last == 2 && info->refinement != 1)
+                        if (last == 2 && info->refinement < 1)
                         {
                            sprintf(error,"mdjeep: error while reading MDfile: epsalpha is not an attribute of refinement method");
                            free(line);  return error;
@@ -704,6 +742,40 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
                            free(line);  return error;
                         };
                      }
+                     else if (!strncmp(c,"precision",9))  // precision (spg)
+                     {
+                        if (last == 1 && info->method != 1)
+                        {
+                           sprintf(error,"mdjeep: error while reading MDfile: precision is not an attribute of selected method");
+                           free(line);  return error;
+                        };
+                        if (last == 2 && info->refinement != 1)
+                        {
+                           sprintf(error,"mdjeep: error while reading MDfile: precision is not an attribute of refinement method");
+                           free(line);  return error;
+                        };
+                        c = nextColon(c+9);
+                        if (c == NULL)
+                        {
+                           sprintf(error,"mdjeep: error while reading MDfile: 'with precision' at line %d needs to be followed by ':'",count);
+                           free(line);  return error;
+                        };
+                        c = nextNonBlank(c+1);
+                        if (c == NULL)
+                        {
+                           sprintf(error,"mdjeep: error while reading MDfile: unexpected end of line after 'with precision:' at line %d",count);
+                           free(line);  return error;
+                        };
+                        if (!strcmp(c,"double"))
+                           op->precision = 0;
+                        else if (!strcmp(c,"single"))
+                           op->precision = 1;
+                        else
+                        {
+                           sprintf(error,"mdjeep: error while reading MDfile: specified precision at line %d can only be 'single' or 'double'",count);
+                           free(line);  return error;
+                        };
+                     }
                      else
                      {
                         if (last == 1)
@@ -743,7 +815,7 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
    };
    if (info->method == -1)
    {
-      sprintf(error,"mdjeep: error while reading MDfile: main method not specified (can be 'bp' or 'spg')");
+      sprintf(error,"mdjeep: error while reading MDfile: main method not specified (can be 'bp', 'spg', 'lbfgsb' or 'smacof')");
       free(line);  return error;
    };
    if (info->method == 0 && info->refinement == 0)
@@ -751,24 +823,23 @@ char* readMDfile(FILE *input,OPTION *op,INFORMATION *info)
       sprintf(error,"mdjeep: error while reading MDfile: bp cannot be invoked as a refinement method for itself");
       free(line);  return error;
    };
-   if (info->method == 1 && info->refinement == 0)
+   if (info->method > 0 && info->refinement == 0)
    {
-      sprintf(error,"mdjeep: error while reading MDfile: spg cannot use bp as a refinement method");
+      sprintf(error,"mdjeep: error while reading MDfile: %s cannot use bp as a refinement method",methodName(info->method));
       free(line);  return error;
    };
-   if (info->method == 1 && info->refinement == 1)
+   if (info->method > 0 && info->refinement > 0)
    {
-      sprintf(error,"mdjeep: error while reading MDfile: spg cannot be invoked as a refinement method for itself");
+      sprintf(error,"mdjeep: error while reading MDfile: %s cannot be refined by a local method",methodName(info->method));
       free(line);  return error;
    };
-   if (info->method == 1 && info->start == NULL)
+   if (info->method > 0 && info->start == NULL && info->initial == 0)
    {
-      sprintf(error,"mdjeep: error while reading MDfile: startpoint attribute not set up, impossible to run spg without starting point");
-      free(line);  return error;
+      info->initial = 1;  // classical MDS (see start.c)
    };
-   if (info->method == 1 && op->maxit == -1)
+   if (info->method > 0 && op->maxit == -1)
    {
-      sprintf(error,"mdjeep: error while reading MDfile: maxit attribute needs to be specified when spg is the main method");
+      sprintf(error,"mdjeep: error while reading MDfile: maxit attribute needs to be specified when %s is the main method",methodName(info->method));
       free(line);  return error;
    };
    if ((info->method == 1 || info->refinement == 1) && (op->mumin >= op->mumax))
@@ -1238,12 +1309,12 @@ int readDistanceFile(FILE *input,char sep,int n,int n0,VERTEX *v,unsigned long f
                   v[j].ref = initReference(i,lb,ub);
                else if (getReference(v,i,j) == NULL)
                   addDistance(v[j].ref,i,lb,ub);
-
-               // deallocating memory allocated by strdup
-               free(name1);  free(name2);
-               free(gname1);  free(gname2);
             };
          };
+
+         // deallocating memory allocated by strdup (also for lines not containing distances)
+         free(name1);  free(name2);
+         free(gname1);  free(gname2);
       };
    }
    while (memory != NULL);
@@ -0,0 +1,236 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - repetition orders
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (option -repeat)
+************************************************************************************************************/
+
+#include "bp.h"
+
+// when the consecutivity assumption is not satisfied by the vertex order, the reference vertices can be made
+// consecutive by repeating some vertices in the order (repetition order): before a vertex whose 3 previous
+// vertices are not all references, copies of its reference vertices are inserted, so that they immediately
+// precede it; a copy is not a new vertex: at its layer, bp does not branch, and it takes the coordinates of the
+// previous occurrence of the same vertex; the layers of the search tree are therefore the positions in the
+// repetition order, and the solutions are given without the copies (see contractSolution)
+// -> every distance appears only once, in the list of references of the first occurrence of its last vertex,
+//    and it refers to the first occurrence of the other vertex (every distance is verified on the coordinates of
+//    the solution without the copies, see contractSolution)
+// -> the copies are only inserted after the first four vertices: the vertices of the initial clique, and the
+//    vertex following them, are not repeated
+// -> a copy is equivalent to a distance to the previous occurrence of the vertex for the symmetries of the tree
+//    (see findRepetitionSymmetries)
+// -> bp_exact places every vertex with the references to its 3 previous positions, and it skips the symmetric
+//    branches after a solution (the consecutivity assumption is satisfied); on protein backbones, these triplets
+//    can be flat (the peptide groups are planar): on their layers, the triplet is selected as for the orders that
+//    are not consecutive (see bp_exact)
+
+// this function verifies whether the vertex b is a reference vertex for vertex a (b < a)
+bool isReferenceOf(VERTEX *v,int a,int b)
+{
+   REFERENCE *ref;
+
+   for (ref = v[a].ref; ref != NULL; ref = ref->next)  if (otherVertexId(ref) == b)  return true;
+   return false;
+};
+
+// this function builds a repetition order for an instance whose vertex order satisfies the discretization
+// assumptions (DDGP) but not the consecutivity assumption; the instance needs to contain exact distances only
+// (the vertices in the triplets of references can then be given in any order)
+// -> for every vertex, the copies are chosen so that the last positions of the current order are reused as much
+//    as possible; the missing reference vertices are the most recently placed ones
+// -> the positions are stored in inst->vrep (the copies share the names of the original vertices, and they have
+//    no references), and inst->rep gives the previous occurrence of the vertex at every position (-1 for the
+//    first occurrences); the number of positions is inst->nrep
+// -> the returning value is the number of copies in the repetition order
+int repeatVertices(INSTANCE *inst)
+{
+   int i,k,a,b,c,p,n,nr,ncand,tmp;
+   int s[3];
+   int *seq,*first,*last,*cand;
+   REFERENCE *ref;
+   VERTEX *v,*vr;
+
+   n = inst->n;  v = inst->v;
+   inst->nrep = n;  inst->vrep = NULL;  inst->rep = NULL;
+   if (n < 5)  return 0;
+
+   // every vertex is preceded by at most 3 copies
+   seq = (int*)calloc(4*n,sizeof(int));
+   inst->rep = (int*)calloc(4*n,sizeof(int));
+   first = (int*)calloc(n,sizeof(int));
+   last = (int*)calloc(n,sizeof(int));
+   cand = (int*)calloc(n,sizeof(int));
+   vr = (VERTEX*)calloc(4*n,sizeof(VERTEX));
+
+   // the first four vertices
+   nr = 0;
+   for (a = 0; a < 4; a++)
+   {
+      seq[nr] = a;  inst->rep[nr] = -1;  first[a] = nr;  last[a] = nr;
+      nr++;
+   };
+
+   // the other vertices
+   for (a = 4; a < n; a++)
+   {
+      // how many of the last positions can be reused?
+      k = 0;
+      if (isReferenceOf(v,a,seq[nr-1]))
+      {
+         k = 1;
+         if (isReferenceOf(v,a,seq[nr-2]) && seq[nr-2] != seq[nr-1])
+         {
+            k = 2;
+            if (isReferenceOf(v,a,seq[nr-3]) && seq[nr-3] != seq[nr-1] && seq[nr-3] != seq[nr-2])  k = 3;
+         };
+      };
+      for (i = 0; i < k; i++)  s[i] = seq[nr-k+i];
+
+      // the missing reference vertices: the most recently placed ones (insertion sort by last position)
+      ncand = 0;
+      for (ref = v[a].ref; ref != NULL; ref = ref->next)
+      {
+         b = otherVertexId(ref);
+         for (i = 0; i < k; i++)  if (s[i] == b)  break;
+         if (i < k)  continue;
+         cand[ncand] = b;
+         for (i = ncand; i > 0 && last[cand[i-1]] < last[cand[i]]; i--)
+         {
+            tmp = cand[i];  cand[i] = cand[i-1];  cand[i-1] = tmp;
+         };
+         ncand++;
+      };
+
+      // the copies (the most recent vertex is the closest one to a)
+      for (i = k; i < 3; i++)  s[i] = cand[2-i];
+      for (i = k; i < 3; i++)
+      {
+         c = s[i];
+         seq[nr] = c;  inst->rep[nr] = last[c];  last[c] = nr;
+         nr++;
+      };
+
+      // the vertex a
+      seq[nr] = a;  inst->rep[nr] = -1;  first[a] = nr;  last[a] = nr;
+      nr++;
+
+      // its references (to the first occurrences of the reference vertices)
+      p = nr - 1;
+      for (ref = v[a].ref; ref != NULL; ref = ref->next)
+      {
+         b = first[otherVertexId(ref)];
+         if (vr[p].ref == NULL)
+            vr[p].ref = initReference(b,lowerBound(ref),upperBound(ref));
+         else
+            addDistance(vr[p].ref,b,lowerBound(ref),upperBound(ref));
+      };
+   };
+
+   // the first four vertices refer to each other (no copies)
+   for (a = 0; a < 4; a++)
+   {
+      for (ref = v[a].ref; ref != NULL; ref = ref->next)
+      {
+         if (vr[a].ref == NULL)
+            vr[a].ref = initReference(otherVertexId(ref),lowerBound(ref),upperBound(ref));
+         else
+            addDistance(vr[a].ref,otherVertexId(ref),lowerBound(ref),upperBound(ref));
+      };
+   };
+
+   // vertex attributes
+   for (p = 0; p < nr; p++)
+   {
+      a = seq[p];
+      vr[p].Id = v[a].Id;  vr[p].groupId = v[a].groupId;
+      vr[p].Name = v[a].Name;  vr[p].Group = v[a].Group;
+   };
+
+   // no copies were necessary
+   free(cand);  free(last);  free(first);  free(seq);
+   if (nr == n)
+   {
+      for (p = 0; p < nr; p++)  freeReference(vr[p].ref);
+      free(vr);
+      free(inst->rep);  inst->rep = NULL;
+      return 0;
+   };
+   inst->nrep = nr;
+   inst->vrep = vr;
+   return nr - n;
+};
+
+// this function frees the repetition order of an instance (the names of the vertices belong to inst->v)
+void freeRepetitionOrder(INSTANCE *inst)
+{
+   int p;
+
+   if (inst->vrep != NULL)
+   {
+      for (p = 0; p < inst->nrep; p++)  freeReference(inst->vrep[p].ref);
+      free(inst->vrep);
+   };
+   if (inst->rep != NULL)  free(inst->rep);
+   inst->vrep = NULL;  inst->rep = NULL;
+   inst->nrep = inst->n;
+};
+
+// this function gives the first occurrence of the vertex at position p of a repetition order
+int firstOccurrence(int *rep,int p)
+{
+   while (rep[p] >= 0)  p = rep[p];
+   return p;
+};
+
+// this function verifies the consecutivity assumption on a repetition order (the copies are not verified)
+// -> the references of a vertex refer to the first occurrences of its reference vertices
+bool isRepetitionDMDGP(int n,VERTEX *v,int *rep,double eps)
+{
+   int i;
+   REFERENCE *r1,*r2,*r3;
+
+   for (i = 3; i < n; i++)
+   {
+      if (rep[i] >= 0)  continue;
+      r3 = getReference(v,firstOccurrence(rep,i-3),i);  if (r3 == NULL)  return false;
+      r2 = getReference(v,firstOccurrence(rep,i-2),i);  if (r2 == NULL)  return false;
+      r1 = getReference(v,firstOccurrence(rep,i-1),i);  if (r1 == NULL)  return false;
+      if (isIntervalDistance(r1,eps) || isIntervalDistance(r2,eps))  return false;
+   };
+   return true;
+};
+
+// this function marks as not symmetric the layers covered by a copy and the previous occurrence of its vertex
+// (the copy needs to be reflected together with it), see findSymmetries
+void findRepetitionSymmetries(int n,int *rep,bool *sym)
+{
+   int i,j;
+
+   for (i = 0; i < n; i++)
+   {
+      if (rep[i] < 0)  continue;
+      for (j = rep[i] + 4; j <= i; j++)  sym[j] = false;
+   };
+};
+
+// this function gives a solution without the copies of the vertices (the first occurrences of the vertices are
+// in the order of the instance vertices)
+// -> X contains the coordinates of the first n positions of a repetition order, rep its previous occurrences
+// -> the coordinates of the vertices are written in Y (which can coincide with X)
+// -> the returning value is the number of vertices in Y
+int contractSolution(int n,int *rep,double **X,double **Y)
+{
+   int i,k;
+
+   k = 0;
+   for (i = 0; i < n; i++)
+   {
+      if (rep[i] >= 0)  continue;
+      Y[0][k] = X[0][i];  Y[1][k] = X[1][i];  Y[2][k] = X[2][i];
+      k++;
+   };
+   return k;
+};
@@ -0,0 +1,582 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - solver daemon
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version
+                                    number of duplicated solutions in the statistics (option -dedup)
+                                    output file name also set for options -best and -cluster
+                                    number of clusters in the statistics (option -cluster)
+                                    option -lookahead in the key of the cached instances
+                                    option -smooth in the key of the cached instances
+                                    option -repeat in the key of the cached instances (more layers than vertices)
+                                    option -hier in the key of the cached instances
+                                    option -blocks in the key of the cached instances
+                                    previous solution of the job (option -incr)
+                                    built-in starting points (see start.c)
+                                    the signal catcher of the daemon is also restored for SIGTERM after every job
+                                    the interruption flag (^C) is cleared before every job
+                                    the working directory of the daemon is restored after every job
+************************************************************************************************************/
+
+#include "bp.h"
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <limits.h>
+
+extern double INFTY;
+
+// maximum number of option words in one job
+#define MAXARGS 64
+
+// the daemon stops listening when this variable is set to false (see serverHandler)
+volatile bool serving = true;
+
+// signal catcher for the daemon
+void serverHandler(int a)
+{
+   serving = false;
+};
+
+/* Solver daemon
+ *
+ * syntax: mdjeep --serve socket [-cache size]
+ *
+ * The daemon listens on a local Unix socket and processes one job at a time. Every job is a sequence of
+ * text lines terminated by a line containing the key-word "end":
+ *
+ *    directory: path       working directory of the client (relative paths are resolved wrt this directory)
+ *    mdfile: path          MDfile specifying the instance format, the method and its attributes (mandatory)
+ *    instance: path        distance file replacing the one specified in the MDfile (optional)
+ *    distances: k          the k following lines contain the distance list, sent inline (optional)
+ *    option: words         mdjeep options, such as -1, -l, -sym or -consec (optional, can be repeated)
+ *    end
+ *
+ * A line containing only the key-word "shutdown" stops the daemon. The reply to every job starts with
+ * "status: ok" or "status: error", followed by the list of solutions (lines "solution: s lde mde" followed
+ * by one line "Id x y z" per vertex), by the statistics of the run, and by the line "end".
+ * Instances are read and prepared only once: they are kept in a LRU cache of given size (default 16).
+ * The paths of a job without "directory" are resolved wrt the directory where the daemon was started.
+ */
+int mdjeep_serve(int argc,char *argv[])
+{
+   int i,flag;
+   int sfd,cfd,wfd;
+   int csize;
+   char *path,*sockpath;
+   unsigned long clock;
+   CACHED *cache;
+   FILE *in,*out;
+   struct sockaddr_un address;
+   struct sigaction action;
+
+   // reading the arguments
+   if (argc < 1)
+   {
+      fprintf(stderr,"mdjeep: error: --serve requires the path of the Unix socket\n");
+      return 1;
+   };
+   path = argv[0];
+   if (strlen(path) >= sizeof(address.sun_path))
+   {
+      fprintf(stderr,"mdjeep: error: socket path '%s' is too long\n",path);
+      return 1;
+   };
+   csize = 16;
+   i = 1;
+   while (i < argc)
+   {
+      if (!strcmp(argv[i],"-cache") && i + 1 < argc && isInteger(argv[i+1]) && atoi(argv[i+1]) > 0)
+      {
+         csize = atoi(argv[i+1]);
+         i = i + 2;
+      }
+      else
+      {
+         fprintf(stderr,"mdjeep: error: unknown or invalid option for --serve (%s)\n",argv[i]);
+         return 1;
+      };
+   };
+
+   // creating the socket
+   sfd = socket(AF_UNIX,SOCK_STREAM,0);
+   if (sfd < 0)
+   {
+      fprintf(stderr,"mdjeep: error: impossible to create the socket (%s)\n",strerror(errno));
+      return 1;
+   };
+   memset(&address,0,sizeof(address));
+   address.sun_family = AF_UNIX;
+   strcpy(address.sun_path,path);
+   unlink(path);
+   if (bind(sfd,(struct sockaddr*)&address,sizeof(address)) < 0 || listen(sfd,16) < 0)
+   {
+      fprintf(stderr,"mdjeep: error: impossible to listen on socket '%s' (%s)\n",path,strerror(errno));
+      close(sfd);
+      return 1;
+   };
+
+   // the jobs move to the directories of the clients: the socket is removed at the end with its absolute path,
+   // and the working directory of the daemon is restored after every job
+   sockpath = realpath(path,NULL);
+   if (sockpath == NULL)  sockpath = strdup(path);
+   wfd = open(".",O_RDONLY);
+   if (wfd < 0)
+   {
+      fprintf(stderr,"mdjeep: error: impossible to open the working directory (%s)\n",strerror(errno));
+      close(sfd);
+      unlink(sockpath);
+      free(sockpath);
+      return 1;
+   };
+
+   // the daemon stops on ^C and on SIGTERM (system calls are not restarted)
+   memset(&action,0,sizeof(action));
+   action.sa_handler = serverHandler;
+   sigemptyset(&action.sa_mask);
+   sigaction(SIGTERM,&action,NULL);
+   sigaction(SIGINT,&action,NULL);
+   signal(SIGPIPE,SIG_IGN);
+
+   // LRU cache of prepared instances
+   cache = (CACHED*)calloc(csize,sizeof(CACHED));
+   clock = 0;
+
+   // processing the jobs
+   fprintf(stderr,"mdjeep: solver listening on '%s' (cache size %d)\n",path,csize);
+   while (serving)
+   {
+      cfd = accept(sfd,NULL,NULL);
+      if (cfd < 0)  continue;  // interrupted
+      in = fdopen(cfd,"r");
+      out = fdopen(dup(cfd),"w");
+      if (in == NULL || out == NULL)
+      {
+         if (in != NULL)  fclose(in);  else  close(cfd);
+         if (out != NULL)  fclose(out);
+         continue;
+      };
+
+      // a connection can submit several jobs
+      do
+      {
+         flag = serveJob(in,out,cache,csize,&clock);
+         fflush(out);
+         if (fchdir(wfd) != 0)
+         {
+            fprintf(stderr,"mdjeep: error: impossible to move back to the working directory (%s)\n",strerror(errno));
+            flag = 2;
+         };
+
+         // bp installs its own signal catcher, the one of the daemon is restored
+         sigaction(SIGINT,&action,NULL);
+         sigaction(SIGTERM,&action,NULL);
+      }
+      while (flag == 0 && serving);
+      fclose(in);
+      fclose(out);
+      if (flag == 2)  serving = false;
+   };
+
+   // ending
+   fprintf(stderr,"mdjeep: solver stopped\n");
+   close(sfd);
+   close(wfd);
+   unlink(sockpath);
+   free(sockpath);
+   for (i = 0; i < csize; i++)
+   {
+      if (cache[i].last != 0)
+      {
+         free(cache[i].key);
+         if (cache[i].text != NULL)  free(cache[i].text);
+         freeInstance(&cache[i].inst);
+      };
+   };
+   free(cache);
+   return 0;
+};
+
+// this function reads one job from the input stream, solves it and writes the reply in the output stream
+// -> cache is the LRU cache of prepared instances (csize entries), clock is the time stamp of the last use
+// -> the returning value is 0 when the job was processed, 1 when the connection was closed by the client,
+//    and 2 when the client requested the daemon to stop
+int serveJob(FILE *in,FILE *out,CACHED *cache,int csize,unsigned long *clock)
+{
+   int i,k,argcount;
+   int n,it,flag;
+   bool hit,check_consec;
+   size_t len,tlen,tsize;
+   ssize_t nread;
+   char *line,*c,*word;
+   char *args[MAXARGS];
+   char *mdfile,*filename,*directory;
+   char *text,*key,*errmsg;
+   double obj;
+   double **X;
+   CACHED *entry;
+   INSTANCE *inst;
+   SEARCH S;
+   OPTION op;
+   INFORMATION info;
+   struct timeval t1,t2;
+   FILE *input;
+
+   // reading the job
+   line = NULL;  len = 0;
+   mdfile = NULL;  filename = NULL;  directory = NULL;
+   text = NULL;  tlen = 0;  tsize = 0;
+   argcount = 0;  errmsg = NULL;
+   flag = 1;
+   while ((nread = getline(&line,&len,in)) > 0)
+   {
+      k = strlen(line);
+      while (k > 0 && (isNewLineDelimiter(line[k-1]) || isSeparator(line[k-1],' ')))  line[--k] = '\0';
+      c = nextNonBlank(line);
+      if (c == NULL || c[0] == '#')  continue;
+      if (!strcmp(c,"end"))
+      {
+         flag = 0;
+         break;
+      }
+      else if (!strcmp(c,"shutdown"))
+      {
+         flag = 2;
+         break;
+      }
+      else if (!strncmp(c,"directory:",10) && nextNonBlank(c+10) != NULL)
+      {
+         if (directory != NULL)  free(directory);
+         directory = strdup(nextNonBlank(c+10));
+      }
+      else if (!strncmp(c,"mdfile:",7) && nextNonBlank(c+7) != NULL)
+      {
+         if (mdfile != NULL)  free(mdfile);
+         mdfile = strdup(nextNonBlank(c+7));
+      }
+      else if (!strncmp(c,"instance:",9) && nextNonBlank(c+9) != NULL)
+      {
+         if (filename != NULL)  free(filename);
+         filename = strdup(nextNonBlank(c+9));
+      }
+      else if (!strncmp(c,"option:",7))
+      {
+         word = strtok(c+7," \t");
+         while (word != NULL && argcount < MAXARGS)
+         {
+            args[argcount] = strdup(word);
+            argcount++;
+            word = strtok(NULL," \t");
+         };
+      }
+      else if (!strncmp(c,"distances:",10) && nextNonBlank(c+10) != NULL && isInteger(nextNonBlank(c+10)))
+      {
+         k = atoi(nextNonBlank(c+10));
+         for (i = 0; i < k && (nread = getline(&line,&len,in)) > 0; i++)
+         {
+            if (tlen + nread + 1 > tsize)
+            {
+               tsize = 2*(tlen + nread + 1);
+               text = (char*)realloc(text,tsize);
+            };
+            memcpy(text+tlen,line,nread);
+            tlen = tlen + nread;
+            text[tlen] = '\0';
+         };
+         if (i < k && errmsg == NULL)  errmsg = strdup("mdjeep: error: the inline distance list is incomplete");
+      }
+      else if (errmsg == NULL)
+      {
+         errmsg = strdup("mdjeep: error: syntax error in job description");
+      };
+   };
+   free(line);
+   if (flag != 0)
+   {
+      if (errmsg != NULL)  free(errmsg);
+      errmsg = NULL;
+      goto END;
+   };
+   if (errmsg == NULL && mdfile == NULL)  errmsg = strdup("mdjeep: error: no MDfile specified in the job");
+   if (errmsg != NULL)  goto ERROR;
+
+   // relative paths are resolved wrt the directory of the client
+   if (directory != NULL && chdir(directory) != 0)
+   {
+      errmsg = strdup("mdjeep: error: impossible to move to the working directory of the client");
+      goto ERROR;
+   };
+
+   // reading the MDfile
+   input = fopen(mdfile,"r");
+   if (input == NULL)
+   {
+      errmsg = strdup("mdjeep: error while opening the MDfile");
+      goto ERROR;
+   };
+   info.name = NULL;  info.filename = NULL;  info.previous = NULL;  info.prevsol = NULL;
+   errmsg = readMDfile(input,&op,&info);
+   fclose(input);
+   if (errmsg != NULL)  goto FREEINFO;
+   if (filename != NULL)
+   {
+      free(info.filename);
+      info.filename = filename;
+      filename = NULL;
+   };
+
+   // options
+   defaultOptions(&op,&info);
+   check_consec = false;
+   errmsg = readArguments(argcount,args,&op,&info,&check_consec);
+   if (errmsg != NULL)  goto FREEINFO;
+   op.monitor = false;
+
+   // looking for the instance in the cache
+   key = instanceKey(info.filename,text,op,info,check_consec);
+   if (key == NULL)
+   {
+      errmsg = strdup("mdjeep: error: cannot open instance file");
+      goto FREEINFO;
+   };
+   entry = cacheLookup(cache,csize,key,text);
+   hit = (entry != NULL);
+   if (hit)
+   {
+      // only the verifications depending on the job options are performed
+      free(key);
+      inst = &entry->inst;
+      errmsg = checkInstance(inst,&op,&info);
+      if (errmsg != NULL)  goto FREEINFO;
+   }
+   else
+   {
+      // reading and preparing the instance
+      entry = cacheSlot(cache,csize);
+      entry->key = key;
+      entry->text = text;  text = NULL;
+      inst = &entry->inst;
+      if (entry->text != NULL)
+         input = fmemopen(entry->text,strlen(entry->text),"r");
+      else
+         input = fopen(info.filename,"r");
+      errmsg = readInstance(input,info.sep,info.format,inst);
+      if (input != NULL)  fclose(input);
+      if (errmsg == NULL)  errmsg = checkInstance(inst,&op,&info);
+      if (errmsg == NULL)  errmsg = prepareInstance(inst,op,&info,check_consec);
+      if (errmsg != NULL)
+      {
+         // the failed instance is not kept in the cache
+         free(entry->key);  entry->key = NULL;
+         if (entry->text != NULL)  free(entry->text);
+         entry->text = NULL;
+         freeInstance(inst);
+         entry->last = 0;
+         goto FREEINFO;
+      };
+   };
+   (*clock)++;
+   entry->last = *clock;
+   n = inst->n;
+
+   // memory allocation (one column per layer of the search tree)
+   X = allocateMatrix(3,inst->nrep);
+   if (info.previous != NULL)
+   {
+      // previous solution (incremental mode, see incremental.c)
+      errmsg = previousSolution(inst,&info,X);
+      if (errmsg != NULL)
+      {
+         freeMatrix(3,X);
+         goto FREEINFO;
+      };
+   }
+   else if (info.method > 0 && info.start == NULL)
+   {
+      // built-in starting point (see start.c)
+      builtinStart(n,inst->v,X,op.eps,&info);
+   }
+   else if (info.method > 0)
+   {
+      input = fopen(info.start,"r");
+      if (input == NULL || readStartingPoint(input,n,X) != n)
+      {
+         if (input != NULL)  fclose(input);
+         freeMatrix(3,X);
+         errmsg = strdup("mdjeep: error while reading the starting point");
+         goto FREEINFO;
+      };
+      fclose(input);
+   };
+   if (op.print != 0 || op.best > 0 || op.cluster > 0.0)  info.output = removExtension(info.filename);
+   allocateSearch(&S,inst->nrep,inst->m);
+
+   // solving the instance (the solutions found by bp are written by serverSolution)
+   fprintf(out,"status: ok\n");
+   fprintf(out,"cache: %s\n",hit ? "hit" : "miss");
+   info.solution = serverSolution;
+   info.data = (void*)out;
+   clearInterrupt();
+   gettimeofday(&t1,0);
+   flag = solveInstance(inst,X,S,op,&info,&it,&obj);
+   gettimeofday(&t2,0);
+
+   // reply: statistics of the run
+   if (info.method == 0)
+   {
+      fprintf(out,"solutions: %d\n",info.nsols);
+      fprintf(out,"pruned: %d\n",info.pruning);
+      if (op.dedup != 0)  fprintf(out,"duplicates: %d\n",info.duplicates);
+      if (op.cluster > 0.0)  fprintf(out,"clusters: %d\n",info.clusters);
+      fprintf(out,"spg: %d %d\n",info.nspg,info.nspgok);
+      if (info.nsols > 0)  fprintf(out,"best: %d %.8lf %.8lf\n",info.best_sol,info.best_lde,info.best_mde);
+   }
+   else
+   {
+      fprintf(out,"solution: 1 %.8lf %.8lf\n",compute_lde(n,inst->v,X,op.eps),compute_mde(n,inst->v,X,op.eps));
+      for (i = 0; i < n; i++)  fprintf(out,"%d %.9lf %.9lf %.9lf\n",inst->v[i].Id,X[0][i],X[1][i],X[2][i]);
+      fprintf(out,"solutions: 1\n");
+      fprintf(out,"stress: %g\n",obj);
+      fprintf(out,"iterations: %d %d\n",it,flag);
+   };
+   fprintf(out,"time: %.6lf\n",(t2.tv_sec - t1.tv_sec) + 1.e-6*(t2.tv_usec - t1.tv_usec));
+   fprintf(out,"end\n");
+
+   // freeing memory
+   freeSearch(&S);
+   freeMatrix(3,X);
+   if (info.output != NULL)  free(info.output);
+   flag = 0;
+
+FREEINFO:
+   if (info.name != NULL)  free(info.name);
+   if (info.filename != NULL)  free(info.filename);
+   if (info.start != NULL)  free(info.start);
+   if (info.previous != NULL)  free(info.previous);
+   if (info.prevsol != NULL)  free(info.prevsol);
+
+ERROR:
+   if (errmsg != NULL)
+   {
+      serverError(out,errmsg);
+      free(errmsg);
+      flag = 0;
+   };
+
+END:
+   for (i = 0; i < argcount; i++)  free(args[i]);
+   if (mdfile != NULL)  free(mdfile);
+   if (filename != NULL)  free(filename);
+   if (directory != NULL)  free(directory);
+   if (text != NULL)  free(text);
+   return flag;
+};
+
+// this function writes a solution found by bp in the output stream of the daemon (see INFORMATION)
+void serverSolution(int n,VERTEX *v,double **X,double lde,double mde,INFORMATION *info)
+{
+   int i;
+   FILE *out = (FILE*)info->data;
+
+   fprintf(out,"solution: %d %.8lf %.8lf\n",info->nsols,lde,mde);
+   for (i = 0; i < n; i++)  fprintf(out,"%d %.9lf %.9lf %.9lf\n",v[i].Id,X[0][i],X[1][i],X[2][i]);
+};
+
+// this function writes an error reply in the output stream of the daemon
+// (multi-line messages are written on several "message" lines)
+void serverError(FILE *out,char *message)
+{
+   char *c;
+
+   fprintf(out,"status: error\n");
+   c = strtok(message,"\n");
+   while (c != NULL)
+   {
+      fprintf(out,"message: %s\n",c);
+      c = strtok(NULL,"\n");
+   };
+   fprintf(out,"end\n");
+};
+
+// this function computes the key identifying a prepared instance in the cache
+// -> the key contains all information the preparation of the instance depends on
+// -> for instances read from a file, the key includes the file size and the time of its last modification
+//   (the instance is read again if the file was modified)
+// -> for inline distance lists (text != NULL), the key contains a hash of the list
+// -> the returning value is NULL if the instance file cannot be accessed
+char* instanceKey(char *filename,char *text,OPTION op,INFORMATION info,bool check_consec)
+{
+   char *key,*path;
+   unsigned long hash;
+   struct stat status;
+
+   key = (char*)calloc(strlen(filename)+PATH_MAX+200,sizeof(char));
+   if (text != NULL)
+   {
+      hash = 5381UL;
+      while (*text != '\0')
+      {
+         hash = 33UL*hash + (unsigned char)(*text);
+         text++;
+      };
+      sprintf(key,"inline:%lx",hash);
+   }
+   else
+   {
+      path = realpath(filename,NULL);
+      if (path == NULL || stat(path,&status) != 0)
+      {
+         if (path != NULL)  free(path);
+         free(key);
+         return NULL;
+      };
+      sprintf(key,"file:%s:%ld:%ld",path,(long)status.st_size,(long)status.st_mtime);
+      free(path);
+   };
+   sprintf(key+strlen(key),"|%lx|%d|%g|%d|%d|%d|%d|%d|%d|%d",info.format,info.sep,op.eps,info.method,check_consec,op.lookahead,op.smooth,op.repeat,op.hier,op.blocks);
+   return key;
+};
+
+// this function looks for an instance in the cache
+// -> the returning value is the pointer to the cache entry, or NULL if the instance is not in the cache
+CACHED* cacheLookup(CACHED *cache,int csize,char *key,char *text)
+{
+   int i;
+
+   for (i = 0; i < csize; i++)
+   {
+      if (cache[i].last != 0 && !strcmp(cache[i].key,key))
+      {
+         // inline distance lists are entirely compared
+         if (text == NULL && cache[i].text == NULL)  return &cache[i];
+         if (text != NULL && cache[i].text != NULL && !strcmp(text,cache[i].text))  return &cache[i];
+      };
+   };
+   return NULL;
+};
+
+// this function gives a free entry of the cache
+// -> if the cache is full, the least recently used instance is removed from the cache
+CACHED* cacheSlot(CACHED *cache,int csize)
+{
+   int i,lru;
+
+   lru = 0;
+   for (i = 0; i < csize; i++)
+   {
+      if (cache[i].last == 0)  return &cache[i];
+      if (cache[i].last < cache[lru].last)  lru = i;
+   };
+
+   // freeing the least recently used entry
+   free(cache[lru].key);  cache[lru].key = NULL;
+   if (cache[lru].text != NULL)  free(cache[lru].text);
+   cache[lru].text = NULL;
+   freeInstance(&cache[lru].inst);
+   cache[lru].last = 0;
+   return &cache[lru];
+};
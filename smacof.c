@@ -0,0 +1,307 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - SMACOF
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (main method 'smacof')
+                                    the threads are created once per call to smacof (see newSmacofPool)
+************************************************************************************************************/
+
+#include "bp.h"
+#include <unistd.h>
+
+extern int K;
+
+// SMACOF (Scaling by MAjorizing a COmplicated Function) minimizes the raw stress
+//        sum over the distances (i,j) of ( ||x_i - x_j|| - y_ij )^2
+// where the variables y_ij lie in the distance bounds [lb,ub] (as in spg, y_ij is fixed to lb = ub for the exact
+// distances); every iteration performs two steps, which never increase the stress:
+// -> every y_ij is set to the projection of the current distance ||x_i - x_j|| on [lb,ub]
+// -> the coordinates are replaced by the Guttman transform of the current point: since the distance graph is
+//    sparse, the linear system L X = B(Z) Z of the transform (L is the Laplacian of the distance graph) is not
+//    solved, and the Jacobi step is taken instead, where every vertex moves independently to
+//        x_i = 1/deg(i) sum over its neighbors j of ( z_j + y_ij (z_i - z_j) / ||z_i - z_j|| )
+//    the Jacobi step is generally a good approximation of the transform; when the stress increases anyway, the
+//    step is halved (since L <= 2 D, where D is the diagonal of L, the half step never increases the stress)
+// the vertices are shared among several threads, that compute their new positions and their part of the stress;
+// the threads are created once per call to smacof, and they wait for the next transform in smacofThread (as the
+// threads of spg, see spg.c)
+// -> smacof does not use the boxes of the vertices: it is meant as a global method, that can start from a point
+//    which is far from the solutions (see the built-in starting points in start.c)
+// -> the graph of the distances, with their bounds, is the one built for the bound smoothing (see newSmooth)
+// -> the stress value reported at the end is computed with compute_stress (as for spg and lbfgsb)
+
+// number of threads computing the Guttman transform (0 = one per available processor)
+int smthreads = 0;
+
+// minimum number of vertices for every thread (smaller instances are solved by the calling thread only)
+int smchunk = 1000;
+
+// this function creates the pool of threads of smacof for n vertices (s is the graph of the distances, X is the
+// current point and J is its transform)
+// -> smaller instances are solved by the calling thread only (see smchunk)
+SMACOFPOOL* newSmacofPool(int n,SMOOTH *s,double **X,double **J)
+{
+   int t,nthreads;
+   SMACOFPOOL *p;
+   sigset_t all,previous;
+
+   // number of threads
+   nthreads = smthreads;
+   if (nthreads <= 0)  nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+   if (nthreads > n/smchunk)  nthreads = n/smchunk;
+   if (nthreads < 1)  nthreads = 1;
+
+   p = (SMACOFPOOL*)calloc(1,sizeof(SMACOFPOOL));
+   p->nthreads = nthreads;
+   p->w = (SMACOFTHREAD*)calloc(nthreads,sizeof(SMACOFTHREAD));
+   p->generation = 0;  p->closing = false;
+   for (t = 0; t < nthreads; t++)
+   {
+      p->w[t].pool = p;
+      p->w[t].s = s;  p->w[t].X = X;  p->w[t].J = J;
+      p->w[t].first = (int)(((long)t*n)/nthreads);
+      p->w[t].last = (int)(((long)(t + 1)*n)/nthreads);
+   };
+   if (nthreads == 1)  return p;
+
+   // the signals (^C) are handled by the main thread only
+   pthread_mutex_init(&p->lock,NULL);
+   pthread_cond_init(&p->go,NULL);
+   pthread_cond_init(&p->done,NULL);
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK,&all,&previous);
+   for (t = 1; t < nthreads; t++)  p->w[t].started = (pthread_create(&p->w[t].thread,NULL,smacofThread,&p->w[t]) == 0);
+   pthread_sigmask(SIG_SETMASK,&previous,NULL);
+   return p;
+};
+
+// this function is executed by the threads of smacof: they compute the transforms given by guttmanTransform until
+// the pool is freed
+void* smacofThread(void *arg)
+{
+   long seen = 0;
+   SMACOFTHREAD *w = (SMACOFTHREAD*)arg;
+   SMACOFPOOL *p = w->pool;
+
+   pthread_mutex_lock(&p->lock);
+   while (true)
+   {
+      while (p->generation == seen && !p->closing)  pthread_cond_wait(&p->go,&p->lock);
+      if (p->closing)  break;
+      seen = p->generation;
+      pthread_mutex_unlock(&p->lock);
+
+      smacofKernel(w);
+
+      pthread_mutex_lock(&p->lock);
+      p->pending--;
+      if (p->pending == 0)  pthread_cond_signal(&p->done);
+   };
+   pthread_mutex_unlock(&p->lock);
+   return NULL;
+};
+
+// this function computes the Jacobi step of the Guttman transform for the vertices assigned to one thread,
+// together with their part of the stress in the current point
+void smacofKernel(SMACOFTHREAD *w)
+{
+   int i,j,k,e,h,deg;
+   double d,y;
+   double a[3];
+   SMOOTH *s = w->s;
+   double **X = w->X;
+
+   w->stress = 0.0;
+   for (i = w->first; i < w->last; i++)
+   {
+      deg = s->start[i+1] - s->start[i];
+      if (deg == 0)
+      {
+         for (k = 0; k < K; k++)  w->J[k][i] = X[k][i];
+         continue;
+      };
+      a[0] = 0.0;  a[1] = 0.0;  a[2] = 0.0;
+      for (h = s->start[i]; h < s->start[i+1]; h++)
+      {
+         j = s->adj[h];
+         e = s->dist[h];
+         d = distance(i,j,X);
+         y = projection(d,s->lb[e],s->ub[e],0.0);
+         w->stress = w->stress + 0.5*(d - y)*(d - y);
+         for (k = 0; k < K; k++)  a[k] = a[k] + X[k][j];
+         if (d > 1.e-12)  for (k = 0; k < K; k++)  a[k] = a[k] + y*(X[k][i] - X[k][j])/d;
+      };
+      for (k = 0; k < K; k++)  w->J[k][i] = a[k]/deg;
+   };
+};
+
+// this function computes the Guttman transform of the current point with the threads of the pool
+// -> the returning value is the stress in the current point (before the transform)
+double guttmanTransform(SMACOFPOOL *p)
+{
+   int t;
+   double stress;
+
+   if (p->nthreads > 1)
+   {
+      pthread_mutex_lock(&p->lock);
+      p->pending = 0;
+      for (t = 1; t < p->nthreads; t++)  if (p->w[t].started)  p->pending++;
+      p->generation++;
+      pthread_cond_broadcast(&p->go);
+      pthread_mutex_unlock(&p->lock);
+   };
+
+   // the calling thread takes the first share, and the share of the threads that could not be created
+   smacofKernel(&p->w[0]);
+   for (t = 1; t < p->nthreads; t++)  if (!p->w[t].started)  smacofKernel(&p->w[t]);
+   if (p->nthreads > 1)
+   {
+      pthread_mutex_lock(&p->lock);
+      while (p->pending > 0)  pthread_cond_wait(&p->done,&p->lock);
+      pthread_mutex_unlock(&p->lock);
+   };
+
+   // stress
+   stress = 0.0;
+   for (t = 0; t < p->nthreads; t++)  stress = stress + p->w[t].stress;
+   return stress;
+};
+
+// this function terminates the threads, and frees the pool
+void freeSmacofPool(SMACOFPOOL *p)
+{
+   int t;
+
+   if (p->nthreads > 1)
+   {
+      pthread_mutex_lock(&p->lock);
+      p->closing = true;
+      pthread_cond_broadcast(&p->go);
+      pthread_mutex_unlock(&p->lock);
+      for (t = 1; t < p->nthreads; t++)  if (p->w[t].started)  pthread_join(p->w[t].thread,NULL);
+      pthread_cond_destroy(&p->done);
+      pthread_cond_destroy(&p->go);
+      pthread_mutex_destroy(&p->lock);
+   };
+   free(p->w);
+   free(p);
+};
+
+// SMACOF (stress majorization)
+//
+//           input: the DGP instance (n,v), and the starting point X
+//          output: the found solution replaces the starting point in X
+//                  the stress function value in the found solution (obj, pointer)
+//                  the number of iterations (it, pointer)
+// returning value: the flag indicating the termination status (0 = normal,
+//                                                              1 = relative decrease of the stress smaller than epsg,
+//                                                              2 = max number of iterations)
+int smacof(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj)
+{
+   int i,k,h;
+   int it,maxIt;
+   int ldigits;
+   short flag = 0;
+   double step,objval,newobjval;
+   double **J,**P;
+   REFERENCE *ref;
+   SMOOTH *s;
+   SMACOFPOOL *p;
+
+   // the distance graph, and the threads
+   maxIt = op.maxit;
+   useWorkspace(S.work,1);
+   s = newSmooth(n,v,op.eps);
+   J = allocateMatrix(K,n);
+   P = allocateMatrix(K,n);
+   memoryUsage(1,2*matrixMemory(K,n));
+   p = newSmacofPool(n,s,X,J);
+
+   // stress in the starting point, and its transform
+   objval = guttmanTransform(p);
+   info->nstress++;
+
+   // running the majorization
+   it = 1;
+   while (maxIt > it && objval > op.epsobj)
+   {
+      // monitor
+      if (info->method == 3 && op.monitor)
+      {
+         ldigits = numberOfDigits(it);
+         for (k = 0; k < info->ndigits + 9; k++)  fprintf(stderr,"\b");
+         for (k = 0; k < info->ndigits - ldigits; k++)  fprintf(stderr," ");
+         fprintf(stderr,"%d %8.2le",it,objval);
+      };
+
+      // the transform is the new point (P keeps the current one)
+      copyMatrix(K,n,X,P);
+      copyMatrix(K,n,J,X);
+      newobjval = guttmanTransform(p);
+      info->nstress++;
+
+      // halving the step when the stress increased
+      step = 1.0;
+      while (newobjval > objval && step > op.epsalpha)
+      {
+         step = 0.5*step;
+         for (k = 0; k < K; k++)  for (i = 0; i < n; i++)  X[k][i] = P[k][i] + 0.5*(X[k][i] - P[k][i]);
+         newobjval = guttmanTransform(p);
+         info->nstress++;
+      };
+      if (newobjval > objval)
+      {
+         copyMatrix(K,n,P,X);
+         flag = 1;
+         break;
+      };
+
+      // relative decrease of the stress
+      step = objval - newobjval;
+      objval = newobjval;
+      it++;
+      if (step <= op.epsg*objval)
+      {
+         flag = 1;
+         break;
+      };
+   };
+
+   // the y variables, and the stress function value (see compute_stress)
+   h = 0;
+   for (i = 0; i < n; i++)
+   {
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
+      {
+         S.work->y[h] = projection(distance(otherVertexId(ref),i,X),lowerBound(ref),upperBound(ref),0.0);
+         h++;
+      };
+   };
+   objval = compute_stress(n,v,X,S.work->y);
+   info->nstress++;
+
+   // printing (optional)
+   if (info->method == 3)
+   {
+      if (op.print > 0)
+      {
+         printSolution(n,v,X,op,info,0);
+      };
+   };
+
+   // updating output info
+   *its = it;
+   *obj = objval;
+   if (it == maxIt)  flag = 2;
+
+   // freeing memory
+   freeSmacofPool(p);
+   memoryUsage(1,-2*matrixMemory(K,n));
+   freeMatrix(K,P);
+   freeMatrix(K,J);
+   freeSmooth(s);
+   return flag;
+};
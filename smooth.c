@@ -0,0 +1,402 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - bound smoothing
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (option -smooth)
+************************************************************************************************************/
+
+#include "bp.h"
+#include <unistd.h>
+
+// the bounds of the interval distances are tightened before the search with the inequalities satisfied by the
+// distances of every realization; only the pairs of vertices having a distance in the instance are considered:
+// -> tetrangle inequality: when the vertices i, j, b and c are such that all distances but d(i,j) are exact,
+//    d(i,j) can only vary between the values corresponding to the torsion angles 0 and pi along the edge (b,c)
+// -> triangle inequality: when the vertex k has distances to both i and j,
+//        d(i,j) <= ub(i,k) + ub(k,j)     and     d(i,j) >= max( lb(i,k) - ub(k,j) , lb(k,j) - ub(i,k) )
+//    the triangle inequalities are applied in sweeps over all distances (every sweep only uses the bounds of
+//    the previous one, so that the result does not depend on the number of threads), until no bound changes
+// the exact distances are never modified, and a distance whose bounds would become inconsistent keeps its bounds;
+// the tightened bounds are written in the lists of references, so that they are used by all methods (see
+// cosomega, expandBounds and DDF), and the original bounds are kept for restoring them (see restoreBounds)
+
+// number of threads performing the bound smoothing (0 = one per available processor)
+int sthreads = 0;
+
+// maximum number of sweeps of the triangle inequalities
+int smaxsweeps = 100;
+
+// this function looks for the distance between the vertices a and b in the SMOOTH structure
+// -> the returning value is the index of the distance, or -1 if the instance does not contain it
+int smoothDistance(SMOOTH *s,int a,int b)
+{
+   int h,l,u;
+
+   l = s->start[a];  u = s->start[a+1];
+   while (l < u)
+   {
+      h = (l + u)/2;
+      if (s->adj[h] < b)
+         l = h + 1;
+      else
+         u = h;
+   };
+   if (l < s->start[a+1] && s->adj[l] == b)  return s->dist[l];
+   return -1;
+};
+
+// this function creates the SMOOTH structure for an instance with n vertices
+// -> the distances are the ones in the lists of references of the vertices
+SMOOTH* newSmooth(int n,VERTEX *v,double eps)
+{
+   int i,j,k,h,e,m,tmp;
+   int *fill;
+   REFERENCE *ref;
+   SMOOTH *s;
+
+   s = (SMOOTH*)calloc(1,sizeof(SMOOTH));
+   s->n = n;
+   s->eps = eps;
+   m = 0;
+   for (i = 0; i < n; i++)  m = m + numberOfDistances(v[i].ref);
+   s->m = m;
+   s->ref = (REFERENCE**)calloc(m > 0 ? m : 1,sizeof(REFERENCE*));
+   s->exact = (bool*)calloc(m > 0 ? m : 1,sizeof(bool));
+   s->lb = allocateVector(m > 0 ? m : 1);
+   s->ub = allocateVector(m > 0 ? m : 1);
+   s->nlb = allocateVector(m > 0 ? m : 1);
+   s->nub = allocateVector(m > 0 ? m : 1);
+
+   // the distances, and the number of neighbors of every vertex
+   s->start = (int*)calloc(n+1,sizeof(int));
+   e = 0;
+   for (i = 0; i < n; i++)
+   {
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
+      {
+         s->ref[e] = ref;
+         s->lb[e] = lowerBound(ref);
+         s->ub[e] = upperBound(ref);
+         s->exact[e] = isExactDistance(ref,eps);
+         s->start[i+1]++;
+         s->start[otherVertexId(ref)+1]++;
+         e++;
+      };
+   };
+   for (i = 0; i < n; i++)  s->start[i+1] = s->start[i+1] + s->start[i];
+
+   // symmetric lists of neighbors, sorted by vertex id
+   s->adj = (int*)calloc(2*m > 0 ? 2*m : 1,sizeof(int));
+   s->dist = (int*)calloc(2*m > 0 ? 2*m : 1,sizeof(int));
+   fill = (int*)calloc(n+1,sizeof(int));
+   for (i = 0; i < n; i++)  fill[i] = s->start[i];
+   e = 0;
+   for (i = 0; i < n; i++)
+   {
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
+      {
+         j = otherVertexId(ref);
+         s->adj[fill[i]] = j;  s->dist[fill[i]] = e;  fill[i]++;
+         s->adj[fill[j]] = i;  s->dist[fill[j]] = e;  fill[j]++;
+         e++;
+      };
+   };
+   free(fill);
+   s->maxdeg = 0;
+   for (i = 0; i < n; i++)
+   {
+      if (s->start[i+1] - s->start[i] > s->maxdeg)  s->maxdeg = s->start[i+1] - s->start[i];
+      for (h = s->start[i] + 1; h < s->start[i+1]; h++)
+      {
+         for (k = h; k > s->start[i] && s->adj[k-1] > s->adj[k]; k--)
+         {
+            tmp = s->adj[k];  s->adj[k] = s->adj[k-1];  s->adj[k-1] = tmp;
+            tmp = s->dist[k];  s->dist[k] = s->dist[k-1];  s->dist[k-1] = tmp;
+         };
+      };
+   };
+   memoryUsage(0,smoothMemory(s));
+   return s;
+};
+
+// this function gives the memory of the SMOOTH structure (see memory.c)
+long smoothMemory(SMOOTH *s)
+{
+   int m = s->m > 0 ? s->m : 1;
+
+   return sizeof(SMOOTH) + (long)m*(sizeof(REFERENCE*) + sizeof(bool)) + (long)(s->n + 1 + 4*m)*sizeof(int)
+          + 4*vectorMemory(m);
+};
+
+// this function frees the SMOOTH structure
+SMOOTH* freeSmooth(SMOOTH *s)
+{
+   if (s == NULL)  return NULL;
+   memoryUsage(0,-smoothMemory(s));
+   free(s->ref);  free(s->exact);
+   free(s->start);  free(s->adj);  free(s->dist);
+   freeVector(s->lb);  freeVector(s->ub);
+   freeVector(s->nlb);  freeVector(s->nub);
+   free(s);
+   return NULL;
+};
+
+// this function computes the position of the vertex a with respect to the edge (b,c), from the exact distances
+// dab, dac and dbc: x is the coordinate along the edge (from b), and r is the distance from the edge
+void smoothPosition(double dab,double dac,double dbc,double *x,double *r)
+{
+   double r2;
+
+   (*x) = (dab*dab - dac*dac + dbc*dbc)/(2.0*dbc);
+   r2 = dab*dab - (*x)*(*x);
+   if (r2 < 0.0)  r2 = 0.0;
+   (*r) = sqrt(r2);
+};
+
+
+// this function applies the tetrangle inequalities to the distance e, between the vertices i and j
+// -> the bounds are modified in place (only the exact distances, which are never modified, are used)
+void smoothTetrangle(SMOOTHTHREAD *w,int e,int i,int j)
+{
+   int a,b,p,q,bc,ncommon;
+   double xi,ri,xj,rj,dbc,lo,hi,lb,ub;
+   SMOOTH *s = w->s;
+
+   // the common neighbors of i and j, with exact distances to both
+   ncommon = 0;
+   a = s->start[i];  b = s->start[j];
+   while (a < s->start[i+1] && b < s->start[j+1])
+   {
+      if (s->adj[a] < s->adj[b])
+         a++;
+      else if (s->adj[a] > s->adj[b])
+         b++;
+      else
+      {
+         if (s->exact[s->dist[a]] && s->exact[s->dist[b]])
+         {
+            w->cv[ncommon] = s->adj[a];
+            w->ci[ncommon] = s->dist[a];
+            w->cj[ncommon] = s->dist[b];
+            ncommon++;
+         };
+         a++;  b++;
+      };
+   };
+
+   // the pairs of common neighbors having an exact distance
+   lb = s->lb[e];  ub = s->ub[e];
+   for (p = 0; p < ncommon; p++)
+   {
+      for (q = p + 1; q < ncommon; q++)
+      {
+         bc = smoothDistance(s,w->cv[p],w->cv[q]);
+         if (bc < 0)  continue;
+         if (!s->exact[bc])  continue;
+         dbc = s->lb[bc];
+         if (dbc < s->eps)  continue;
+         smoothPosition(s->lb[w->ci[p]],s->lb[w->ci[q]],dbc,&xi,&ri);
+         smoothPosition(s->lb[w->cj[p]],s->lb[w->cj[q]],dbc,&xj,&rj);
+         lo = sqrt((xi - xj)*(xi - xj) + (ri - rj)*(ri - rj)) - s->eps;
+         hi = sqrt((xi - xj)*(xi - xj) + (ri + rj)*(ri + rj)) + s->eps;
+         if (lo > lb)  lb = lo;
+         if (hi < ub)  ub = hi;
+      };
+   };
+   if (lb <= ub)
+   {
+      s->lb[e] = lb;
+      s->ub[e] = ub;
+   };
+};
+
+// this function applies the triangle inequalities to the distance e, between the vertices i and j
+// -> the new bounds are stored in nlb and nub, the returning value is the largest change in the bounds
+double smoothTriangle(SMOOTH *s,int e,int i,int j)
+{
+   int a,b,e1,e2;
+   double c,lb,ub;
+
+   lb = s->lb[e];  ub = s->ub[e];
+   if (!s->exact[e])
+   {
+      a = s->start[i];  b = s->start[j];
+      while (a < s->start[i+1] && b < s->start[j+1])
+      {
+         if (s->adj[a] < s->adj[b])
+            a++;
+         else if (s->adj[a] > s->adj[b])
+            b++;
+         else
+         {
+            e1 = s->dist[a];  e2 = s->dist[b];
+            c = s->ub[e1] + s->ub[e2];  if (c < ub)  ub = c;
+            c = s->lb[e1] - s->ub[e2];  if (c > lb)  lb = c;
+            c = s->lb[e2] - s->ub[e1];  if (c > lb)  lb = c;
+            a++;  b++;
+         };
+      };
+      if (lb > ub)
+      {
+         lb = s->lb[e];
+         ub = s->ub[e];
+      };
+   };
+   s->nlb[e] = lb;  s->nub[e] = ub;
+   c = lb - s->lb[e];
+   if (s->ub[e] - ub > c)  c = s->ub[e] - ub;
+   return c;
+};
+
+// this function applies the inequalities to the distances assigned to one thread (executed by the threads)
+// -> the thread t takes the distances t, t + nthreads, t + 2*nthreads, ...
+void* smoothThread(void *arg)
+{
+   int i,e,h;
+   double c;
+   SMOOTHTHREAD *w = (SMOOTHTHREAD*)arg;
+   SMOOTH *s = w->s;
+
+   w->change = 0.0;
+   for (i = 0; i < s->n; i++)
+   {
+      for (h = s->start[i]; h < s->start[i+1]; h++)
+      {
+         if (s->adj[h] >= i)  continue;
+         e = s->dist[h];
+         if (e%w->nthreads != w->id)  continue;
+         if (w->phase == 0)
+         {
+            if (!s->exact[e])  smoothTetrangle(w,e,i,s->adj[h]);
+         }
+         else
+         {
+            c = smoothTriangle(s,e,i,s->adj[h]);
+            if (c > w->change)  w->change = c;
+         };
+      };
+   };
+   return NULL;
+};
+
+// this function runs one phase of the bound smoothing (0 = tetrangle inequalities, 1 = sweep of the triangle
+// inequalities) with several threads
+// -> the returning value is the largest change in the bounds (only for the sweeps)
+double runSmooth(SMOOTH *s,int phase)
+{
+   int t,nthreads;
+   double change;
+   bool *started;
+   SMOOTHTHREAD *w;
+   sigset_t all,previous;
+
+   // number of threads
+   nthreads = sthreads;
+   if (nthreads <= 0)  nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+   if (nthreads > s->m)  nthreads = s->m;
+   if (nthreads < 1)  nthreads = 1;
+
+   // the signals (^C) are handled by the main thread only
+   w = (SMOOTHTHREAD*)calloc(nthreads,sizeof(SMOOTHTHREAD));
+   started = (bool*)calloc(nthreads,sizeof(bool));
+   for (t = 0; t < nthreads; t++)
+   {
+      w[t].s = s;  w[t].id = t;  w[t].nthreads = nthreads;
+      w[t].phase = phase;  w[t].change = 0.0;
+      w[t].cv = (int*)calloc(s->maxdeg + 1,sizeof(int));
+      w[t].ci = (int*)calloc(s->maxdeg + 1,sizeof(int));
+      w[t].cj = (int*)calloc(s->maxdeg + 1,sizeof(int));
+   };
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK,&all,&previous);
+   for (t = 1; t < nthreads; t++)  started[t] = (pthread_create(&w[t].thread,NULL,smoothThread,&w[t]) == 0);
+   pthread_sigmask(SIG_SETMASK,&previous,NULL);
+
+   // the calling thread takes the first share, and the share of the threads that could not be created
+   smoothThread(&w[0]);
+   for (t = 1; t < nthreads; t++)
+   {
+      if (started[t])
+         pthread_join(w[t].thread,NULL);
+      else
+         smoothThread(&w[t]);
+   };
+
+   // largest change
+   change = 0.0;
+   for (t = 0; t < nthreads; t++)
+   {
+      if (w[t].change > change)  change = w[t].change;
+      free(w[t].cv);  free(w[t].ci);  free(w[t].cj);
+   };
+   free(started);
+   free(w);
+   return change;
+};
+
+// this function tightens the bounds of the interval distances of an instance (see above)
+// -> the original bounds are kept in the instance, and restored if the function is invoked again
+// -> the returning value is the number of tightened distances
+int smoothBounds(INSTANCE *inst,double eps)
+{
+   int e,k,sweep,tightened;
+   double *tmp;
+   SMOOTH *s;
+
+   restoreBounds(inst);
+   s = newSmooth(inst->n,inst->v,eps);
+
+   // tetrangle inequalities (they only involve exact distances: one pass is sufficient)
+   runSmooth(s,0);
+
+   // sweeps of triangle inequalities, until the bounds do not change anymore
+   for (sweep = 0; sweep < smaxsweeps; sweep++)
+   {
+      if (runSmooth(s,1) <= 1.e-3*eps)  sweep = smaxsweeps;
+      tmp = s->lb;  s->lb = s->nlb;  s->nlb = tmp;
+      tmp = s->ub;  s->ub = s->nub;  s->nub = tmp;
+   };
+
+   // the tightened bounds replace the original ones in the lists of references
+   tightened = 0;
+   for (e = 0; e < s->m; e++)
+   {
+      if (s->lb[e] > lowerBound(s->ref[e]) || s->ub[e] < upperBound(s->ref[e]))  tightened++;
+   };
+   if (tightened > 0)
+   {
+      inst->bounds = allocateVector(2*s->m);
+      for (e = 0, k = 0; e < s->m; e++, k = k + 2)
+      {
+         inst->bounds[k] = s->ref[e]->lb;
+         inst->bounds[k+1] = s->ref[e]->ub;
+         s->ref[e]->lb = s->lb[e];
+         s->ref[e]->ub = s->ub[e];
+      };
+   };
+   freeSmooth(s);
+   return tightened;
+};
+
+// this function restores the original bounds of the distances tightened by smoothBounds (if any)
+void restoreBounds(INSTANCE *inst)
+{
+   int i,k;
+   REFERENCE *ref;
+
+   if (inst->bounds == NULL)  return;
+   k = 0;
+   for (i = 0; i < inst->n; i++)
+   {
+      for (ref = inst->v[i].ref; ref != NULL; ref = ref->next)
+      {
+         ref->lb = inst->bounds[k];
+         ref->ub = inst->bounds[k+1];
+         k = k + 2;
+      };
+   };
+   freeVector(inst->bounds);
+   inst->bounds = NULL;
+};
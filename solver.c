@@ -0,0 +1,573 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - solver functions
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (functions previously in the main program)
+                                    asynchronous writer opened for every run of solveInstance
+                                    binary trajectory formats (option -f)
+                                    memory for the current path in the search tree (see pool.c)
+                                    option -dedup (index of the solutions found by bp, see dedup.c)
+                                    options -best and -rank (the k best solutions are printed at the end)
+                                    options -best and -rank rejected when the selected method is not bp
+                                    option -cluster (the representatives of the clusters are printed at the end)
+                                    memory for the partial MDE and LDE values in SEARCH
+                                    option -lookahead (look-ahead pruning device, see lookahead.c)
+                                    option -smooth (bound smoothing, see smooth.c)
+                                    option -repeat (repetition orders, see repeat.c)
+                                    triplet cache of bp_exact allocated in allocateSearch
+                                    option -hier (hierarchical mode, see hier.c)
+                                    option -blocks (blocks of vertices solved separately, see blocks.c)
+                                    option -incr (incremental mode, see incremental.c)
+                                    lbfgsb as main method (see lbfgsb.c)
+                                    smacof as main method (see smacof.c)
+                                    option -starts (runs from several starting points, see start.c)
+                                    memory of the local methods allocated only when they are invoked (see useWorkspace)
+************************************************************************************************************/
+
+#include "bp.h"
+
+extern double INFTY;
+extern size_t instlen;
+
+// this function sets up the default values for the options and infos that are not included in the MDfile
+void defaultOptions(OPTION *op,INFORMATION *info)
+{
+   op->print = 0;  op->format = 0;  op->allone = 0;
+   op->symmetry = 0;  op->monitor = true;  op->be = 0.10;
+   op->dedup = 0;  op->best = 0;  op->rank = 0;
+   op->cluster = 0.0;  op->lookahead = 0;  op->smooth = 0;
+   op->repeat = 0;  op->hier = 0;  op->blocks = 0;  op->starts = 1;
+   info->exact = false;  info->consec = false;
+   info->ncalls = 0;  info->nspg = 0;  info->nspgok = 0;  info->nstress = 0;
+   info->nsols = 0;  info->maxsols = 10;  info->pruning = 0;
+   info->best_sol = 0;  info->best_mde = INFTY;  info->best_lde = INFTY;
+   info->output = NULL;  info->solution = NULL;  info->feasible = NULL;  info->data = NULL;
+   info->writer = NULL;  info->pool = NULL;
+   info->dedup = NULL;  info->duplicates = 0;  info->incomplete = 0;  info->stitch = 0.0;  info->bsize = 0;  info->bestart = 0;
+   info->topk = NULL;
+   info->cluster = NULL;  info->clusters = 0;
+   info->previous = NULL;  info->prevsol = NULL;  info->resume = 0;
+};
+
+// this function reads the mdjeep options from an array of arguments (the MDfile name is not included)
+// -> argc is the number of arguments in argv
+// -> the returning value is a NULL char on success;
+// -> it is otherwise a char pointer to a string describing the error
+char* readArguments(int argc,char *argv[],OPTION *op,INFORMATION *info,bool *check_consec)
+{
+   int fidx;
+   char *error;
+
+   fidx = 0;
+   while (fidx < argc)
+   {
+      if (!strcmp(argv[fidx],"-nomonitor"))
+      {
+         op->monitor = false;
+         fidx++;
+      }
+      else if (!strcmp(argv[fidx],"-v"))  // compatibility with previous versions
+      {
+         return strdup("mdjeep: error: -v flag is obsolete\n"
+                       "mdjeep: instance file formats of previous MDjeep version can now be specified in the MDfile\n"
+                       "mdjeep: this option will be removed in the next versions of MDjeep");
+      }
+      else if (!strcmp(argv[fidx],"-e"))  // compatibility with previous versions
+      {
+         return strdup("mdjeep: error: -e flag is obsolete\n"
+                       "mdjeep: tolerance epsilon for bp method was already set up in MDfile\n"
+                       "mdjeep: this option will be removed in the next versions of MDjeep");
+      }
+      else if (!strcmp(argv[fidx],"-r"))  // compatibility with previous versions
+      {
+         return strdup("mdjeep: error: -r flag is obsolete\n"
+                       "mdjeep: resolution parameter for bp method was already set up in MDfile\n"
+                       "mdjeep: this option will be removed in the next versions of MDjeep");
+      }
+      else if (!strcmp(argv[fidx],"-1"))
+      {
+         op->allone = 1;
+         fidx++;
+      }
+      else if (!strcmp(argv[fidx],"-l"))
+      {
+         if (fidx + 1 >= argc)
+         {
+            return strdup("mdjeep: error: -l flag requires an integer argument indicating the maximum number of solutions");
+         };
+         if (!isInteger(argv[fidx+1]))
+         {
+            return strdup("mdjeep: error: argument of -l flag is not an integer");
+         };
+         info->maxsols = atoi(argv[fidx+1]);
+         if (info->maxsols <= 0)
+         {
+            return strdup("mdjeep: error: argument of -l flag is non-positive");
+         };
+         fidx = fidx + 2;
+      }
+      else if (!strcmp(argv[fidx],"-sym"))
+      {
+         if (fidx + 1 >= argc)
+         {
+            return strdup("mdjeep: error: -sym flag requires an integer argument (1=left hand side of the tree; 2=right hand side)");
+         };
+         op->symmetry = atoi(argv[fidx+1]);
+         if (op->symmetry < 1 || op->symmetry > 2)
+         {
+            return strdup("mdjeep: error: argument of -sym flag can only be 1 (left hand side) or 2 (right hand side of the tree)");
+         };
+         fidx = fidx + 2;
+      }
+      else if (!strcmp(argv[fidx],"-p"))
+      {
+         op->print = 1;
+         fidx++;
+      }
+      else if (!strcmp(argv[fidx],"-P"))
+      {
+         op->print = 2;
+         fidx++;
+      }
+      else if (!strcmp(argv[fidx],"-f"))
+      {
+         if (op->print == 0 && op->best == 0 && op->cluster == 0.0)
+         {
+            return strdup("mdjeep: error: -p, -P, -best or -cluster flags must precede -f flag");
+         };
+         if (fidx + 1 >= argc)
+         {
+            return strdup("mdjeep: error: -f flag requires a char string (either xyz, pdb, bin or bin32)");
+         };
+         if (!strcasecmp(argv[fidx+1],"pdb"))  op->format = 1;
+         if (!strcasecmp(argv[fidx+1],"bin"))  op->format = 2;
+         if (!strcasecmp(argv[fidx+1],"bin32"))  op->format = 3;
+         fidx = fidx + 2;
+      }
+      else if (!strcmp(argv[fidx],"-best"))
+      {
+         if (fidx + 1 >= argc)
+         {
+            return strdup("mdjeep: error: -best flag requires an integer argument indicating the number of solutions to print");
+         };
+         if (!isInteger(argv[fidx+1]) || atoi(argv[fidx+1]) <= 0)
+         {
+            return strdup("mdjeep: error: argument of -best flag is not a positive integer");
+         };
+         if (info->method != 0)
+         {
+            return strdup("mdjeep: error: -best flag only applies to bp method");
+         };
+         op->best = atoi(argv[fidx+1]);
+         fidx = fidx + 2;
+      }
+      else if (!strcmp(argv[fidx],"-rank"))
+      {
+         if (fidx + 1 >= argc)
+         {
+            return strdup("mdjeep: error: -rank flag requires a char string (either mde or lde)");
+         };
+         if (info->method != 0)
+         {
+            return strdup("mdjeep: error: -rank flag only applies to bp method");
+         };
+         if (!strcasecmp(argv[fidx+1],"mde"))
+            op->rank = 0;
+         else if (!strcasecmp(argv[fidx+1],"lde"))
+            op->rank = 1;
+         else
+            return strdup("mdjeep: error: argument of -rank flag can only be mde or lde");
+         fidx = fidx + 2;
+      }
+      else if (!strcmp(argv[fidx],"-cluster"))
+      {
+         if (fidx + 1 >= argc)
+         {
+            return strdup("mdjeep: error: -cluster flag requires a real argument indicating the RMSD cutoff");
+         };
+         if (!isReal(argv[fidx+1]) && !isInteger(argv[fidx+1]))
+         {
+            return strdup("mdjeep: error: argument of -cluster flag is not a real number");
+         };
+         op->cluster = atof(argv[fidx+1]);
+         if (op->cluster <= 0.0)
+         {
+            return strdup("mdjeep: error: argument of -cluster flag needs to be positive");
+         };
+         fidx = fidx + 2;
+      }
+      else if (!strcmp(argv[fidx],"-dedup"))
+      {
+         op->dedup = 1;
+         fidx++;
+      }
+      else if (!strcmp(argv[fidx],"-lookahead"))
+      {
+         if (fidx + 1 >= argc)
+         {
+            return strdup("mdjeep: error: -lookahead flag requires an integer argument indicating the maximum number of distances in the paths");
+         };
+         if (!isInteger(argv[fidx+1]) || atoi(argv[fidx+1]) <= 0)
+         {
+            return strdup("mdjeep: error: argument of -lookahead flag is not a positive integer");
+         };
+         op->lookahead = atoi(argv[fidx+1]);
+         fidx = fidx + 2;
+      }
+      else if (!strcmp(argv[fidx],"-smooth"))
+      {
+         op->smooth = 1;
+         fidx++;
+      }
+      else if (!strcmp(argv[fidx],"-repeat"))
+      {
+         op->repeat = 1;
+         fidx++;
+      }
+      else if (!strcmp(argv[fidx],"-hier"))
+      {
+         op->hier = 1;
+         fidx++;
+      }
+      else if (!strcmp(argv[fidx],"-blocks"))
+      {
+         if (fidx + 1 >= argc)
+         {
+            return strdup("mdjeep: error: -blocks flag requires an argument (size of the blocks)");
+         };
+         if (!isInteger(argv[fidx+1]) || atoi(argv[fidx+1]) < 8)
+         {
+            return strdup("mdjeep: error: argument of -blocks flag is not an integer larger than 7");
+         };
+         op->blocks = atoi(argv[fidx+1]);
+         fidx = fidx + 2;
+      }
+      else if (!strcmp(argv[fidx],"-starts"))
+      {
+         if (fidx + 1 >= argc)
+         {
+            return strdup("mdjeep: error: -starts flag requires an argument (number of starting points)");
+         };
+         if (!isInteger(argv[fidx+1]) || atoi(argv[fidx+1]) < 1)
+         {
+            return strdup("mdjeep: error: argument of -starts flag is not a positive integer");
+         };
+         op->starts = atoi(argv[fidx+1]);
+         fidx = fidx + 2;
+      }
+      else if (!strcmp(argv[fidx],"-incr"))
+      {
+         if (fidx + 2 >= argc)
+         {
+            return strdup("mdjeep: error: -incr flag requires two arguments (previous instance file and previous solution file)");
+         };
+         if (info->previous != NULL)  free(info->previous);
+         if (info->prevsol != NULL)  free(info->prevsol);
+         info->previous = strdup(argv[fidx+1]);
+         info->prevsol = strdup(argv[fidx+2]);
+         fidx = fidx + 3;
+      }
+      else if (!strcmp(argv[fidx],"-consec"))
+      {
+         (*check_consec) = true;
+         fidx++;
+      }
+      else
+      {
+         error = (char*)calloc(instlen+strlen(argv[fidx]),sizeof(char));
+         sprintf(error,"mdjeep: error: unknown option (%s)",argv[fidx]);
+         return error;
+      };
+   };
+
+   // the best solutions are printed in the same file used by -p and -P
+   if (op->best > 0 && op->print != 0)
+   {
+      return strdup("mdjeep: error: -best flag cannot be used together with -p or -P flags");
+   };
+   if (op->cluster > 0.0 && (op->print != 0 || op->best > 0))
+   {
+      return strdup("mdjeep: error: -cluster flag cannot be used together with -p, -P or -best flags");
+   };
+   if (op->hier && op->repeat)
+   {
+      return strdup("mdjeep: error: -hier flag cannot be used together with -repeat flag");
+   };
+   if (op->blocks > 0 && (op->hier || op->repeat))
+   {
+      return strdup("mdjeep: error: -blocks flag cannot be used together with -hier or -repeat flags");
+   };
+
+   if (op->starts > 1 && op->blocks > 0)
+   {
+      return strdup("mdjeep: error: -starts flag cannot be used together with -blocks flag");
+   };
+   if (info->previous != NULL && (op->smooth || op->repeat || op->hier || op->blocks > 0))
+   {
+      return strdup("mdjeep: error: -incr flag cannot be used together with -smooth, -repeat, -hier or -blocks flags");
+   };
+
+   // all arguments are valid
+   return NULL;
+};
+
+// this function treats a solution of the instance that was not found by bp along a single path of the tree
+// (hierarchical mode and blocks), in the same way as bp treats its solutions: duplicates, printing, evaluation,
+// best solution, k best solutions, clustering and user function
+// -> the returning value is false when the solution was discarded as a duplicate (lde and mde are then not set)
+bool reportSolution(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION *info,double *lde,double *mde)
+{
+   if (info->dedup != NULL && isDuplicate(info->dedup,X))
+   {
+      // the solution is too close to one of the previous ones
+      info->duplicates++;
+      return false;
+   };
+
+   // solution found
+   info->nsols = info->nsols + 1;
+
+   // printing the solution (if requested)
+   if (op.print > 1)
+   {
+      printSolution(inst->n,inst->v,X,op,info,info->nsols);
+   };
+
+   // evaluating the quality of the solution (no partial values can be reused)
+   S.epath[0] = -1;
+   evaluateSolution(inst->n,X,S,lde,mde);
+
+   // best solution found so far
+   if (*mde < info->best_mde)
+   {
+      info->best_sol = info->nsols;
+      info->best_lde = *lde;
+      info->best_mde = *mde;
+      if (op.print == 1)
+      {
+         printSolution(inst->n,inst->v,X,op,info,0);
+      };
+   };
+
+   // keeping the solution for the k best ones and the clustering (optional)
+   if (info->topk != NULL)  addToTopk(info->topk,X,info->nsols,*lde,*mde);
+   if (info->cluster != NULL)  addToCluster(info->cluster,X,info->nsols);
+
+   // passing the solution to the user function (optional)
+   if (info->solution != NULL)  info->solution(inst->n,inst->v,X,*lde,*mde,info);
+   return true;
+};
+
+// this function gives the memory of the arrays in SEARCH allocated by allocateSearch (see memory.c)
+long searchMemory(int n)
+{
+   return 3*matrixMemory(3,n) + 2*vectorMemory(n) + (long)n*(2*sizeof(int) + sizeof(triplet)) + sizeof(WORKSPACE);
+};
+
+// this function gives the memory of the arrays of a WORKSPACE allocated up to the given level (see memory.c)
+long workspaceMemory(int n,int m,int level)
+{
+   long memory = 0;
+
+   if (level >= 1)  memory = memory + vectorMemory(m);
+   if (level >= 2)  memory = memory + matrixMemory(3,n) + vectorMemory(m) + vectorMemory(n);
+   if (level >= 3)  memory = memory + 6*matrixMemory(3,n) + 6*vectorMemory(m);
+   return memory;
+};
+
+// this function allocates the memory for the arrays in SEARCH (for both bp and spg)
+// -> n is the number of vertices, m is the number of distances
+// -> the pointers to the triplets and the symmetric layers are not allocated (they are part of the INSTANCE)
+// -> the memory of the local methods is only allocated when they are invoked (see useWorkspace)
+void allocateSearch(SEARCH *S,int n,int m)
+{
+   S->pX = allocateMatrix(3,n);  S->lX = allocateMatrix(3,n);   S->uX = allocateMatrix(3,n);
+   S->work = (WORKSPACE*)calloc(1,sizeof(WORKSPACE));
+   S->work->n = n;  S->work->m = m;  S->work->level = 0;
+   S->path = (int*)calloc(n,sizeof(int));
+   S->replay = NULL;
+   S->edges = NULL;
+   S->ahead = NULL;
+   S->rep = NULL;
+   S->vsol = NULL;
+   S->epath = (int*)calloc(n,sizeof(int));
+   S->epath[0] = -1;
+   S->esum = allocateVector(n);  S->emax = allocateVector(n);
+   S->tcache = (triplet*)calloc(n,sizeof(triplet));
+   memoryUsage(1,searchMemory(n));
+
+   // setting up value for pi
+   S->pi = 3.14159265358979323846;
+};
+
+// this function allocates the memory of the local methods, up to the given level (see WORKSPACE)
+// -> spg needs the level 3, lbfgsb the level 2 and smacof the level 1; the arrays are kept until freeSearch,
+//    so that they are allocated only once when the method is invoked several times (refinement during bp)
+void useWorkspace(WORKSPACE *W,int level)
+{
+   int n,m;
+
+   if (level <= W->level)  return;
+   n = W->n;  m = W->m;
+   if (W->level < 1)
+   {
+      W->y = allocateVector(m);
+   };
+   if (W->level < 2 && level >= 2)
+   {
+      W->gX = allocateMatrix(3,n);  W->gy = allocateVector(m);  W->memory = allocateVector(n);
+   };
+   if (W->level < 3 && level >= 3)
+   {
+      W->sy = allocateVector(m);    W->yp = allocateVector(m);     W->gyp = allocateVector(m);
+      W->sX = allocateMatrix(3,n);  W->Xp = allocateMatrix(3,n);   W->gXp = allocateMatrix(3,n);
+      W->DX = allocateMatrix(3,n);  W->YX = allocateMatrix(3,n);   W->ZX = allocateMatrix(3,n);
+      W->Dy = allocateVector(m);    W->Yy = allocateVector(m);     W->Zy = allocateVector(m);
+   };
+   memoryUsage(1,workspaceMemory(n,m,level) - workspaceMemory(n,m,W->level));
+   W->level = level;
+};
+
+// this function frees the memory allocated with allocateSearch (and useWorkspace)
+void freeSearch(SEARCH *S)
+{
+   WORKSPACE *W = S->work;
+
+   memoryUsage(1,-searchMemory(W->n) - workspaceMemory(W->n,W->m,W->level));
+   free(S->path);
+   free(S->epath);
+   free(S->tcache);
+   freeVector(S->esum);  freeVector(S->emax);
+   freeVector(W->memory);
+   freeVector(W->Dy);  freeVector(W->Yy);  freeVector(W->Zy);
+   freeMatrix(3,W->DX);  freeMatrix(3,W->YX);  freeMatrix(3,W->ZX);
+   freeMatrix(3,W->Xp);  freeMatrix(3,W->gXp);
+   freeMatrix(3,W->gX);  freeMatrix(3,W->sX);
+   freeVector(W->yp);  freeVector(W->gyp);
+   freeVector(W->y);  freeVector(W->gy);  freeVector(W->sy);
+   free(W);
+   freeMatrix(3,S->pX);  freeMatrix(3,S->lX);  freeMatrix(3,S->uX);
+};
+
+// this function gives the name of a method (see INFORMATION)
+const char* methodName(int method)
+{
+   if (method == 0)  return "bp";
+   if (method == 1)  return "spg";
+   if (method == 2)  return "lbfgsb";
+   if (method == 3)  return "smacof";
+   return "none";
+};
+
+// this function invokes the local optimization method selected in INFORMATION: the main method when it is not bp,
+// and the refinement method otherwise (see spg and lbfgsb, the boxes need to be defined in S; smacof does not use them)
+int localOptimization(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj)
+{
+   if (info->method == 3)  return smacof(n,v,X,S,op,info,its,obj);
+   if (info->method == 2 || (info->method == 0 && info->refinement == 2))  return lbfgsb(n,v,X,S,op,info,its,obj);
+   return spg(n,v,X,S,op,info,its,obj);
+};
+
+// this function invokes the method selected in INFORMATION on a prepared instance
+// -> X is the matrix of coordinates: it contains the starting point for spg, lbfgsb and smacof, and the last found solution for bp
+//    (in the incremental mode, it contains the previous solution, and bp starts from layer info->resume)
+// -> S is the SEARCH structure with pre-allocated memory (see allocateSearch)
+// -> for spg, lbfgsb and smacof, the number of iterations and the final stress value are given through its and obj
+// -> the solutions to be printed are written by a dedicated thread (the writer is closed at the end of the run)
+// -> the returning value is the flag of the local method (see spg), it is always 0 for bp
+int solveInstance(INSTANCE *inst,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj)
+{
+   int i,flag;
+
+   // the triplets and the symmetric layers belong to the instance
+   S.refs = inst->refs;
+   S.sym = inst->sym;
+   S.edges = inst->edges;
+   S.ahead = inst->ahead;
+   S.rep = inst->rep;
+   S.vsol = inst->v;
+
+   // asynchronous writer for the solutions (optional)
+   info->writer = NULL;
+   if ((op.print != 0 || op.best > 0 || op.cluster > 0.0) && info->output != NULL)  info->writer = openWriter(inst->n,inst->v,info->output,op.format,op.eps);
+
+   // index of the solutions found by bp (optional)
+   // (the resolution parameter is the threshold, or the tolerance when the instance contains only exact distances)
+   info->dedup = NULL;
+   info->duplicates = 0;
+   if (op.dedup != 0 && info->method == 0)  info->dedup = newDedup(inst->n,op.r > 0.0 ? op.r : op.eps);
+
+   // the k best solutions found by bp are kept in memory (optional, no more than maxsols solutions can be found)
+   info->topk = NULL;
+   if (op.best > 0 && info->method == 0)  info->topk = newTopk(op.best < info->maxsols ? op.best : info->maxsols,inst->n,op.rank);
+
+   // the solutions found by bp are kept in memory for clustering them (optional)
+   info->cluster = NULL;
+   info->clusters = 0;
+   if (op.cluster > 0.0 && info->method == 0)  info->cluster = newCluster(inst->n,op.cluster);
+
+   // calling method bp
+   flag = 0;
+   if (info->method == 0)
+   {
+      if (inst->blocks != NULL)
+         solveBlocks(inst,X,S,op,info,its,obj);
+      else if (inst->hier != NULL)
+         hierarchicalSolve(inst,X,S,op,info);
+      else if (info->resume > 0)
+         resumeSearch(inst,X,S,op,info);
+      else if (info->exact && inst->vrep != NULL)
+         bp_exact(0,inst->nrep,inst->vrep,X,S,op,info);
+      else if (info->exact)
+         bp_exact(0,inst->n,inst->v,X,S,op,info);
+      else
+         bp(0,inst->n,inst->v,X,S,op,info);
+   };
+
+   // calling method spg, lbfgsb or smacof (on the entire instance, or by blocks)
+   if (info->method > 0 && inst->blocks != NULL)
+   {
+      flag = solveBlocks(inst,X,S,op,info,its,obj);
+   }
+   else if (info->method > 0 && op.starts > 1)
+   {
+      flag = multiStart(inst,X,op,info,its,obj);
+   }
+   else if (info->method > 0)
+   {
+      // defining boxes necessary for spg and lbfgsb
+      if (info->method != 3)
+      {
+         for (i = 0; i < inst->n; i++)
+         {
+            createBox(i,X,op.be,S.lX,S.uX);
+            expandBounds(i,inst->v,S.lX,S.uX,op.be,op.eps);
+         };
+      };
+      flag = localOptimization(inst->n,inst->v,X,S,op,info,its,obj);
+   };
+
+   // printing the k best solutions (also when bp was interrupted)
+   if (info->topk != NULL)
+   {
+      if (info->output != NULL)  printTopk(info->topk,inst->v,op,info);
+      info->topk = freeTopk(info->topk);
+   };
+
+   // clustering the solutions, and printing the representatives (also when bp was interrupted)
+   if (info->cluster != NULL)
+   {
+      info->clusters = clusterSolutions(info->cluster);
+      if (info->output != NULL)  printCluster(info->cluster,inst->v,op,info);
+      info->cluster = freeCluster(info->cluster);
+   };
+
+   // waiting for the writer to complete
+   if (info->writer != NULL)  closeWriter(info->writer);
+   info->writer = NULL;
+   info->dedup = freeDedup(info->dedup);
+
+   return flag;
+};
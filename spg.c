@@ -8,13 +8,32 @@
               Mar 21 2020  v.0.3.1  the variable S.be is not used directly in SPG to enlarge the bounds
               May 19 2020  v.0.3.2  parameters are now in the OPTION structure
                                     features to monitor and print added (SPG may be invoked as a main method)
+              Oct 18 2026  v.0.3.3  the solution is printed through the asynchronous writer (see writer.c)
+                                    number of stress evaluations counted in INFORMATION
+                                    vector operations performed by a pool of threads (large instances)
+                                    memory allocated in the workspace of SEARCH when spg is invoked (see useWorkspace)
+                                    iterations in single precision followed by a polish in double precision (optional)
+                                    the polish starts with the last spectral parameter, its iterations are counted once
 ************************************************************************************************************/
 
 #include "bp.h"
+#include <unistd.h>
+#include <float.h>
 
 // the dimension is fixed to 3 in this version of MDjeep
 int K = 3;
 
+// number of threads of spg (0 = one per available processor)
+int spthreads = 0;
+
+// minimum number of variables (coordinates and distances) for every thread of spg
+// (smaller instances, as the ones refined during bp, are solved by the calling thread only)
+int spchunk = 10000;
+
+// number of iterations reserved for the polish in double precision, when spg first iterates in single precision
+// (at most half of the maximum number of iterations, see spg)
+int sppolish = 100;
+
 // this function computes the scalar product between two pairs (X1,y1) and (X2,y2)
 // where X* are matrices, and y* are vectors
 double scalarProd(int n,double **X1,double **X2,int m,double *y1,double *y2)
@@ -34,55 +53,701 @@ double norm(int n,double **X,int m,double *y)
    return sqrt(scalarProd(n,X,X,m,y,y));
 };
 
-/* Spectral Projected Gradient (SPG)
- *
- *           input: the DGP instance (n,v), and the starting point X
- *          output: the found solution replaces the starting point in X
- *                  the stress function value in the found solution (obj, pointer)
- *                  the number of iterations (it, pointer)
- * returning value: the flag indicating the termination status (0 = normal, 
- *                                                              1 = direction norm too small,
- *                                                              2 = max number of iterations)
- * Additional memory and parameters in the SEARCH structure S; all memory needs to be pre-allocated.
- */
-int spg(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj)
+// every vector operation of spg runs over the variables of the vertices first, ..., last-1 of every thread (their
+// coordinates and the y variables of their distances), and the threads are created once per call to spg: between
+// two operations, they wait for the next one in spgThread
+// -> the operations (task) are: 0 = initial y variables, 1 = stress, 2 = gradient (partial sums), 3 = gradient
+//    (reduction), 4 = spectral parameter, 5 = descent direction, 6 = line search initialization, 7 = trial point,
+//    8 = norms of gradient and direction
+// -> every thread accumulates the gradient of its distances in its own memory (the distances of a vertex also
+//    involve the vertices of other threads), and the partial gradients are summed up by vertex afterwards
+// -> with one thread, all operations are performed in the same order as with the original loops
+// -> the operations 10, ..., 18 are the same operations on the data in single precision (see spgFloatKernel), and
+//    the operation 19 copies the point in single precision to X
+
+// this function creates the pool of threads of spg (the point X and the memory in S are the ones given to spg)
+SPGPOOL* newSpgPool(int n,VERTEX *v,double **X,SEARCH S,double gam)
 {
-   int i,j,k;
-   int m;
-   int it,maxIt;
-   int ldigits;
+   int i,j,t,m,nthreads;
+   long work,share;
+   int *yoff;
    REFERENCE *ref;
-   double mu,alpha;
-   double C,Q;
-   double objval,newobjval;
-   double scalprod;
-   double dist;
-   short flag = 0;
+   SPGPOOL *p;
+   SPGTHREAD *w;
+   sigset_t all,previous;
 
-   // if spg is refinement method, max number of iterations depends on the problem size
-   if (info->refinement == 1)
-      maxIt = 50 + 10*n;
-   else
-      maxIt = op.maxit;
+   // number of y variables before every vertex
+   yoff = (int*)calloc(n+1,sizeof(int));
+   for (i = 0; i < n; i++)  yoff[i+1] = yoff[i] + numberOfDistances(v[i].ref);
+   m = yoff[n];
 
-   // computing y variables
-   m = 0;
+   // number of threads
+   nthreads = spthreads;
+   if (nthreads <= 0)  nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+   if (nthreads > (K*n + m)/spchunk)  nthreads = (K*n + m)/spchunk;
+   if (nthreads < 1)  nthreads = 1;
+
+   p = (SPGPOOL*)calloc(1,sizeof(SPGPOOL));
+   p->n = n;  p->v = v;  p->X = X;  p->S = S;  p->f = NULL;  p->gam = gam;
+   p->nthreads = nthreads;
+   p->w = (SPGTHREAD*)calloc(nthreads,sizeof(SPGTHREAD));
+   p->generation = 0;  p->closing = false;
+
+   // the vertices are shared so that every thread has about the same number of variables
+   work = (long)K*n + m;
+   i = 0;
+   for (t = 0; t < nthreads; t++)
+   {
+      w = &p->w[t];
+      w->pool = p;
+      w->first = i;
+      share = (work*(t + 1))/nthreads;
+      while (i < n && (long)K*i + yoff[i] < share)  i++;
+      if (t == nthreads - 1)  i = n;
+      w->last = i;
+      w->yfirst = yoff[w->first];  w->ylast = yoff[w->last];
+      w->lo = w->first;  w->hi = w->last;
+      for (j = w->first; j < w->last; j++)
+      {
+         for (ref = v[j].ref; ref != NULL; ref = ref->next)
+         {
+            if (otherVertexId(ref) < w->lo)  w->lo = otherVertexId(ref);
+            if (otherVertexId(ref) >= w->hi)  w->hi = otherVertexId(ref) + 1;
+         };
+      };
+      if (t == 0)
+      {
+         w->gX = S.work->gX;
+         w->memory = S.work->memory;
+      }
+      else
+      {
+         w->gX = allocateMatrix(K,n);
+         w->memory = allocateVector(n);
+         memoryUsage(1,matrixMemory(K,n) + vectorMemory(n));
+      };
+   };
+   free(yoff);
+   if (nthreads == 1)  return p;
+
+   // the signals (^C) are handled by the main thread only
+   pthread_mutex_init(&p->lock,NULL);
+   pthread_cond_init(&p->go,NULL);
+   pthread_cond_init(&p->done,NULL);
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK,&all,&previous);
+   for (t = 1; t < nthreads; t++)  p->w[t].started = (pthread_create(&p->w[t].thread,NULL,spgThread,&p->w[t]) == 0);
+   pthread_sigmask(SIG_SETMASK,&previous,NULL);
+   return p;
+};
+
+// this function is executed by the threads of spg: they perform the operations given by spgRun until the pool is freed
+void* spgThread(void *arg)
+{
+   int task;
+   long seen = 0;
+   SPGTHREAD *w = (SPGTHREAD*)arg;
+   SPGPOOL *p = w->pool;
+
+   pthread_mutex_lock(&p->lock);
+   while (true)
+   {
+      while (p->generation == seen && !p->closing)  pthread_cond_wait(&p->go,&p->lock);
+      if (p->closing)  break;
+      seen = p->generation;
+      task = p->task;
+      pthread_mutex_unlock(&p->lock);
+
+      spgKernel(p,w,task);
+
+      pthread_mutex_lock(&p->lock);
+      p->pending--;
+      if (p->pending == 0)  pthread_cond_signal(&p->done);
+   };
+   pthread_mutex_unlock(&p->lock);
+   return NULL;
+};
+
+// this function performs one operation of spg over the variables assigned to one thread (see above)
+void spgKernel(SPGPOOL *p,SPGTHREAD *w,int task)
+{
+   int i,j,k,h,t;
+   double tmp;
+   REFERENCE *ref;
+   SPGTHREAD *o;
+   VERTEX *v = p->v;
+   double **X = p->X;
+   SEARCH S = p->S;
+   WORKSPACE *W = S.work;
+
+   w->sum[0] = 0.0;  w->sum[1] = 0.0;
+   if (task >= 10)
+   {
+      // the same operations in single precision
+      spgFloatKernel(p,w,task - 10);
+      return;
+   };
+   if (task == 0)
+   {
+      // y variables (projections of the distances in X on their bounds)
+      h = w->yfirst;
+      for (i = w->first; i < w->last; i++)
+      {
+         for (ref = v[i].ref; ref != NULL; ref = ref->next)
+         {
+            W->y[h] = projection(distance(otherVertexId(ref),i,X),lowerBound(ref),upperBound(ref),p->gam);
+            h++;
+         };
+      };
+   }
+   else if (task == 1)
+   {
+      // stress (see compute_stress)
+      h = w->yfirst;
+      for (i = w->first; i < w->last; i++)
+      {
+         for (ref = v[i].ref; ref != NULL; ref = ref->next)
+         {
+            tmp = distance(otherVertexId(ref),i,X) - W->y[h];
+            w->sum[0] = w->sum[0] + tmp*tmp;
+            h++;
+         };
+      };
+   }
+   else if (task == 2)
+   {
+      // partial gradient (see stress_gradient)
+      for (i = w->lo; i < w->hi; i++)  w->memory[i] = 0.0;
+      for (k = 0; k < K; k++)  for (i = w->lo; i < w->hi; i++)  w->gX[k][i] = 0.0;
+      h = w->yfirst;
+      for (i = w->first; i < w->last; i++)
+      {
+         for (ref = v[i].ref; ref != NULL; ref = ref->next)
+         {
+            j = otherVertexId(ref);
+            tmp = distance(j,i,X);
+            W->gy[h] = -2.0*(tmp - W->y[h]);
+            if (tmp > 0.0)
+            {
+               tmp = -W->y[h]/tmp;
+               w->memory[i] = w->memory[i] + tmp + 1.0;
+               w->memory[j] = w->memory[j] + tmp + 1.0;
+               tmp = -2.0*(1.0 + tmp);
+               for (k = 0; k < K; k++)
+               {
+                  w->gX[k][i] = w->gX[k][i] + tmp*X[k][j];
+                  w->gX[k][j] = w->gX[k][j] + tmp*X[k][i];
+               };
+            };
+            h++;
+         };
+      };
+   }
+   else if (task == 3)
+   {
+      // gradient (sum of the partial gradients, the first thread writes directly in the workspace)
+      o = &p->w[0];
+      for (i = w->first; i < w->last; i++)
+      {
+         if (i >= o->lo && i < o->hi)  continue;
+         W->memory[i] = 0.0;
+         for (k = 0; k < K; k++)  W->gX[k][i] = 0.0;
+      };
+      for (t = 1; t < p->nthreads; t++)
+      {
+         o = &p->w[t];
+         for (i = w->first; i < w->last; i++)
+         {
+            if (i < o->lo || i >= o->hi)  continue;
+            W->memory[i] = W->memory[i] + o->memory[i];
+            for (k = 0; k < K; k++)  W->gX[k][i] = W->gX[k][i] + o->gX[k][i];
+         };
+      };
+      for (k = 0; k < K; k++)  for (i = w->first; i < w->last; i++)  W->gX[k][i] = W->gX[k][i] + 2.0*W->memory[i]*X[k][i];
+   }
+   else if (task == 4)
+   {
+      // spectral parameter (scalar products of the differences between gradients and between points)
+      for (k = 0; k < K; k++)
+      {
+         for (i = w->first; i < w->last; i++)
+         {
+            W->YX[k][i] = W->gX[k][i] - W->gXp[k][i];
+            W->ZX[k][i] = X[k][i] - W->Xp[k][i];
+            w->sum[0] = w->sum[0] + W->YX[k][i]*W->ZX[k][i];
+            w->sum[1] = w->sum[1] + W->ZX[k][i]*W->ZX[k][i];
+         };
+      };
+      for (j = w->yfirst; j < w->ylast; j++)
+      {
+         W->Yy[j] = W->gy[j] - W->gyp[j];
+         W->Zy[j] = W->y[j] - W->yp[j];
+         w->sum[0] = w->sum[0] + W->Yy[j]*W->Zy[j];
+         w->sum[1] = w->sum[1] + W->Zy[j]*W->Zy[j];
+      };
+   }
+   else if (task == 5)
+   {
+      // full step over the opposite direction of the gradient, projection on the boxes, and descent direction
+      for (k = 0; k < K; k++)
+      {
+         for (i = w->first; i < w->last; i++)
+         {
+            W->sX[k][i] = projection(X[k][i] - W->gX[k][i]/p->mu,S.lX[k][i],S.uX[k][i],p->gam);
+            W->DX[k][i] = W->sX[k][i] - X[k][i];
+            w->sum[0] = w->sum[0] + W->DX[k][i]*W->DX[k][i];
+         };
+      };
+      h = w->yfirst;
+      for (i = w->first; i < w->last; i++)
+      {
+         for (ref = v[i].ref; ref != NULL; ref = ref->next)
+         {
+            W->sy[h] = projection(W->y[h] - W->gy[h]/p->mu,lowerBound(ref),upperBound(ref),p->gam);
+            W->Dy[h] = W->sy[h] - W->y[h];
+            w->sum[0] = w->sum[0] + W->Dy[h]*W->Dy[h];
+            h++;
+         };
+      };
+   }
+   else if (task == 6)
+   {
+      // current point and gradient, and scalar product between gradient and direction
+      for (k = 0; k < K; k++)
+      {
+         for (i = w->first; i < w->last; i++)
+         {
+            W->Xp[k][i] = X[k][i];
+            W->gXp[k][i] = W->gX[k][i];
+            w->sum[0] = w->sum[0] + W->gX[k][i]*W->DX[k][i];
+         };
+      };
+      for (j = w->yfirst; j < w->ylast; j++)
+      {
+         W->yp[j] = W->y[j];
+         W->gyp[j] = W->gy[j];
+         w->sum[0] = w->sum[0] + W->gy[j]*W->Dy[j];
+      };
+   }
+   else if (task == 7)
+   {
+      // trial point of the line search
+      for (k = 0; k < K; k++)  for (i = w->first; i < w->last; i++)  X[k][i] = W->Xp[k][i] + p->alpha*W->DX[k][i];
+      for (j = w->yfirst; j < w->ylast; j++)  W->y[j] = W->yp[j] + p->alpha*W->Dy[j];
+   }
+   else if (task == 8)
+   {
+      // norms of gradient and direction
+      for (k = 0; k < K; k++)
+      {
+         for (i = w->first; i < w->last; i++)
+         {
+            w->sum[0] = w->sum[0] + W->gX[k][i]*W->gX[k][i];
+            w->sum[1] = w->sum[1] + W->DX[k][i]*W->DX[k][i];
+         };
+      };
+      for (j = w->yfirst; j < w->ylast; j++)
+      {
+         w->sum[0] = w->sum[0] + W->gy[j]*W->gy[j];
+         w->sum[1] = w->sum[1] + W->Dy[j]*W->Dy[j];
+      };
+   };
+};
+
+// this function performs one operation of spg with all threads of the pool
+// -> the calling thread takes the first share, and the share of the threads that could not be created
+void spgRun(SPGPOOL *p,int task)
+{
+   int t;
+
+   if (p->nthreads == 1)
+   {
+      spgKernel(p,&p->w[0],task);
+      return;
+   };
+
+   pthread_mutex_lock(&p->lock);
+   p->task = task;
+   p->pending = 0;
+   for (t = 1; t < p->nthreads; t++)  if (p->w[t].started)  p->pending++;
+   p->generation++;
+   pthread_cond_broadcast(&p->go);
+   pthread_mutex_unlock(&p->lock);
+
+   spgKernel(p,&p->w[0],task);
+   for (t = 1; t < p->nthreads; t++)  if (!p->w[t].started)  spgKernel(p,&p->w[t],task);
+
+   pthread_mutex_lock(&p->lock);
+   while (p->pending > 0)  pthread_cond_wait(&p->done,&p->lock);
+   pthread_mutex_unlock(&p->lock);
+};
+
+// this function sums up the partial sums k (0 or 1) computed by the threads during the last operation
+double spgSum(SPGPOOL *p,int k)
+{
+   int t;
+   double sum = 0.0;
+
+   for (t = 0; t < p->nthreads; t++)  sum = sum + p->w[t].sum[k];
+   return sum;
+};
+
+// this function terminates the threads, and frees the pool
+void freeSpgPool(SPGPOOL *p)
+{
+   int t;
+
+   if (p->nthreads > 1)
+   {
+      pthread_mutex_lock(&p->lock);
+      p->closing = true;
+      pthread_cond_broadcast(&p->go);
+      pthread_mutex_unlock(&p->lock);
+      for (t = 1; t < p->nthreads; t++)  if (p->w[t].started)  pthread_join(p->w[t].thread,NULL);
+      pthread_cond_destroy(&p->done);
+      pthread_cond_destroy(&p->go);
+      pthread_mutex_destroy(&p->lock);
+   };
+   for (t = 1; t < p->nthreads; t++)
+   {
+      freeMatrix(K,p->w[t].gX);
+      freeVector(p->w[t].memory);
+      memoryUsage(1,-matrixMemory(K,p->n) - vectorMemory(p->n));
+   };
+   free(p->w);
+   free(p);
+};
+
+// with the attribute precision, spg first iterates on a copy in single precision of the point, of the boxes and of
+// the distance bounds: the vector operations then process twice as many values per SIMD instruction, and move half
+// of the memory; the point found in single precision is verified and polished in double precision (see spg)
+// -> the partial sums of the threads (stress, scalar products and norms) are accumulated in double precision, so
+//    that the comparisons of the line search are not affected by the number of terms
+// -> the distances are stored in contiguous arrays, in the order of the y variables (see newSpgPool)
+
+// this function computes the distance between the vertices i and j of a point in single precision
+float floatDistance(int i,int j,float **X)
+{
+   int k;
+   float d,sum = 0.0f;
+
+   for (k = 0; k < K; k++)
+   {
+      d = X[k][i] - X[k][j];
+      sum = sum + d*d;
+   };
+   return sqrtf(sum);
+};
+
+// this function gives the memory of the data in single precision (n vertices, m distances, see newSpgFloat)
+long spgFloatMemory(int n,int m)
+{
+   // a row of n values in single precision takes the memory of (n + 1)/2 values in double precision
+   return 7*matrixMemory(K,(n+1)/2) + vectorMemory((n+1)/2) + 7*vectorMemory((m+1)/2) + (n + 1 + m)*sizeof(int);
+};
+
+// this function creates the copy in single precision of the point X and of the boxes of the pool, and of the bounds
+// of the distances; the threads of the pool (other than the first one) get their partial gradients
+void newSpgFloat(SPGPOOL *p)
+{
+   int i,k,h,t,n,m;
+   REFERENCE *ref;
+   SPGFLOAT *f;
+   VERTEX *v = p->v;
+   SEARCH S = p->S;
+
+   n = p->n;
+   f = (SPGFLOAT*)calloc(1,sizeof(SPGFLOAT));
+   f->start = (int*)calloc(n+1,sizeof(int));
+   for (i = 0; i < n; i++)  f->start[i+1] = f->start[i] + numberOfDistances(v[i].ref);
+   m = f->start[n];
+
+   f->other = (int*)calloc(m > 0 ? m : 1,sizeof(int));
+   f->lb = allocateFloatVector(m);
+   f->ub = allocateFloatVector(m);
+   h = 0;
    for (i = 0; i < n; i++)
    {
-      ref = v[i].ref;
-      while (ref != NULL)
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
       {
-         j = otherVertexId(ref);
-         dist = distance(j,i,X);
-         S.y[m] = projection(dist,lowerBound(ref),upperBound(ref),op.gam);
-         ref = ref->next;
-         m++;
+         f->other[h] = otherVertexId(ref);
+         f->lb[h] = (float)lowerBound(ref);
+         f->ub[h] = (float)upperBound(ref);
+         h++;
       };
    };
 
+   f->X = allocateFloatMatrix(K,n);
+   f->lX = allocateFloatMatrix(K,n);
+   f->uX = allocateFloatMatrix(K,n);
+   for (k = 0; k < K; k++)
+   {
+      for (i = 0; i < n; i++)
+      {
+         f->X[k][i] = (float)p->X[k][i];
+         f->lX[k][i] = (float)S.lX[k][i];
+         f->uX[k][i] = (float)S.uX[k][i];
+      };
+   };
+   f->gX = allocateFloatMatrix(K,n);
+   f->Xp = allocateFloatMatrix(K,n);
+   f->gXp = allocateFloatMatrix(K,n);
+   f->DX = allocateFloatMatrix(K,n);
+   f->memory = allocateFloatVector(n);
+   f->y = allocateFloatVector(m);
+   f->gy = allocateFloatVector(m);
+   f->yp = allocateFloatVector(m);
+   f->gyp = allocateFloatVector(m);
+   f->Dy = allocateFloatVector(m);
+   memoryUsage(1,spgFloatMemory(n,m));
+
+   // partial gradients of the threads
+   p->w[0].fgX = f->gX;
+   p->w[0].fmemory = f->memory;
+   for (t = 1; t < p->nthreads; t++)
+   {
+      p->w[t].fgX = allocateFloatMatrix(K,n);
+      p->w[t].fmemory = allocateFloatVector(n);
+      memoryUsage(1,matrixMemory(K,(n+1)/2) + vectorMemory((n+1)/2));
+   };
+   p->f = f;
+};
+
+// this function performs one operation of spg in single precision over the variables assigned to one thread
+// (the operations are the ones of spgKernel, see above)
+void spgFloatKernel(SPGPOOL *p,SPGTHREAD *w,int task)
+{
+   int i,j,k,h,t;
+   float tmp,dd,mu,alpha,gam;
+   SPGTHREAD *o;
+   SPGFLOAT *f = p->f;
+   float **X = f->X;
+
+   mu = (float)p->mu;  alpha = (float)p->alpha;  gam = (float)p->gam;
+   if (task == 0)
+   {
+      // y variables (projections of the distances in X on their bounds)
+      for (i = w->first; i < w->last; i++)
+      {
+         for (h = f->start[i]; h < f->start[i+1]; h++)
+         {
+            tmp = floatDistance(f->other[h],i,X);
+            if (tmp < f->lb[h])
+               tmp = f->lb[h] - gam;
+            else if (tmp > f->ub[h])
+               tmp = f->ub[h] + gam;
+            f->y[h] = tmp;
+         };
+      };
+   }
+   else if (task == 1)
+   {
+      // stress
+      for (i = w->first; i < w->last; i++)
+      {
+         for (h = f->start[i]; h < f->start[i+1]; h++)
+         {
+            tmp = floatDistance(f->other[h],i,X) - f->y[h];
+            w->sum[0] = w->sum[0] + tmp*tmp;
+         };
+      };
+   }
+   else if (task == 2)
+   {
+      // partial gradient
+      for (i = w->lo; i < w->hi; i++)  w->fmemory[i] = 0.0f;
+      for (k = 0; k < K; k++)  for (i = w->lo; i < w->hi; i++)  w->fgX[k][i] = 0.0f;
+      for (i = w->first; i < w->last; i++)
+      {
+         for (h = f->start[i]; h < f->start[i+1]; h++)
+         {
+            j = f->other[h];
+            tmp = floatDistance(j,i,X);
+            f->gy[h] = -2.0f*(tmp - f->y[h]);
+            if (tmp > 0.0f)
+            {
+               tmp = -f->y[h]/tmp;
+               w->fmemory[i] = w->fmemory[i] + tmp + 1.0f;
+               w->fmemory[j] = w->fmemory[j] + tmp + 1.0f;
+               tmp = -2.0f*(1.0f + tmp);
+               for (k = 0; k < K; k++)
+               {
+                  w->fgX[k][i] = w->fgX[k][i] + tmp*X[k][j];
+                  w->fgX[k][j] = w->fgX[k][j] + tmp*X[k][i];
+               };
+            };
+         };
+      };
+   }
+   else if (task == 3)
+   {
+      // gradient (sum of the partial gradients)
+      o = &p->w[0];
+      for (i = w->first; i < w->last; i++)
+      {
+         if (i >= o->lo && i < o->hi)  continue;
+         f->memory[i] = 0.0f;
+         for (k = 0; k < K; k++)  f->gX[k][i] = 0.0f;
+      };
+      for (t = 1; t < p->nthreads; t++)
+      {
+         o = &p->w[t];
+         for (i = w->first; i < w->last; i++)
+         {
+            if (i < o->lo || i >= o->hi)  continue;
+            f->memory[i] = f->memory[i] + o->fmemory[i];
+            for (k = 0; k < K; k++)  f->gX[k][i] = f->gX[k][i] + o->fgX[k][i];
+         };
+      };
+      for (k = 0; k < K; k++)  for (i = w->first; i < w->last; i++)  f->gX[k][i] = f->gX[k][i] + 2.0f*f->memory[i]*X[k][i];
+   }
+   else if (task == 4)
+   {
+      // spectral parameter
+      for (k = 0; k < K; k++)
+      {
+         for (i = w->first; i < w->last; i++)
+         {
+            tmp = f->gX[k][i] - f->gXp[k][i];
+            dd = X[k][i] - f->Xp[k][i];
+            w->sum[0] = w->sum[0] + tmp*dd;
+            w->sum[1] = w->sum[1] + dd*dd;
+         };
+      };
+      for (j = w->yfirst; j < w->ylast; j++)
+      {
+         tmp = f->gy[j] - f->gyp[j];
+         dd = f->y[j] - f->yp[j];
+         w->sum[0] = w->sum[0] + tmp*dd;
+         w->sum[1] = w->sum[1] + dd*dd;
+      };
+   }
+   else if (task == 5)
+   {
+      // full step over the opposite direction of the gradient, projection on the boxes, and descent direction
+      for (k = 0; k < K; k++)
+      {
+         for (i = w->first; i < w->last; i++)
+         {
+            tmp = X[k][i] - f->gX[k][i]/mu;
+            if (tmp < f->lX[k][i])
+               tmp = f->lX[k][i] - gam;
+            else if (tmp > f->uX[k][i])
+               tmp = f->uX[k][i] + gam;
+            f->DX[k][i] = tmp - X[k][i];
+            w->sum[0] = w->sum[0] + f->DX[k][i]*f->DX[k][i];
+         };
+      };
+      for (j = w->yfirst; j < w->ylast; j++)
+      {
+         tmp = f->y[j] - f->gy[j]/mu;
+         if (tmp < f->lb[j])
+            tmp = f->lb[j] - gam;
+         else if (tmp > f->ub[j])
+            tmp = f->ub[j] + gam;
+         f->Dy[j] = tmp - f->y[j];
+         w->sum[0] = w->sum[0] + f->Dy[j]*f->Dy[j];
+      };
+   }
+   else if (task == 6)
+   {
+      // current point and gradient, and scalar product between gradient and direction
+      for (k = 0; k < K; k++)
+      {
+         for (i = w->first; i < w->last; i++)
+         {
+            f->Xp[k][i] = X[k][i];
+            f->gXp[k][i] = f->gX[k][i];
+            w->sum[0] = w->sum[0] + f->gX[k][i]*f->DX[k][i];
+         };
+      };
+      for (j = w->yfirst; j < w->ylast; j++)
+      {
+         f->yp[j] = f->y[j];
+         f->gyp[j] = f->gy[j];
+         w->sum[0] = w->sum[0] + f->gy[j]*f->Dy[j];
+      };
+   }
+   else if (task == 7)
+   {
+      // trial point of the line search
+      for (k = 0; k < K; k++)  for (i = w->first; i < w->last; i++)  X[k][i] = f->Xp[k][i] + alpha*f->DX[k][i];
+      for (j = w->yfirst; j < w->ylast; j++)  f->y[j] = f->yp[j] + alpha*f->Dy[j];
+   }
+   else if (task == 8)
+   {
+      // norms of gradient and direction
+      for (k = 0; k < K; k++)
+      {
+         for (i = w->first; i < w->last; i++)
+         {
+            w->sum[0] = w->sum[0] + f->gX[k][i]*f->gX[k][i];
+            w->sum[1] = w->sum[1] + f->DX[k][i]*f->DX[k][i];
+         };
+      };
+      for (j = w->yfirst; j < w->ylast; j++)
+      {
+         w->sum[0] = w->sum[0] + f->gy[j]*f->gy[j];
+         w->sum[1] = w->sum[1] + f->Dy[j]*f->Dy[j];
+      };
+   }
+   else if (task == 9)
+   {
+      // the point in double precision
+      for (k = 0; k < K; k++)  for (i = w->first; i < w->last; i++)  p->X[k][i] = (double)X[k][i];
+   };
+};
+
+// this function frees the data in single precision of the pool
+void freeSpgFloat(SPGPOOL *p)
+{
+   int t,n,m;
+   SPGFLOAT *f = p->f;
+
+   if (f == NULL)  return;
+   n = p->n;  m = f->start[n];
+   for (t = 1; t < p->nthreads; t++)
+   {
+      p->w[t].fgX = freeFloatMatrix(K,p->w[t].fgX);
+      p->w[t].fmemory = freeFloatVector(p->w[t].fmemory);
+      memoryUsage(1,-matrixMemory(K,(n+1)/2) - vectorMemory((n+1)/2));
+   };
+   p->w[0].fgX = NULL;  p->w[0].fmemory = NULL;
+   freeFloatMatrix(K,f->X);  freeFloatMatrix(K,f->lX);  freeFloatMatrix(K,f->uX);
+   freeFloatMatrix(K,f->gX);  freeFloatMatrix(K,f->Xp);  freeFloatMatrix(K,f->gXp);  freeFloatMatrix(K,f->DX);
+   freeFloatVector(f->memory);
+   freeFloatVector(f->y);  freeFloatVector(f->gy);  freeFloatVector(f->yp);  freeFloatVector(f->gyp);  freeFloatVector(f->Dy);
+   freeFloatVector(f->lb);  freeFloatVector(f->ub);
+   free(f->other);  free(f->start);
+   free(f);
+   memoryUsage(1,-spgFloatMemory(n,m));
+   p->f = NULL;
+};
+
+// this function performs the iterations of spg with the operations base, ..., base+8 of the pool (base = 0 for the
+// operations in double precision, base = 10 for the ones in single precision), from the point of the pool
+// -> mu0 is the spectral parameter of the first iteration
+// -> the returning value is the termination status (see spg), the number of iterations and the stress function
+//    value in the found point are stored in its and obj
+int spgIterations(SPGPOOL *p,int base,OPTION op,INFORMATION *info,int maxIt,double mu0,int *its,double *obj)
+{
+   int k;
+   int it;
+   int ldigits;
+   double mu,alpha;
+   double C,Q;
+   double objval,newobjval;
+   double scalprod;
+   short flag = 0;
+
+   // computing y variables
+   spgRun(p,base);
+
    // computing initial objective function and gradient values
-   objval = compute_stress(n,v,X,S.y);
-   stress_gradient(n,v,X,S.y,S.gX,S.gy,S.memory);
+   spgRun(p,base+1);
+   objval = spgSum(p,0);
+   info->nstress++;
+   spgRun(p,base+2);  spgRun(p,base+3);
    C = objval;
 
    // running Spectral Projected Gradient Descent method
@@ -101,60 +766,21 @@ int spg(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its
       // computing spectral parameter
       if (it == 1)
       {
-         mu = 1.0;
+         mu = mu0;
       }
       else
       {
-         differenceMatrix(K,n,S.gX,S.gXp,S.YX);  differenceVector(m,S.gy,S.gyp,S.Yy);
-         differenceMatrix(K,n,X,S.Xp,S.ZX);  differenceVector(m,S.y,S.yp,S.Zy);
-         mu = scalarProd(n,S.YX,S.ZX,m,S.Yy,S.Zy) / scalarProd(n,S.ZX,S.ZX,m,S.Zy,S.Zy);
+         spgRun(p,base+4);
+         mu = spgSum(p,0) / spgSum(p,1);
          if (mu < op.mumin)  mu = op.mumin;
          if (mu > op.mumax)  mu = op.mumax;
       };
 
-      // making a full step over the opposite direction of the gradient
-      for (i = 0; i < n; i++)
-      {
-         for (k = 0; k < K; k++)
-         {
-            S.sX[k][i] = X[k][i] - S.gX[k][i]/mu;
-         };
-      };
-      for (j = 0; j < m; j++)  S.sy[j] = S.y[j] - S.gy[j]/mu;
-
-      // performing projection on the box constraints (x variables)
-      for (i = 0; i < n; i++)
-      {
-         for (k = 0; k < K; k++)
-         {
-            S.sX[k][i] = projection(S.sX[k][i],S.lX[k][i],S.uX[k][i],op.gam);
-         };
-      };
-
-      // performing projection on the box constraints (y variables)
-      k = 0;
-      for (i = 0; i < n; i++)
-      {
-         ref = v[i].ref;
-         while (ref != NULL)
-         {
-            S.sy[k] = projection(S.sy[k],lowerBound(ref),upperBound(ref),op.gam);
-            ref = ref->next;
-            k++;
-         };
-      };
-
-      // computing new descent direction D
-      for (i = 0; i < n; i++)
-      {
-         for (k = 0; k < K; k++)   
-         {
-            S.DX[k][i] = S.sX[k][i] - X[k][i];
-         };
-      };
-      for (j = 0; j < m; j++)  S.Dy[j] = S.sy[j] - S.y[j];
-
-      if (norm(n,S.DX,m,S.Dy) < op.epsg)
+      // making a full step over the opposite direction of the gradient, performing projection on the box
+      // constraints (x and y variables), and computing new descent direction D
+      p->mu = mu;
+      spgRun(p,base+5);
+      if (sqrt(spgSum(p,0)) < op.epsg)
       {
          flag = 1;
          break;
@@ -162,52 +788,125 @@ int spg(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its
 
       // performing nonmonotone line-search
       alpha = 2.0;
-      copyMatrix(K,n,X,S.Xp); copyVector(m,S.y,S.yp);
-      copyMatrix(K,n,S.gX,S.gXp);  copyVector(m,S.gy,S.gyp);
-      scalprod = scalarProd(n,S.gX,S.DX,m,S.gy,S.Dy);
+      spgRun(p,base+6);
+      scalprod = spgSum(p,0);
       do
       {
          alpha = 0.5*alpha;
-         for (i = 0; i < n; i++)
-         {
-            for (k = 0; k < K; k++)  X[k][i] = S.Xp[k][i] + alpha*S.DX[k][i];
-         };
-         for (j = 0; j < m; j++)  S.y[j] = S.yp[j] + alpha*S.Dy[j];
+         p->alpha = alpha;
+         spgRun(p,base+7);
 
-         newobjval = compute_stress(n,v,X,S.y);
+         spgRun(p,base+1);
+         newobjval = spgSum(p,0);
+         info->nstress++;
       }
       while (alpha > op.epsalpha && newobjval > C + op.gam*alpha*scalprod);
 
-      if (alpha <= op.epsalpha)  scalprod = scalprod/(norm(n,S.gX,m,S.gy)*norm(n,S.DX,m,S.Dy));
-      newobjval = compute_stress(n,v,X,S.y);
+      if (alpha <= op.epsalpha)
+      {
+         spgRun(p,base+8);
+         scalprod = scalprod/(sqrt(spgSum(p,0))*sqrt(spgSum(p,1)));
+      };
+      spgRun(p,base+1);
+      newobjval = spgSum(p,0);
+      info->nstress++;
 
       // preparing for next iteration
       C = op.eta*Q*C;
       Q = op.eta*Q + 1.0;
       C = (C + newobjval)/Q;
       objval = newobjval;
-      stress_gradient(n,v,X,S.y,S.gX,S.gy,S.memory);
+      spgRun(p,base+2);  spgRun(p,base+3);
 
       it++;
    };
 
+   // updating output info
+   *its = it;
+   *obj = objval;
+   if (it == maxIt)  flag = 2;
+
+   return flag;
+};
+
+/* Spectral Projected Gradient (SPG)
+ *
+ *           input: the DGP instance (n,v), and the starting point X
+ *          output: the found solution replaces the starting point in X
+ *                  the stress function value in the found solution (obj, pointer)
+ *                  the number of iterations (it, pointer)
+ * returning value: the flag indicating the termination status (0 = normal, 
+ *                                                              1 = direction norm too small,
+ *                                                              2 = max number of iterations)
+ * Additional memory and parameters in the SEARCH structure S (the workspace is allocated at the first call).
+ * For large instances, the vector operations are shared among several threads (see newSpgPool).
+ * With the attribute precision, the iterations are first performed in single precision (see newSpgFloat).
+ */
+int spg(int n,VERTEX *v,double **X,SEARCH S,OPTION op,INFORMATION *info,int *its,double *obj)
+{
+   int it,fit,maxIt,polish;
+   double mu,objval,mde;
+   short flag;
+   OPTION fop;
+   SPGPOOL *p;
+
+   // if spg is refinement method, max number of iterations depends on the problem size
+   if (info->refinement == 1)
+      maxIt = 50 + 10*n;
+   else
+      maxIt = op.maxit;
+
+   // the memory, and the threads (see spgKernel for the vector operations)
+   useWorkspace(S.work,3);
+   p = newSpgPool(n,v,X,S,op.gam);
+
+   // iterations in single precision (optional): they stop when the step or the direction are too small to be
+   // represented reliably in single precision, and the remaining iterations are left to the polish
+   fit = 0;  polish = maxIt;  mu = 1.0;
+   if (op.precision == 1)
+   {
+      fop = op;
+      if (fop.epsalpha < sqrt(FLT_EPSILON))  fop.epsalpha = sqrt(FLT_EPSILON);
+      if (fop.epsg < sqrt(FLT_EPSILON))  fop.epsg = sqrt(FLT_EPSILON);
+      polish = sppolish < maxIt/2 ? sppolish : maxIt/2;
+      copyMatrix(K,n,X,S.work->sX);
+      newSpgFloat(p);
+      spgIterations(p,10,fop,info,maxIt - polish,1.0,&fit,&objval);
+      spgRun(p,19);
+      freeSpgFloat(p);
+
+      // verification in double precision: the found point is kept when its errors are finite and its MDE is not
+      // larger than in the starting point (which is otherwise restored, and refined in double precision only)
+      mde = compute_mde(n,v,X,op.eps);
+      if (isfinite(compute_lde(n,v,X,op.eps)) && isfinite(mde) && mde <= compute_mde(n,v,S.work->sX,op.eps))
+      {
+         polish = maxIt - fit;
+         mu = p->mu;
+      }
+      else
+      {
+         copyMatrix(K,n,S.work->sX,X);
+         fit = 0;  polish = maxIt;
+      };
+   };
+
+   // iterations in double precision (final polish when the iterations in single precision were performed: it starts
+   // with their last spectral parameter, a unit step would make its first line searches backtrack for long)
+   flag = spgIterations(p,0,op,info,polish,mu,&it,&objval);
+   freeSpgPool(p);
+
    // printing (optional)
    if (info->method == 1)
    {
       if (op.print > 0)
       {
-         if (op.format == 0)
-            printfile(i,v,X,info->output,0);
-         else
-            printpdb(i,v,X,info->output,0);
+         printSolution(n,v,X,op,info,0);
       };
    };
 
-   // updating output info
-   *its = it;
+   // updating output info (both phases count their starting point as the first iteration)
+   *its = fit > 0 ? fit + it - 1 : it;
    *obj = objval;
-   if (it == maxIt)  flag = 2;
 
    return flag;
 };
-
@@ -0,0 +1,377 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - built-in starting points
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (startpoint 'mds' and 'random', option -starts)
+************************************************************************************************************/
+
+#include "bp.h"
+#include <unistd.h>
+
+extern double INFTY;
+
+// the local methods (spg, lbfgsb and smacof) can start from a point generated by mdjeep, instead of a point read
+// from a file (see attribute startpoint in the MDfile):
+// -> 'mds': classical multidimensional scaling on the matrix of the shortest paths in the distance graph (the length
+//    of every distance is the middle of its interval); the shortest paths are computed from a limited number of
+//    landmark vertices only (each one the farthest vertex from the previous ones), the landmarks are embedded by
+//    classical MDS (the 3 largest eigenvalues of the double centered matrix of their squared distances), and all
+//    other vertices are placed by distance-based triangulation on the landmarks (landmark MDS, de Silva and
+//    Tenenbaum); when the instance has no more vertices than landmarks, this is the classical MDS of the complete
+//    shortest path matrix
+// -> 'random': the vertices are randomly placed in a cube, whose side is the average distance times the cubic root
+//    of the number of vertices
+// with option -starts k, the local method is run k times, from the selected starting point and from k-1 random
+// points (with different seeds), by one thread per available processor: the point with the smallest stress is kept
+
+// number of landmarks for the classical MDS
+int mdslandmarks = 50;
+
+// number of threads running the local method from several starting points (0 = one per available processor)
+int msthreads = 0;
+
+// this function computes the side of the cube where the random starting points are generated
+double startSide(int n,VERTEX *v)
+{
+   int i,m;
+   double side;
+   REFERENCE *ref;
+
+   m = 0;  side = 0.0;
+   for (i = 0; i < n; i++)
+   {
+      for (ref = v[i].ref; ref != NULL; ref = ref->next)
+      {
+         side = side + 0.5*(lowerBound(ref) + upperBound(ref));
+         m++;
+      };
+   };
+   if (m > 0)  side = side/m;
+   if (side <= 0.0)  side = 1.0;
+   return side*cbrt((double)n);
+};
+
+// this function places the vertices randomly in a cube centered in the origin (see startSide)
+// -> the same seed always gives the same point
+void randomStart(int n,VERTEX *v,double **X,unsigned int seed)
+{
+   int i,k;
+   double side;
+
+   side = startSide(n,v);
+   for (i = 0; i < n; i++)
+   {
+      for (k = 0; k < 3; k++)  X[k][i] = side*((double)rand_r(&seed)/RAND_MAX - 0.5);
+   };
+};
+
+// this function moves the element in position k of the binary heap towards the root (smallest keys on top)
+// -> pos gives the position in the heap of every element
+void heapUp(int *heap,int *pos,double *key,int k)
+{
+   int p,tmp;
+
+   while (k > 0)
+   {
+      p = (k - 1)/2;
+      if (key[heap[p]] <= key[heap[k]])  break;
+      tmp = heap[p];  heap[p] = heap[k];  heap[k] = tmp;
+      pos[heap[p]] = p;  pos[heap[k]] = k;
+      k = p;
+   };
+};
+
+// this function moves the element in position k of the binary heap (with size elements) towards the leaves
+void heapDown(int *heap,int *pos,double *key,int size,int k)
+{
+   int c,tmp;
+
+   while (2*k + 1 < size)
+   {
+      c = 2*k + 1;
+      if (c + 1 < size && key[heap[c+1]] < key[heap[c]])  c++;
+      if (key[heap[k]] <= key[heap[c]])  break;
+      tmp = heap[c];  heap[c] = heap[k];  heap[k] = tmp;
+      pos[heap[c]] = c;  pos[heap[k]] = k;
+      k = c;
+   };
+};
+
+// this function computes the shortest paths from the vertex source to all other vertices (Dijkstra), in the
+// distance graph s where the distance e has length len[e]
+// -> the lengths of the paths are stored in sp (INFTY for the vertices that cannot be reached)
+// -> heap and pos are pre-allocated arrays of n integers
+void shortestPaths(SMOOTH *s,double *len,int source,double *sp,int *heap,int *pos)
+{
+   int i,j,h,size;
+   double d;
+
+   for (i = 0; i < s->n; i++)
+   {
+      sp[i] = INFTY;
+      pos[i] = -1;
+   };
+   sp[source] = 0.0;
+   heap[0] = source;  pos[source] = 0;  size = 1;
+   while (size > 0)
+   {
+      // the closest vertex not yet reached
+      i = heap[0];
+      pos[i] = -2;
+      size--;
+      if (size > 0)
+      {
+         heap[0] = heap[size];  pos[heap[0]] = 0;
+         heapDown(heap,pos,sp,size,0);
+      };
+
+      // its neighbors
+      for (h = s->start[i]; h < s->start[i+1]; h++)
+      {
+         j = s->adj[h];
+         if (pos[j] == -2)  continue;
+         d = sp[i] + len[s->dist[h]];
+         if (d < sp[j])
+         {
+            sp[j] = d;
+            if (pos[j] == -1)
+            {
+               heap[size] = j;  pos[j] = size;
+               size++;
+            };
+            heapUp(heap,pos,sp,pos[j]);
+         };
+      };
+   };
+};
+
+// this function computes the starting point given by landmark MDS on the shortest path distances (see above)
+void mdsStart(int n,VERTEX *v,double **X,double eps)
+{
+   int i,j,k,a,b,L,nl;
+   int *land,*heap,*pos;
+   int top[3];
+   double dmax,total,lambda;
+   double *len,*mind,*mean;
+   double **D,**B,**V;
+   SMOOTH *s;
+
+   // the distance graph, and the lengths of the distances
+   s = newSmooth(n,v,eps);
+   len = allocateVector(s->m > 0 ? s->m : 1);
+   for (i = 0; i < s->m; i++)  len[i] = 0.5*(s->lb[i] + s->ub[i]);
+
+   // landmarks (farthest point selection), and their shortest paths
+   L = mdslandmarks;
+   if (L > n)  L = n;
+   nl = L;
+   land = (int*)calloc(L,sizeof(int));
+   heap = (int*)calloc(n,sizeof(int));
+   pos = (int*)calloc(n,sizeof(int));
+   D = allocateMatrix(L,n);
+   mind = allocateVector(n);
+   memoryUsage(1,matrixMemory(nl,n) + vectorMemory(s->m > 0 ? s->m : 1));
+   for (i = 0; i < n; i++)  mind[i] = INFTY;
+   land[0] = 0;
+   for (a = 0; a < L; a++)
+   {
+      shortestPaths(s,len,land[a],D[a],heap,pos);
+      if (a + 1 == L)  break;
+      j = -1;
+      for (i = 0; i < n; i++)
+      {
+         if (D[a][i] < mind[i])  mind[i] = D[a][i];
+         if (mind[i] > 0.0 && (j == -1 || mind[i] > mind[j]))  j = i;
+      };
+      if (j == -1)
+      {
+         L = a + 1;
+         break;
+      };
+      land[a+1] = j;
+   };
+
+   // the vertices that cannot be reached are placed at the largest distance
+   dmax = 0.0;
+   for (a = 0; a < L; a++)  for (i = 0; i < n; i++)  if (D[a][i] < INFTY && D[a][i] > dmax)  dmax = D[a][i];
+   for (a = 0; a < L; a++)  for (i = 0; i < n; i++)  if (D[a][i] >= INFTY)  D[a][i] = dmax;
+
+   // double centered matrix of the squared distances between the landmarks
+   B = allocateMatrix(L,L);
+   V = allocateMatrix(L,L);
+   mean = allocateVector(L);
+   total = 0.0;
+   for (a = 0; a < L; a++)
+   {
+      for (b = 0; b < L; b++)
+      {
+         B[a][b] = 0.5*(D[a][land[b]]*D[a][land[b]] + D[b][land[a]]*D[b][land[a]]);
+         mean[a] = mean[a] + B[a][b];
+      };
+      mean[a] = mean[a]/L;
+      total = total + mean[a];
+   };
+   total = total/L;
+   for (a = 0; a < L; a++)  for (b = 0; b < L; b++)  B[a][b] = -0.5*(B[a][b] - mean[a] - mean[b] + total);
+
+   // the 3 largest eigenvalues
+   symmetricEigen(L,B,V);
+   for (k = 0; k < 3; k++)
+   {
+      top[k] = -1;
+      for (a = 0; a < L; a++)
+      {
+         if (k > 0 && a == top[0])  continue;
+         if (k > 1 && a == top[1])  continue;
+         if (top[k] == -1 || B[a][a] > B[top[k]][top[k]])  top[k] = a;
+      };
+   };
+
+   // triangulation of all vertices on the landmarks
+   for (k = 0; k < 3; k++)
+   {
+      lambda = (top[k] >= 0) ? B[top[k]][top[k]] : 0.0;
+      for (i = 0; i < n; i++)
+      {
+         X[k][i] = 0.0;
+         if (lambda <= 1.e-12)  continue;
+         for (a = 0; a < L; a++)  X[k][i] = X[k][i] + V[a][top[k]]*(D[a][i]*D[a][i] - mean[a]);
+         X[k][i] = -0.5*X[k][i]/sqrt(lambda);
+      };
+   };
+
+   // freeing memory
+   memoryUsage(1,-matrixMemory(nl,n) - vectorMemory(s->m > 0 ? s->m : 1));
+   freeVector(mean);
+   freeMatrix(L,V);
+   freeMatrix(L,B);
+   freeVector(mind);
+   freeMatrix(nl,D);
+   free(pos);  free(heap);  free(land);
+   freeVector(len);
+   freeSmooth(s);
+};
+
+// this function generates the built-in starting point selected in INFORMATION ('mds' by default)
+void builtinStart(int n,VERTEX *v,double **X,double eps,INFORMATION *info)
+{
+   if (info->initial == 2)
+      randomStart(n,v,X,1);
+   else
+      mdsStart(n,v,X,eps);
+};
+
+// this function runs the local method from the starting points assigned to one thread (executed by the threads)
+// -> the thread t takes the runs t, t + nthreads, t + 2*nthreads, ... (the run 0 starts from the given point,
+//    the run r > 0 from the random point with seed r)
+void* startThread(void *arg)
+{
+   int i,r,its,flag;
+   double obj;
+   double **Z;
+   INFORMATION info;
+   SEARCH S;
+   STARTTHREAD *w = (STARTTHREAD*)arg;
+   INSTANCE *inst = w->inst;
+
+   allocateSearch(&S,inst->n,inst->m);
+   Z = allocateMatrix(3,inst->n);
+   for (r = w->id; r < w->nruns; r = r + w->nthreads)
+   {
+      if (r == 0)
+         copyMatrix(3,inst->n,w->X0,Z);
+      else
+         randomStart(inst->n,inst->v,Z,(unsigned int)r);
+      if (w->info.method != 3)
+      {
+         for (i = 0; i < inst->n; i++)
+         {
+            createBox(i,Z,w->op.be,S.lX,S.uX);
+            expandBounds(i,inst->v,S.lX,S.uX,w->op.be,w->op.eps);
+         };
+      };
+      info = w->info;
+      info.nstress = 0;
+      flag = localOptimization(inst->n,inst->v,Z,S,w->op,&info,&its,&obj);
+      w->nstress = w->nstress + info.nstress;
+      if (w->best == -1 || obj < w->obj)
+      {
+         w->best = r;  w->obj = obj;
+         w->its = its;  w->flag = flag;
+         copyMatrix(3,inst->n,Z,w->X);
+      };
+   };
+   freeMatrix(3,Z);
+   freeSearch(&S);
+   return NULL;
+};
+
+// this function runs the local method selected in INFORMATION op.starts times, from the starting point in X and
+// from random points, and it keeps the point with the smallest stress (see above)
+// -> the best point replaces the starting point in X, its stress value and the number of iterations are given
+//    through obj and its
+// -> the returning value is the flag of the local method in the best run
+int multiStart(INSTANCE *inst,double **X,OPTION op,INFORMATION *info,int *its,double *obj)
+{
+   int t,best,nthreads;
+   bool *started;
+   STARTTHREAD *w;
+   sigset_t all,previous;
+
+   // number of threads
+   nthreads = msthreads;
+   if (nthreads <= 0)  nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+   if (nthreads > op.starts)  nthreads = op.starts;
+   if (nthreads < 1)  nthreads = 1;
+
+   // the runs do not print anything (the best point is printed at the end)
+   w = (STARTTHREAD*)calloc(nthreads,sizeof(STARTTHREAD));
+   started = (bool*)calloc(nthreads,sizeof(bool));
+   for (t = 0; t < nthreads; t++)
+   {
+      w[t].inst = inst;  w[t].X0 = X;
+      w[t].op = op;  w[t].op.print = 0;  w[t].op.monitor = false;
+      w[t].info = *info;
+      w[t].nruns = op.starts;  w[t].id = t;  w[t].nthreads = nthreads;
+      w[t].X = allocateMatrix(3,inst->n);
+      w[t].best = -1;  w[t].nstress = 0;
+   };
+
+   // the signals (^C) are handled by the main thread only
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK,&all,&previous);
+   for (t = 1; t < nthreads; t++)  started[t] = (pthread_create(&w[t].thread,NULL,startThread,&w[t]) == 0);
+   pthread_sigmask(SIG_SETMASK,&previous,NULL);
+
+   // the calling thread takes the first share, and the share of the threads that could not be created
+   startThread(&w[0]);
+   for (t = 1; t < nthreads; t++)
+   {
+      if (started[t])
+         pthread_join(w[t].thread,NULL);
+      else
+         startThread(&w[t]);
+   };
+
+   // the best point
+   best = 0;
+   for (t = 0; t < nthreads; t++)
+   {
+      info->nstress = info->nstress + w[t].nstress;
+      if (w[t].best != -1 && (w[best].best == -1 || w[t].obj < w[best].obj))  best = t;
+   };
+   copyMatrix(3,inst->n,w[best].X,X);
+   *its = w[best].its;
+   *obj = w[best].obj;
+   t = w[best].flag;
+   info->bestart = w[best].best;
+   if (op.print > 0)  printSolution(inst->n,inst->v,X,op,info,0);
+
+   // freeing memory
+   for (best = 0; best < nthreads; best++)  freeMatrix(3,w[best].X);
+   free(started);
+   free(w);
+   return t;
+};
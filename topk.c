@@ -0,0 +1,150 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - k best solutions
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (option -best)
+                                    the matrices of the solutions are allocated when the solutions are kept
+************************************************************************************************************/
+
+#include "bp.h"
+
+// the k best solutions found by bp (by MDE or by LDE) are kept in memory, and printed at the end of the run;
+// the matrix of coordinates of a slot is allocated when the slot is filled for the first time (k may be much
+// larger than the number of found solutions), and the solutions are organized in a max-heap, so that the worst
+// kept solution can be replaced in O(log k) when a better one is found
+
+// this function creates an empty TOPK structure for at most k solutions with n vertices
+// -> rank is 0 to rank the solutions by MDE, and 1 to rank them by LDE
+TOPK* newTopk(int k,int n,int rank)
+{
+   TOPK *t;
+
+   t = (TOPK*)calloc(1,sizeof(TOPK));
+   t->k = k;  t->n = n;  t->rank = rank;
+   t->size = 0;
+   t->heap = (int*)calloc(k,sizeof(int));
+   t->s = (int*)calloc(k,sizeof(int));
+   t->lde = allocateVector(k);
+   t->mde = allocateVector(k);
+   t->X = (double***)calloc(k,sizeof(double**));
+   memoryUsage(2,topkMemory(t));
+   return t;
+};
+
+// this function gives the memory of the TOPK structure (see memory.c)
+// -> only the matrices of the filled slots are allocated
+long topkMemory(TOPK *t)
+{
+   return sizeof(TOPK) + t->k*(2*sizeof(int) + sizeof(double**)) + t->size*matrixMemory(3,t->n) + 2*vectorMemory(t->k);
+};
+
+// this function frees the TOPK structure
+TOPK* freeTopk(TOPK *t)
+{
+   int h;
+
+   if (t == NULL)  return NULL;
+   memoryUsage(2,-topkMemory(t));
+   for (h = 0; h < t->size; h++)  freeMatrix(3,t->X[h]);
+   free(t->X);
+   freeVector(t->lde);  freeVector(t->mde);
+   free(t->s);  free(t->heap);
+   free(t);
+   return NULL;
+};
+
+// this function verifies whether the solution kept in slot h1 is worse than the one kept in slot h2
+// (ties are broken with the solution number, so that the first found solutions are preferred)
+bool topkWorse(TOPK *t,int h1,int h2)
+{
+   double key1,key2;
+
+   if (t->rank == 0)
+   {
+      key1 = t->mde[h1];  key2 = t->mde[h2];
+   }
+   else
+   {
+      key1 = t->lde[h1];  key2 = t->lde[h2];
+   };
+   if (key1 != key2)  return key1 > key2;
+   return t->s[h1] > t->s[h2];
+};
+
+// this function moves down the element in position p of the heap (the worst solution is at the top)
+void topkSiftDown(TOPK *t,int p,int size)
+{
+   int c,tmp;
+
+   while (2*p + 1 < size)
+   {
+      c = 2*p + 1;
+      if (c + 1 < size && topkWorse(t,t->heap[c+1],t->heap[c]))  c++;
+      if (!topkWorse(t,t->heap[c],t->heap[p]))  break;
+      tmp = t->heap[p];  t->heap[p] = t->heap[c];  t->heap[c] = tmp;
+      p = c;
+   };
+};
+
+// this function offers a new solution (solution number s) to the TOPK structure
+// -> the solution is copied only if it is one of the k best solutions found so far
+void addToTopk(TOPK *t,double **X,int s,double lde,double mde)
+{
+   int p,q,h,tmp;
+
+   // the structure is not full: the solution is added at the bottom of the heap
+   if (t->size < t->k)
+   {
+      h = t->size;
+      t->heap[h] = h;
+      t->size++;
+      t->X[h] = allocateMatrix(3,t->n);
+      memoryUsage(2,matrixMemory(3,t->n));
+      copyMatrix(3,t->n,X,t->X[h]);
+      t->s[h] = s;  t->lde[h] = lde;  t->mde[h] = mde;
+      p = t->size - 1;
+      while (p > 0)
+      {
+         q = (p - 1)/2;
+         if (!topkWorse(t,t->heap[p],t->heap[q]))  break;
+         tmp = t->heap[p];  t->heap[p] = t->heap[q];  t->heap[q] = tmp;
+         p = q;
+      };
+      return;
+   };
+
+   // the structure is full: the solution replaces the worst one (if it is better)
+   h = t->heap[0];
+   if (t->rank == 0 && mde >= t->mde[h])  return;
+   if (t->rank == 1 && lde >= t->lde[h])  return;
+   copyMatrix(3,t->n,X,t->X[h]);
+   t->s[h] = s;  t->lde[h] = lde;  t->mde[h] = mde;
+   topkSiftDown(t,0,t->size);
+};
+
+// this function prints the kept solutions, from the best one to the worst one (see printSolution)
+// -> the solutions are numbered by rank in the output file (a single solution is printed as with option -p)
+// -> the heap is sorted in place: no more solutions can be added after this call
+void printTopk(TOPK *t,VERTEX *v,OPTION op,INFORMATION *info)
+{
+   int r,tmp;
+
+   // heap sort (the worst solutions are moved at the end of the heap)
+   for (r = t->size - 1; r > 0; r--)
+   {
+      tmp = t->heap[0];  t->heap[0] = t->heap[r];  t->heap[r] = tmp;
+      topkSiftDown(t,0,r);
+   };
+
+   // printing
+   if (t->size == 1)
+   {
+      printSolution(t->n,v,t->X[t->heap[0]],op,info,0);
+   }
+   else
+   {
+      for (r = 0; r < t->size; r++)  printSolution(t->n,v,t->X[t->heap[r]],op,info,r+1);
+   };
+};
@@ -16,11 +16,26 @@
                                     function expandBounds reimplemented
               Apr 13 2022  v.0.3.2  patch (cosomega)
               Nov  7 2023  v.0.3.2  patch 2 (splitOmegaIntervals)
+              Oct 18 2026  v.0.3.3  usage updated (option --serve)
+                                    errno taken from errno.h (no global redefinition, for the shared library)
+                                    removEndingChars does not read before the beginning of empty strings
+                                    usage updated (binary trajectory format, option --convert)
+                                    usage updated (option -dedup)
+                                    usage updated (options -best and -rank)
+                                    usage updated (option -cluster)
+                                    usage updated (option -lookahead)
+                                    usage updated (option -smooth)
+                                    usage updated (option --order)
+                                    usage updated (option -repeat)
+                                    usage updated (option -hier)
+                                    usage updated (option -blocks)
+                                    usage updated (option -incr)
+                                    usage updated (option -starts)
 *****************************************************************************************************/
 
 #include "bp.h"
+#include <errno.h>
 
-int errno;
 extern double INFTY;
 
 /* functions to manage omega angle lists */
@@ -411,13 +426,13 @@ bool isNewLineDelimiter(char c)
 // -> ending chars are blank chars, \n and \r
 size_t removEndingChars(char *c)
 {
-   size_t l = strlen(c) - 1;
-   while (l >= 0 && (c[l] == ' ' || isLastChar(c[l]) || isNewLineDelimiter(c[l])))
+   size_t l = strlen(c);
+   while (l > 0 && (c[l-1] == ' ' || isLastChar(c[l-1]) || isNewLineDelimiter(c[l-1])))
    {
-      c[l] = '\0';
+      c[l-1] = '\0';
       l--;
    };
-   return l;
+   return l - 1;
 };
 
 // function which looks for the next colon (:) in a char string passing over blank chars (or tabs)
@@ -744,6 +759,9 @@ void mdjeep_usage(void)
 {
    fprintf(stderr,"mdjeep: too few arguments\n");
    fprintf(stderr,"        syntax: ./mdjeep [options] MDfile.mdf\n");
+   fprintf(stderr,"                ./mdjeep --serve socket [-cache size]  (persistent solver, see mdclient)\n");
+   fprintf(stderr,"                ./mdjeep --convert trajectory.mdt [xyz|pdb]  (binary trajectory to text file)\n");
+   fprintf(stderr,"                ./mdjeep --order [-consec] file.mdf  (discretization order, reordered instance)\n");
    fprintf(stderr," Options:\n");
    fprintf(stderr,"          -1 | the specified method stops at the first solution (always true for SPG)\n");
    fprintf(stderr,"          -l | specifies after how many solutions the method should stop (applies only to BP)\n");
@@ -751,8 +769,20 @@ void mdjeep_usage(void)
    fprintf(stderr,"          -p | prints the best found solution in a text file\n");
    fprintf(stderr,"          -P | prints all found solutions (in the same text file)\n");
    fprintf(stderr,"             |  (when using -1, options -p and -P have the same effect)\n");
+   fprintf(stderr,"       -best | keeps the k best solutions in memory, and prints them at the end (applies only to BP)\n");
+   fprintf(stderr,"       -rank | the best solutions are the ones with smallest \"mde\" (default) or smallest \"lde\"\n");
+   fprintf(stderr,"    -cluster | clusters the solutions with the given RMSD cutoff, and prints the representatives at the end (applies only to BP)\n");
    fprintf(stderr,"          -f | specifies the output format (default is \"xyz\", may be changed to \"pdb\")\n");
+   fprintf(stderr,"             |  (or to the binary trajectory format: \"bin\", or \"bin32\" in single precision)\n");
+   fprintf(stderr,"  -lookahead | prunes with the bounds implied by the next vertices, through paths of at most k distances (applies only to BP, exact distances)\n");
+   fprintf(stderr,"     -smooth | tightens the interval distances with the triangle and tetrangle inequalities before solving\n");
+   fprintf(stderr,"      -dedup | compares every new solution to all previous ones, after superposition (applies only to BP)\n");
    fprintf(stderr,"     -consec | verifies whether the consecutivity assumption is satisfied\n");
+   fprintf(stderr,"     -repeat | repeats some vertices in the order when the consecutivity assumption is not satisfied (applies only to BP, exact distances)\n");
+   fprintf(stderr,"       -hier | places the backbone (N, CA, C) first, then the other vertices of every group (applies only to BP, experimental)\n");
+   fprintf(stderr,"     -blocks | solves separately the blocks of k consecutive vertices, and stitches them together\n");
+   fprintf(stderr,"       -incr | given a previous instance and its solution, re-solves only from the first modified layer (spg starts from the solution)\n");
+   fprintf(stderr,"     -starts | runs the local method from k starting points (the given one, and k-1 random ones), keeps the best point\n");
    fprintf(stderr,"  -nomonitor | does not show the current layer number during the execution to improve performance\n");
    fprintf(stderr,"          -r | obsolete, resolution parameter can now be specified in MDfile (method field)\n");
    fprintf(stderr,"          -e | obsolete, tolerance epsilon can now be specified in MDfile (method field)\n");
@@ -11,6 +11,8 @@
                                     the function findReferences is replaced by the functions nextTripletRef,
                                     isExactClique, findReferencesExactCase and findReferencesIntervalCase
               Apr 13 2022  v.0.3.2  patch (findReferencesExactCase)
+              Oct 18 2026  v.0.3.3  freeVertex also frees vertex names
+              Oct 18 2026  v.0.3.3  findReferencesExactCase returns a null triplet when no exact clique is found
 ************************************************************************************************************/
 
 #include "bp.h"
@@ -440,6 +442,7 @@ triplet findReferencesExactCase(int id,VERTEX *v,double eps,double *cosine)
    while (!isNullTriplet(t));
 
    // returning the triplets (and its cosine)
+   if (isNullTriplet(refs))  return refs;
    if (isExactClique(id,v,refs,eps,cosine))  return refs;
    return nullTriplet();
 };
@@ -520,7 +523,11 @@ void printVertex(VERTEX v)
 VERTEX* freeVertex(int n,VERTEX *v)
 {
    int i;
-   for (i = 0; i < n; i++)  if (v[i].ref != NULL)  freeReference(v[i].ref);
+   for (i = 0; i < n; i++)
+   {
+      if (v[i].ref != NULL)  freeReference(v[i].ref);
+      free(v[i].Name);  free(v[i].Group);
+   };
    free(v);
    return NULL;
 };
@@ -0,0 +1,297 @@
+/***********************************************************************************************************
+  Name:       MD-jeep
+              the Branch & Prune algorithm for discretizable Distance Geometry - asynchronous solution writer
+  Author:     A. Mucherino, D.S. Goncalves, C. Lavor, L. Liberti, J-H. Lin, N. Maculan
+  Sources:    ansi C
+  License:    GNU General Public License v.3
+  History:    Oct 18 2026  v.0.3.3  introduced in this version (the solutions are written by a dedicated thread)
+                                    binary trajectory format
+                                    memory counted (see memory.c)
+                                    every solution is flushed once written (no solutions lost if the process is killed)
+                                    the solutions are flushed every wflush seconds, before a full buffer, and on ^C
+                                    the buffer of the output stream is allocated by the writer
+************************************************************************************************************/
+
+#include "bp.h"
+#include <errno.h>
+#include <unistd.h>
+
+extern volatile sig_atomic_t interrupted;
+
+// number of solutions that can be queued before the search needs to wait for the writer
+int wqueue = 32;
+
+// size of the buffer of the output stream (every formatted solution is written in one block)
+size_t wbuffer = 1 << 20;
+
+// maximum time (in seconds) during which the written solutions can stay in the buffer of the output stream
+// -> the buffer is also passed to the system before it is full, on ^C, and when the writer is closed; if the process
+//    is killed, the solutions written in the last wflush seconds may be lost
+int wflush = 1;
+
+// this function creates the writer for one run, and starts its thread
+// -> n is the number of vertices, v is the vertex array (names and groups are printed with the coordinates)
+// -> filename is the output file name without extension, format is 0 for XYZ, 1 for PDB (see printfile),
+//    2 and 3 for the binary trajectory format (see writeMDT), eps is the tolerance for LDE and MDE (binary format)
+// -> the output file is created when the first solution is written (as it is for printfile and printpdb)
+WRITER* openWriter(int n,VERTEX *v,char *filename,int format,double eps)
+{
+   int k;
+   WRITER *w;
+   sigset_t all,previous;
+
+   w = (WRITER*)calloc(1,sizeof(WRITER));
+   w->nv = n;  w->v = v;  w->format = format;  w->eps = eps;
+   w->prefix = NULL;
+   if (format < 2)  w->prefix = vertexPrefixes(n,v,format);
+   if (format == 0)
+      w->outfile = outputFileName(filename,"txt");
+   else if (format == 1)
+      w->outfile = outputFileName(filename,"pdb");
+   else
+      w->outfile = outputFileName(filename,"mdt");
+   w->output = NULL;  w->failed = false;
+   w->unflushed = false;
+
+   // queue of solutions
+   w->size = wqueue;
+   w->head = 0;  w->count = 0;  w->closing = false;
+   w->X = (double***)calloc(w->size,sizeof(double**));
+   for (k = 0; k < w->size; k++)  w->X[k] = allocateMatrix(3,n);
+   memoryUsage(3,w->size*matrixMemory(3,n));
+   w->n = (int*)calloc(w->size,sizeof(int));
+   w->s = (int*)calloc(w->size,sizeof(int));
+   pthread_mutex_init(&w->lock,NULL);
+   pthread_cond_init(&w->notempty,NULL);
+   pthread_cond_init(&w->notfull,NULL);
+
+   // the signals (^C) are handled by the search thread only
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK,&all,&previous);
+   pthread_create(&w->thread,NULL,writerThread,w);
+   pthread_sigmask(SIG_SETMASK,&previous,NULL);
+   return w;
+};
+
+// this function queues one solution (it only waits if the queue is full)
+// -> s is the solution number (see printfile): s=0 replaces the content of the file, s>0 appends one model
+void writeSolution(WRITER *w,int n,double **X,int s)
+{
+   int i,k;
+
+   if (n <= 0)  return;
+   pthread_mutex_lock(&w->lock);
+   if (w->failed)
+   {
+      pthread_mutex_unlock(&w->lock);
+      return;
+   };
+   while (w->count == w->size)  pthread_cond_wait(&w->notfull,&w->lock);
+   k = (w->head + w->count)%w->size;
+   for (i = 0; i < 3; i++)  memcpy(w->X[k][i],X[i],n*sizeof(double));
+   w->n[k] = n;  w->s[k] = s;
+   w->count++;
+   pthread_cond_signal(&w->notempty);
+   pthread_mutex_unlock(&w->lock);
+};
+
+// this function writes one queued solution on the output stream (executed by the writer thread)
+// -> the returning value is false if an error occurred (no more solutions will then be written)
+bool writeQueued(WRITER *w,int k)
+{
+   long start;
+   double lde,mde;
+   char **prefix;
+   struct timespec now;
+
+   // opening the output file at the first solution
+   if (w->output == NULL)
+   {
+      w->output = fopen(w->outfile,"w");
+      if (w->output == NULL)
+      {
+         fprintf(stderr,"mdjeep: error while opening file '%s' to write (%s), solutions will not be printed\n",w->outfile,strerror(errno));
+         return false;
+      };
+      // (the buffer is given to the stream: without it, the C library may ignore the requested size)
+      w->buffer = (char*)malloc(wbuffer);
+      setvbuf(w->output,w->buffer,_IOFBF,wbuffer);
+      memoryUsage(3,wbuffer);
+      clock_gettime(CLOCK_REALTIME,&w->flushed);
+      w->fpos = 0;  w->bytes = 0;
+   };
+
+   // the file content is replaced by a single solution, or by the first one
+   if (w->s[k] < 2)
+   {
+      fflush(w->output);
+      if (ftruncate(fileno(w->output),0) != 0)
+      {
+         fprintf(stderr,"mdjeep: error while rewriting file '%s' (%s), solutions will not be printed\n",w->outfile,strerror(errno));
+         return false;
+      };
+      rewind(w->output);
+      w->fpos = 0;
+   };
+
+   // the buffer is passed to the system before the solution could fill it (the stream would then write a part of the
+   // solution only, and the size of the previous solution is taken as estimate): the file contains complete solutions,
+   // unless a solution is larger than the buffer
+   start = ftell(w->output);
+   if (w->unflushed && start - w->fpos + w->bytes > (long)wbuffer)
+   {
+      if (!flushWriter(w))  return false;
+   };
+
+   // formatting the solution
+   // (the vertex attributes of partial solutions are formatted again, as the groupIds may be printed differently)
+   if (w->format < 2)
+   {
+      prefix = w->prefix;
+      if (w->n[k] < w->nv)  prefix = vertexPrefixes(w->n[k],w->v,w->format);
+      if (w->format == 0)
+         writeXYZ(w->output,w->n[k],prefix,w->X[k],w->s[k]);
+      else
+         writePDB(w->output,w->n[k],prefix,w->X[k],w->s[k],w->outfile);
+      if (prefix != w->prefix)  freePrefixes(w->n[k],prefix);
+   }
+   else
+   {
+      // binary format: LDE and MDE are computed by the writer thread
+      lde = compute_lde(w->n[k],w->v,w->X[k],w->eps);
+      mde = compute_mde(w->n[k],w->v,w->X[k],w->eps);
+      writeMDT(w->output,w->n[k],w->v,w->X[k],w->s[k],lde,mde,w->format == 2 ? 8 : 4);
+   };
+   w->bytes = ftell(w->output) - start;
+
+   // the solutions are passed to the system at most wflush seconds after being written (see writerThread), so that
+   // they are in the file even if the process is killed before the writer is closed
+   w->unflushed = true;
+   clock_gettime(CLOCK_REALTIME,&now);
+   if (interrupted || now.tv_sec - w->flushed.tv_sec >= wflush)  return flushWriter(w);
+   if (ferror(w->output))
+   {
+      fprintf(stderr,"mdjeep: error while writing in file '%s', solutions will not be printed\n",w->outfile);
+      return false;
+   };
+   return true;
+};
+
+// this function passes the written solutions to the system (executed by the writer thread)
+// -> the returning value is false if an error occurred (no more solutions will then be written)
+bool flushWriter(WRITER *w)
+{
+   fflush(w->output);
+   w->unflushed = false;
+   w->fpos = ftell(w->output);
+   clock_gettime(CLOCK_REALTIME,&w->flushed);
+   if (ferror(w->output))
+   {
+      fprintf(stderr,"mdjeep: error while writing in file '%s', solutions will not be printed\n",w->outfile);
+      return false;
+   };
+   return true;
+};
+
+// the writer thread: the queued solutions are written in order
+// -> a single solution (s=0) is skipped when another single solution follows in the queue
+//    (it would be overwritten anyway: this is the case of the best solution, option -p)
+// -> while the queue is empty, the written solutions are flushed wflush seconds after the previous flush
+void* writerThread(void *arg)
+{
+   int h,k;
+   bool skip,ok;
+   struct timespec deadline;
+   WRITER *w = (WRITER*)arg;
+
+   pthread_mutex_lock(&w->lock);
+   while (true)
+   {
+      while (w->count == 0 && !w->closing)
+      {
+         if (!w->unflushed)
+         {
+            pthread_cond_wait(&w->notempty,&w->lock);
+            continue;
+         };
+         deadline = w->flushed;
+         deadline.tv_sec = deadline.tv_sec + wflush;
+         if (pthread_cond_timedwait(&w->notempty,&w->lock,&deadline) == ETIMEDOUT)
+         {
+            // w->unflushed and w->output are only modified by this thread
+            pthread_mutex_unlock(&w->lock);
+            ok = flushWriter(w);
+            pthread_mutex_lock(&w->lock);
+            if (!ok)  w->failed = true;
+         };
+      };
+      if (w->count == 0)  break;
+      h = w->head;
+      skip = false;
+      if (w->s[h] == 0)  for (k = 1; k < w->count && !skip; k++)  if (w->s[(h + k)%w->size] == 0)  skip = true;
+      pthread_mutex_unlock(&w->lock);
+
+      // the slot is not modified by the search thread until it is released
+      // (w->failed is only modified by this thread)
+      ok = true;
+      if (!skip && !w->failed)  ok = writeQueued(w,h);
+
+      // releasing the slot
+      pthread_mutex_lock(&w->lock);
+      if (!ok)  w->failed = true;
+      w->head = (h + 1)%w->size;
+      w->count--;
+      pthread_cond_signal(&w->notfull);
+   };
+   pthread_mutex_unlock(&w->lock);
+   return NULL;
+};
+
+// this function waits for all queued solutions to be written, closes the output file and frees the writer
+void closeWriter(WRITER *w)
+{
+   int k;
+
+   // stopping the thread
+   pthread_mutex_lock(&w->lock);
+   w->closing = true;
+   pthread_cond_signal(&w->notempty);
+   pthread_mutex_unlock(&w->lock);
+   pthread_join(w->thread,NULL);
+
+   // closing the output file
+   if (w->output != NULL)
+   {
+      memoryUsage(3,-(long)wbuffer);
+      if (fclose(w->output) != 0 && !w->failed)
+      {
+         fprintf(stderr,"mdjeep: error while writing in file '%s' (%s)\n",w->outfile,strerror(errno));
+      };
+      free(w->buffer);
+   };
+
+   // freeing memory
+   pthread_cond_destroy(&w->notfull);
+   pthread_cond_destroy(&w->notempty);
+   pthread_mutex_destroy(&w->lock);
+   memoryUsage(3,-w->size*matrixMemory(3,w->nv));
+   for (k = 0; k < w->size; k++)  freeMatrix(3,w->X[k]);
+   free(w->X);  free(w->n);  free(w->s);
+   if (w->prefix != NULL)  freePrefixes(w->nv,w->prefix);
+   free(w->outfile);
+   free(w);
+};
+
+// this function prints one solution through the writer of the current run (if any),
+// and directly with printfile or printpdb otherwise
+void printSolution(int n,VERTEX *v,double **X,OPTION op,INFORMATION *info,int s)
+{
+   if (info->writer != NULL)
+      writeSolution(info->writer,n,X,s);
+   else if (op.format == 0)
+      printfile(n,v,X,info->output,s);
+   else if (op.format == 1)
+      printpdb(n,v,X,info->output,s);
+   else
+      printmdt(n,v,X,info->output,s,op.eps,op.format == 2 ? 8 : 4);
+};